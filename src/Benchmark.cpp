@@ -0,0 +1,624 @@
+#include "Engine.hpp"
+#include "Benchmark.hpp"
+
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <filesystem>
+#include <new>
+#include <sstream>
+#include <thread>
+
+namespace karapo::benchmark {
+	namespace {
+		// 確保回数の計測
+		// counting_allocationsが真の間のみ、operator newの呼出回数と確保したバイト数を数える。
+		std::atomic<bool> counting_allocations = false;
+		std::atomic<uint64> allocation_count = 0, allocated_bytes = 0;
+
+		inline void CountAllocation(const size_t Size) noexcept {
+			if (counting_allocations.load(std::memory_order_relaxed)) {
+				allocation_count.fetch_add(1, std::memory_order_relaxed);
+				allocated_bytes.fetch_add(Size, std::memory_order_relaxed);
+			}
+		}
+	}
+}
+
+// 確保回数を数える為に、operator new/deleteを置き換える。
+// 計測用の実行ファイル(KarapoBenchmark)のみに含まれ、ゲーム本体の確保には影響しない。
+void* operator new(const size_t Size) {
+	karapo::benchmark::CountAllocation(Size);
+	if (void* allocated = std::malloc(Size == 0 ? 1 : Size))
+		return allocated;
+	throw std::bad_alloc();
+}
+
+void* operator new[](const size_t Size) {
+	return operator new(Size);
+}
+
+void operator delete(void* allocated) noexcept {
+	std::free(allocated);
+}
+
+void operator delete[](void* allocated) noexcept {
+	std::free(allocated);
+}
+
+void operator delete(void* allocated, size_t) noexcept {
+	std::free(allocated);
+}
+
+void operator delete[](void* allocated, size_t) noexcept {
+	std::free(allocated);
+}
+
+namespace karapo::benchmark {
+	namespace {
+		// 計測名の後に指定された引数
+		std::string arguments{};
+
+		// 計測結果
+		struct Result final {
+			std::string name;
+			uint64 iterations;
+			std::chrono::nanoseconds elapsed;
+			uint64 bytes = 0;	// 1回当たりに処理するバイト数(0の場合は処理量を出力しない)
+		};
+
+		template<typename Func>
+		Result Measure(const std::string& Name, const uint64 Iterations, Func func, const uint64 Bytes = 0) {
+			const auto Start = std::chrono::steady_clock::now();
+			for (uint64 i = 0; i < Iterations; i++)
+				func(i);
+			const auto End = std::chrono::steady_clock::now();
+			return { Name, Iterations, std::chrono::duration_cast<std::chrono::nanoseconds>(End - Start), Bytes };
+		}
+
+		void WriteCSV(const std::string& Bench_Name, const std::vector<Result>& Results, const std::string& Note) {
+			std::ofstream file("benchmark_" + Bench_Name + ".csv");
+			file << "name,iterations,total_ns,ns_per_iteration,mb_per_sec\n";
+			for (const auto& R : Results) {
+				file << R.name << ',' << R.iterations << ',' << R.elapsed.count() << ','
+					<< static_cast<double>(R.elapsed.count()) / static_cast<double>(R.iterations) << ',';
+				if (R.bytes > 0 && R.elapsed.count() > 0) {
+					const double Seconds = static_cast<double>(R.elapsed.count()) / 1e9;
+					file << static_cast<double>(R.bytes * R.iterations) / (1024.0 * 1024.0) / Seconds;
+				}
+				file << '\n';
+			}
+			if (!Note.empty())
+				file << "# " << Note << '\n';
+		}
+
+		// 計測用のイベントファイルを書き出す。
+		bool WriteScript(const std::wstring& Path, const std::wstring& Script) {
+			const std::wstring Text = L"\xFEFF" + Script;
+			return WriteBinaryFile(Path.c_str(), Text.data(), Text.size() * sizeof(wchar_t));
+		}
+
+		// 計測用のイベントファイルを書き出し、読み込む。
+		event::Event* LoadScript(const std::wstring& Event_Name, const std::wstring& Script) {
+			const std::wstring Path = L"benchmark.txt";
+			if (!WriteScript(Path, Script))
+				return nullptr;
+
+			Program::Instance().event_manager.ImportEvent(Path);
+			return Program::Instance().event_manager.GetEvent(Event_Name);
+		}
+
+		// 分岐の多いイベントを生成する。
+		// 外側のcaseがArm_Count個、各分岐の内側のcaseがInner_Arm_Count個の分岐を持つ。
+		std::wstring MakeBranchScript(const std::wstring& Event_Name, const int Arm_Count, const int Inner_Arm_Count) {
+			std::wstring script = L"[" + Event_Name + L"]\n<n>\n()\n{\n";
+			script += L"case 計測値\n";
+			for (int i = 0; i < Arm_Count; i++) {
+				script += L"of " + std::to_wstring(i) + L"\n";
+				script += L"case 計測値2\n";
+				for (int j = 0; j < Inner_Arm_Count; j++) {
+					script += L"of " + std::to_wstring(j) + L"\n";
+					script += L"assign 計測結果 " + std::to_wstring(i * Inner_Arm_Count + j) + L"\n";
+				}
+				script += L"else\n";
+				script += L"assign 計測結果 -1\n";
+				script += L"endcase\n";
+			}
+			script += L"else\n";
+			script += L"assign 計測結果 -2\n";
+			script += L"endcase\n";
+			script += L"}\n";
+			return script;
+		}
+
+		// 命令列による実行と、CommandTreeを辿る実行の比較。
+		void Executer() {
+			constexpr int Arm_Count = 16, Inner_Arm_Count = 4;
+			constexpr uint64 Iterations = 100000;
+			const std::wstring Event_Name = L"分岐計測";
+
+			auto& var_manager = Program::Instance().var_manager;
+			auto& value = var_manager.MakeNew(L"計測値");
+			auto& inner_value = var_manager.MakeNew(L"計測値2");
+			auto& result = var_manager.MakeNew(L"計測結果");
+			value = 0;
+			inner_value = 0;
+			result = 0;
+
+			auto event = LoadScript(Event_Name, MakeBranchScript(Event_Name, Arm_Count, Inner_Arm_Count));
+			if (event == nullptr)
+				return;
+
+			// 全ての分岐を通る様に値を設定する。
+			auto set_values = [&](const uint64 I) {
+				value = static_cast<int>(I % (Arm_Count + 1));
+				inner_value = static_cast<int>((I / (Arm_Count + 1)) % (Inner_Arm_Count + 1));
+			};
+
+			// 両者の実行結果が一致するかを確認する。
+			uint64 mismatches = 0;
+			for (uint64 i = 0; i < (Arm_Count + 1) * (Inner_Arm_Count + 1); i++) {
+				set_values(i);
+				event::Manager::CommandExecuter executer(event);
+				const auto Expected = result.Get<int>();
+				event::Manager::LegacyCommandExecuter legacy_executer(&event->commands);
+				if (result.Get<int>() != Expected)
+					mismatches++;
+			}
+
+			std::vector<Result> results{};
+			results.push_back(Measure("legacy", Iterations, [&](const uint64 I) {
+				set_values(I);
+				event::Manager::LegacyCommandExecuter executer(&event->commands);
+			}));
+			results.push_back(Measure("bytecode", Iterations, [&](const uint64 I) {
+				set_values(I);
+				event::Manager::CommandExecuter executer(event);
+			}));
+			WriteCSV("executer", results, "mismatches=" + std::to_string(mismatches));
+		}
+
+		// 複数のファイルを一つずつ読み込む場合と、まとめて読み込む場合の比較。
+		// キャッシュは毎回削除し、必ず解析を行わせる。
+		void Import() {
+			constexpr int File_Count = 12, Event_Count = 32;
+			constexpr uint64 Iterations = 10;
+
+			std::vector<std::wstring> paths{};
+			for (int i = 0; i < File_Count; i++) {
+				std::wstring script{};
+				for (int j = 0; j < Event_Count; j++)
+					script += MakeBranchScript(L"取込計測" + std::to_wstring(i) + L"_" + std::to_wstring(j), 8, 4);
+				paths.push_back(L"benchmark_import" + std::to_wstring(i) + L".txt");
+				if (!WriteScript(paths.back(), script))
+					return;
+			}
+
+			auto remove_caches = [&paths]() {
+				for (const auto& Path : paths)
+					std::filesystem::remove(Path + L".cache");
+			};
+
+			auto& event_manager = Program::Instance().event_manager;
+			std::vector<Result> results{};
+			results.push_back(Measure("serial", Iterations, [&](const uint64) {
+				remove_caches();
+				for (const auto& Path : paths)
+					event_manager.ImportEvent(Path);
+			}));
+			results.push_back(Measure("batch", Iterations, [&](const uint64) {
+				remove_caches();
+				event_manager.ImportEvent(paths);
+			}));
+			remove_caches();
+			WriteCSV("import", results, "files=" + std::to_string(File_Count) + " threads=" + std::to_string(std::thread::hardware_concurrency()));
+		}
+
+		// 最適化の効果を計測する為の、定数の演算・静的に決まる分岐・上書きされる代入を含むイベントを生成する。
+		std::wstring MakeFoldableScript(const std::wstring& Event_Name, const int Repeat_Count) {
+			std::wstring script = L"[" + Event_Name + L"]\n<n>\n()\n{\n";
+			for (int i = 0; i < Repeat_Count; i++) {
+				const auto I = std::to_wstring(i);
+				script += L"sum 計測値 " + I + L" 1\n";
+				script += L"mul 計測値 計測値 2\n";
+				script += L"assign 一時 0\n";
+				script += L"assign 一時 " + I + L"\n";
+				script += L"sum 計測結果 計測結果 一時\n";
+				// イベント内の変数として読んだ変数への代入は、上書きされても削除されてはならない。
+				script += L"assign 別名 " + I + L"\n";
+				script += L"sum 計測結果 計測結果 " + Event_Name + L".別名\n";
+				script += L"assign 別名 0\n";
+				script += L"case 1\n";
+				script += L"of 0\n";
+				script += L"assign 計測結果 -1\n";
+				script += L"of 1\n";
+				script += L"sum 計測結果 計測結果 計測値\n";
+				script += L"else\n";
+				script += L"assign 計測結果 -2\n";
+				script += L"endcase\n";
+			}
+			script += L"}\n";
+			return script;
+		}
+
+		// 最適化を行わない場合と行う場合の実行速度の比較。
+		// 各最適化の件数も書き出す。
+		void Optimizer() {
+			constexpr int Repeat_Count = 32;
+			constexpr uint64 Iterations = 100000;
+			const std::wstring Event_Name = L"最適化計測";
+
+			auto& var_manager = Program::Instance().var_manager;
+			auto& result = var_manager.MakeNew(L"計測結果");
+			var_manager.MakeNew(L"計測値") = 0;
+			var_manager.MakeNew(L"一時") = 0;
+			var_manager.MakeNew(L"別名") = 0;
+
+			auto& event_manager = Program::Instance().event_manager;
+			const bool Was_Enabled = event_manager.optimization_enabled;
+			const auto Stats_Before = event_manager.optimization_stats;
+			std::vector<Result> results{};
+			int expected = 0;
+			uint64 mismatches = 0;
+			for (const bool Enabled : { false, true }) {
+				event_manager.optimization_enabled = Enabled;
+				std::filesystem::remove(L"benchmark.txt.cache");
+				auto event = LoadScript(Event_Name, MakeFoldableScript(Event_Name, Repeat_Count));
+				if (event == nullptr)
+					break;
+
+				// 両者の実行結果が一致するかを確認する。
+				result = 0;
+				event::Manager::CommandExecuter check(event);
+				if (!Enabled)
+					expected = result.Get<int>();
+				else if (result.Get<int>() != expected)
+					mismatches++;
+
+				results.push_back(Measure(Enabled ? "optimized" : "unoptimized", Iterations, [&](const uint64) {
+					result = 0;
+					event::Manager::CommandExecuter executer(event);
+				}));
+			}
+			event_manager.optimization_enabled = Was_Enabled;
+			std::filesystem::remove(L"benchmark.txt.cache");
+
+			const auto& Stats = event_manager.optimization_stats;
+			WriteCSV("optimizer", results, "mismatches=" + std::to_string(mismatches) +
+				" folded_calculations=" + std::to_string(Stats.folded_calculations - Stats_Before.folded_calculations) +
+				" removed_arms=" + std::to_string(Stats.removed_arms - Stats_Before.removed_arms) +
+				" expanded_cases=" + std::to_string(Stats.expanded_cases - Stats_Before.expanded_cases) +
+				" removed_unreachable=" + std::to_string(Stats.removed_unreachable - Stats_Before.removed_unreachable) +
+				" removed_stores=" + std::to_string(Stats.removed_stores - Stats_Before.removed_stores) +
+				" removed_loads=" + std::to_string(Stats.removed_loads - Stats_Before.removed_loads));
+		}
+
+		// 計測用の文字列を生成する。
+		// ASCIIと日本語が混ざった、基本多言語面内の文字のみから成る文字列を返す。
+		std::wstring MakeSampleText(const size_t Length) {
+			const std::wstring Lines[] = {
+				L"[イベント名]\n<n>\n()\n{\n",
+				L"assign 変数 12345\n",
+				L"text \"日本語の文章を表示する。\" 100 200\n",
+				L"case 計測値\nof 0\nimage \"graphics/sample.png\" 0 0\nendcase\n",
+				L"}\n"
+			};
+			std::wstring text{};
+			text.reserve(Length + 64);
+			for (size_t i = 0; text.size() < Length; i++)
+				text += Lines[i % std::size(Lines)];
+			return text;
+		}
+
+		// BOM付きのUTF-8へ変換する。
+		std::string EncodeUTF8(const std::wstring& Text) {
+			std::string bytes = "\xEF\xBB\xBF";
+			for (const wchar_t C : Text) {
+				const auto Code = static_cast<uint32_t>(C);
+				if (Code < 0x80) {
+					bytes += static_cast<char>(Code);
+				} else if (Code < 0x800) {
+					bytes += static_cast<char>(0xC0 | (Code >> 6));
+					bytes += static_cast<char>(0x80 | (Code & 0x3F));
+				} else {
+					bytes += static_cast<char>(0xE0 | (Code >> 12));
+					bytes += static_cast<char>(0x80 | ((Code >> 6) & 0x3F));
+					bytes += static_cast<char>(0x80 | (Code & 0x3F));
+				}
+			}
+			return bytes;
+		}
+
+		// BOM付きのUTF-16またはUTF-32へ変換する。
+		std::string EncodeUTF(const std::wstring& Text, const size_t Unit_Size, const bool Big_Endian) {
+			std::string bytes{};
+			bytes.reserve((Text.size() + 1) * Unit_Size);
+			auto put = [&](const uint32_t Code) {
+				for (size_t i = 0; i < Unit_Size; i++) {
+					const size_t Shift = (Big_Endian ? Unit_Size - 1 - i : i) * 8;
+					bytes += static_cast<char>((Code >> Shift) & 0xFF);
+				}
+			};
+			put(0xFEFF);
+			for (const wchar_t C : Text)
+				put(static_cast<uint32_t>(C));
+			return bytes;
+		}
+
+		// 各文字コードの文字列を、ワイド文字列へ変換する速度の計測。
+		void Kio() {
+			constexpr size_t Sample_Length = 4 * 1024 * 1024;
+			constexpr uint64 Iterations = 20;
+			const std::wstring Sample = MakeSampleText(Sample_Length);
+
+			std::string cp932(Sample.size() * 2 + 1, '\0');
+			cp932.resize(WideToCP932(cp932.data(), Sample.c_str(), cp932.size()));
+
+			const std::pair<std::string, std::string> Encoded[] = {
+				{ "cp932", std::move(cp932) },
+				{ "utf8", EncodeUTF8(Sample) },
+				{ "utf16le", EncodeUTF(Sample, 2, false) },
+				{ "utf16be", EncodeUTF(Sample, 2, true) },
+				{ "utf32le", EncodeUTF(Sample, 4, false) },
+				{ "utf32be", EncodeUTF(Sample, 4, true) }
+			};
+
+			// 変換結果が元の文字列と一致するかを確認する。
+			std::vector<Result> results{};
+			std::wstring decoded{};
+			uint64 mismatches = 0;
+			for (const auto& [Name, Bytes] : Encoded) {
+				DecodeText(Bytes.data(), Bytes.size(), &decoded);
+				if (decoded != Sample)
+					mismatches++;
+
+				results.push_back(Measure(Name, Iterations, [&](const uint64) {
+					DecodeText(Bytes.data(), Bytes.size(), &decoded);
+				}, Bytes.size()));
+			}
+			WriteCSV("kio", results, "mismatches=" + std::to_string(mismatches));
+		}
+
+		// 解析計測用のイベントファイルに含めるコマンドの割合(重み)
+		struct CorpusMix final {
+			int branch = 2;		// case/of/else/endcase
+			int math = 4;		// assign/sum/sub/mul/div/mod
+			int image = 2;		// image
+			int call = 1;		// call
+			int japanese = 50;	// 日本語のコマンド名を用いる割合(百分率)
+		};
+
+		// "branch=2 math=4 image=2 call=1 japanese=50"の形式の引数から割合を求める。
+		// 指定されなかった、または不正な値は既定値のままとする。
+		CorpusMix ParseCorpusMix(const std::string& Arguments) {
+			const std::pair<std::string_view, int CorpusMix::*> Keys[] = {
+				{ "branch", &CorpusMix::branch },
+				{ "math", &CorpusMix::math },
+				{ "image", &CorpusMix::image },
+				{ "call", &CorpusMix::call },
+				{ "japanese", &CorpusMix::japanese }
+			};
+
+			CorpusMix mix{};
+			std::istringstream stream(Arguments);
+			std::string token{};
+			while (stream >> token) {
+				const auto Separator = token.find('=');
+				if (Separator == std::string::npos)
+					continue;
+
+				const std::string_view Key(token.data(), Separator);
+				const char* const Last = token.data() + token.size();
+				int value{};
+				const auto [End, Error] = std::from_chars(token.data() + Separator + 1, Last, value);
+				if (Error != std::errc{} || End != Last || value < 0)
+					continue;
+
+				for (const auto& [Name, Member] : Keys) {
+					if (Key == Name)
+						mix.*Member = value;
+				}
+			}
+			// 重みが全て0ではコマンドを選べない為、既定値へ戻す。
+			if (mix.branch + mix.math + mix.image + mix.call <= 0) {
+				const CorpusMix Default{};
+				mix.branch = Default.branch;
+				mix.math = Default.math;
+				mix.image = Default.image;
+				mix.call = Default.call;
+			}
+			mix.japanese = std::min(mix.japanese, 100);
+			return mix;
+		}
+
+		// 解析計測用のイベントを生成する。
+		// Event_Count個のイベントが、それぞれ約Command_Count個のコマンドを持つ。
+		// 同じ引数からは常に同じ文字列を生成する。
+		std::wstring MakeCorpus(const int Event_Count, const int Command_Count, const CorpusMix& Mix) {
+			std::mt19937 random(Event_Count * 65537 + Command_Count);
+			auto pick = [&](const int Max) {
+				return static_cast<int>(random() % static_cast<uint32_t>(Max));
+			};
+			auto word = [&](const wchar_t* English, const wchar_t* Japanese) -> std::wstring {
+				return (pick(100) < Mix.japanese ? Japanese : English);
+			};
+			const std::pair<const wchar_t*, const wchar_t*> Math_Words[] = {
+				{ L"sum", L"加算" }, { L"sub", L"減算" }, { L"mul", L"乗算" }, { L"div", L"徐算" }, { L"mod", L"剰余" }
+			};
+			const int Total_Weight = Mix.branch + Mix.math + Mix.image + Mix.call;
+
+			std::wstring corpus{};
+			for (int e = 0; e < Event_Count; e++) {
+				const auto Event_Name = L"解析計測" + std::to_wstring(e);
+				corpus += L"[" + Event_Name + L"]\n<n>\n()\n{\n";
+				for (int c = 0; c < Command_Count;) {
+					int kind = (Total_Weight > 0 ? pick(Total_Weight) : 0);
+					if ((kind -= Mix.branch) < 0) {
+						corpus += word(L"case", L"条件") + L" 計測値\n";
+						const int Arm_Count = 1 + pick(3);
+						for (int a = 0; a < Arm_Count; a++) {
+							corpus += word(L"of", L"分岐") + L" " + std::to_wstring(a) + L"\n";
+							corpus += word(L"assign", L"代入") + L" 計測結果 " + std::to_wstring(e + a) + L"\n";
+						}
+						corpus += word(L"else", L"以外") + L"\n";
+						corpus += word(L"assign", L"代入") + L" 計測結果 -1\n";
+						corpus += word(L"endcase", L"分岐終了") + L"\n";
+						c += Arm_Count * 2 + 4;
+					} else if ((kind -= Mix.math) < 0) {
+						if (pick(3) == 0) {
+							corpus += word(L"assign", L"代入") + L" 一時 '文字列" + std::to_wstring(c) + L"'\n";
+						} else {
+							const auto& [English, Japanese] = Math_Words[pick(static_cast<int>(std::size(Math_Words)))];
+							corpus += word(English, Japanese) + L" 計測値 計測値 " + std::to_wstring(1 + pick(9)) + L"\n";
+						}
+						c++;
+					} else if ((kind -= Mix.image) < 0) {
+						corpus += word(L"image", L"画像") + L" 'graphics/計測" + std::to_wstring(pick(8)) + L".png' "
+							+ std::to_wstring(pick(640)) + L" " + std::to_wstring(pick(480)) + L" 32 32\n";
+						c++;
+					} else {
+						corpus += word(L"call", L"呼出") + L" 解析計測" + std::to_wstring(pick(Event_Count)) + L"\n";
+						c++;
+					}
+				}
+				corpus += L"}\n";
+			}
+			return corpus;
+		}
+
+		// 解析の段階毎の計測結果
+		struct PhaseResult final {
+			std::string encoding, phase;
+			int events, commands;
+			uint64 iterations = 0, bytes = 0;
+			std::chrono::nanoseconds elapsed{};
+			uint64 allocations = 0, allocated_bytes = 0;
+		};
+
+		// 解析の段階毎の速度と確保回数の計測。
+		// 規模を変えた合成イベントを各文字コードで書き出し、ファイルの読込から命令列への変換までを段階毎に計測する。
+		void Parser() {
+			constexpr uint64 Iterations = 5;
+			// 規模(イベント数、イベント毎のコマンド数)
+			// 最大の規模は約10万行となる。
+			const std::pair<int, int> Sizes[] = { { 16, 32 }, { 64, 32 }, { 256, 32 }, { 64, 128 }, { 1024, 100 } };
+			const std::wstring Path = L"benchmark_parser.txt";
+			const CorpusMix Mix = ParseCorpusMix(arguments);
+
+			// 従来の解析器は規模の2乗に比例して遅くなる為、この行数以下の規模のみで比べる。
+			constexpr int Max_Legacy_Commands = 256 * 32;
+
+			std::vector<PhaseResult> results{};
+			uint64 failures = 0, mismatches = 0;
+			for (const auto& [Event_Count, Command_Count] : Sizes) {
+				const std::wstring Corpus = MakeCorpus(Event_Count, Command_Count, Mix);
+				// 従来の解析器と新しい解析器が同じイベントを生成するかを確認する。
+				if (Event_Count * Command_Count <= Max_Legacy_Commands)
+					mismatches += event::CompareWithLegacyParser(Corpus);
+				std::string cp932(Corpus.size() * 2 + 1, '\0');
+				cp932.resize(WideToCP932(cp932.data(), Corpus.c_str(), cp932.size()));
+
+				const std::pair<std::string, std::string> Encoded[] = {
+					{ "cp932", std::move(cp932) },
+					{ "utf8", EncodeUTF8(Corpus) },
+					{ "utf16le", EncodeUTF(Corpus, 2, false) },
+					{ "utf16be", EncodeUTF(Corpus, 2, true) },
+					{ "utf32le", EncodeUTF(Corpus, 4, false) },
+					{ "utf32be", EncodeUTF(Corpus, 4, true) }
+				};
+				for (const auto& [Encoding, Bytes] : Encoded) {
+					if (!WriteBinaryFile(Path.c_str(), Bytes.data(), Bytes.size()))
+						return;
+
+					const size_t First = results.size();
+					for (uint64 i = 0; i < Iterations; i++) {
+						size_t phase_index = First;
+						auto measure = [&](const char* Phase, const std::function<void()>& Func) {
+							if (phase_index == results.size())
+								results.push_back({ .encoding = Encoding, .phase = Phase, .events = Event_Count, .commands = Command_Count, .bytes = Bytes.size() });
+							auto& result = results[phase_index++];
+							const uint64 Count_Before = allocation_count.load(std::memory_order_relaxed);
+							const uint64 Bytes_Before = allocated_bytes.load(std::memory_order_relaxed);
+							counting_allocations = true;
+							const auto Start = std::chrono::steady_clock::now();
+							Func();
+							const auto End = std::chrono::steady_clock::now();
+							counting_allocations = false;
+							result.iterations++;
+							result.elapsed += std::chrono::duration_cast<std::chrono::nanoseconds>(End - Start);
+							result.allocations += allocation_count.load(std::memory_order_relaxed) - Count_Before;
+							result.allocated_bytes += allocated_bytes.load(std::memory_order_relaxed) - Bytes_Before;
+						};
+
+						// 従来の読込(文字列へ変換しない)
+						measure("read", [&]() {
+							char* text{};
+							CharCode code{};
+							ReadWTextFile(Path.c_str(), &text, &code);
+							delete[] text;
+						});
+						// 複製しない読込
+						measure("map", [&]() {
+							size_t length{};
+							CharCode code{};
+							UnmapFile(MapWTextFile(Path.c_str(), &length, &code));
+						});
+						if (event::ParseInPhases(Path, measure) != static_cast<size_t>(Event_Count))
+							failures++;
+					}
+				}
+			}
+			std::filesystem::remove(Path);
+
+			std::ofstream file("benchmark_parser.csv");
+			file << "encoding,events,commands,phase,iterations,file_bytes,total_ns,ns_per_iteration,allocations_per_iteration,allocated_bytes_per_iteration\n";
+			for (const auto& R : results) {
+				const auto Iterations_Count = static_cast<double>(R.iterations);
+				file << R.encoding << ',' << R.events << ',' << R.commands << ',' << R.phase << ','
+					<< R.iterations << ',' << R.bytes << ',' << R.elapsed.count() << ','
+					<< static_cast<double>(R.elapsed.count()) / Iterations_Count << ','
+					<< static_cast<double>(R.allocations) / Iterations_Count << ','
+					<< static_cast<double>(R.allocated_bytes) / Iterations_Count << '\n';
+			}
+			file << "# failures=" << failures << " mismatches=" << mismatches
+				<< " mix=" << Mix.branch << '/' << Mix.math << '/' << Mix.image << '/' << Mix.call << " japanese=" << Mix.japanese << '\n';
+		}
+	}
+
+	bool Run(const std::string& Name, const std::string& Arguments) {
+		static const std::unordered_map<std::string, void(*)()> Benchmarks{
+			{ "executer", Executer },
+			{ "kio", Kio },
+			{ "import", Import },
+			{ "optimizer", Optimizer },
+			{ "parser", Parser }
+		};
+
+		auto it = Benchmarks.find(Name);
+		if (it == Benchmarks.end())
+			return false;
+		arguments = Arguments;
+		it->second();
+		return true;
+	}
+}
+
+// 計測用の実行ファイルの入口。
+// コマンドライン引数に計測名("-bench:<名前>"または<名前>)と、それに続く計測毎の引数を受け取り、計測のみを行い終了する。
+// 例: "-bench:parser branch=1 math=8 japanese=0"
+int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR Command_Line, int) {
+	if (karapo::Program::Instance().engine.Failed())
+		return 1;
+
+	karapo::Program::Instance().OnInit();
+	std::string name = Command_Line, arguments{};
+	if (const auto Space = name.find(' '); Space != std::string::npos) {
+		arguments = name.substr(Space + 1);
+		name.resize(Space);
+	}
+	if (name.starts_with("-bench:"))
+		name = name.substr(std::strlen("-bench:"));
+	return (karapo::benchmark::Run(name, arguments) ? 0 : 1);
+}
@@ -0,0 +1,11 @@
+/**
+* Benchmark.hpp - 処理速度を計測するための定義群。
+*/
+#pragma once
+
+namespace karapo::benchmark {
+	// 名前に該当する計測を行い、結果を"benchmark_<名前>.csv"へ書き出す。
+	// Argumentsは計測毎の引数(parserでは"branch=2 math=4 image=2 call=1 japanese=50"の形式で生成する命令の割合を指定する。省略した値は既定値となる)。
+	// 該当する計測が存在しない場合はfalseを返す。
+	bool Run(const std::string& Name, const std::string& Arguments = "");
+}
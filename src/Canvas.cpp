@@ -7,7 +7,7 @@ namespace karapo {
 	Filter::~Filter() {}
 
 	namespace filter {
-		// tB^[
+		// フィルター無し
 		class None final : public Filter {
 		public:
 			~None() final {}
@@ -18,7 +18,7 @@ namespace karapo {
 			}
 		};
 
-		// F]tB^[
+		// 色反転フィルター
 		class ReversedColor final : public Filter {
 			const int Potency;
 		public:
@@ -34,7 +34,7 @@ namespace karapo {
 			}
 		};
 
-		// X]tB^[
+		// X軸反転フィルター
 		class XReversed final : public Filter {
 		public:
 			XReversed() noexcept {}
@@ -46,7 +46,7 @@ namespace karapo {
 			}
 		};
 
-		// Y]tB^[
+		// Y軸反転フィルター
 		class YReversed final : public Filter {
 		public:
 			YReversed() noexcept {}
@@ -57,7 +57,7 @@ namespace karapo {
 			}
 		};
 
-		// mNtB^[
+		// モノクロフィルター
 		class Monochrome : public Filter {
 			const Color Base_Color;
 		public:
@@ -71,13 +71,13 @@ namespace karapo {
 		filters[L"none"] = []() { return std::make_unique<filter::None>(); };
 
 		filters[L"reversed_color"] = 
-			filters[L"F]"] = [P]() { return std::make_unique<filter::ReversedColor>(P); };
+			filters[L"色反転"] = [P]() { return std::make_unique<filter::ReversedColor>(P); };
 
 		filters[L"mirrorx"] = 
-			filters[L"c]"] = []() { return std::make_unique<filter::XReversed>(); };
+			filters[L"縦反転"] = []() { return std::make_unique<filter::XReversed>(); };
 		filters[L"mirrory"] = 
-			filters[L"]"] = []() { return std::make_unique<filter::YReversed>(); };
-		filters[L"monochrome"] = filters[L"mN"] = []() { return std::make_unique<filter::Monochrome>(Color{ 0, 0, 0 }); };
+			filters[L"横反転"] = []() { return std::make_unique<filter::YReversed>(); };
+		filters[L"monochrome"] = filters[L"モノクロ"] = []() { return std::make_unique<filter::Monochrome>(Color{ 0, 0, 0 }); };
 	}
 
 	std::unique_ptr<Filter> FilterMaker::Generate(const std::wstring& Filter_Name) {
@@ -87,7 +87,7 @@ namespace karapo {
 	Layer::Layer(const std::wstring& Layer_Name) noexcept {
 		screen = Program::Instance().engine.MakeScreen();
 		name = Layer_Name;
-		Program::Instance().var_manager.MakeNew(Name() + L".__Ǘ") = std::wstring(L"");
+		Program::Instance().var_manager.MakeNew(Name() + L".__管理中") = Value::Elements{};
 	}
 
 	void Layer::SetFilter(std::unique_ptr<Filter> new_filter) noexcept {
@@ -103,8 +103,9 @@ namespace karapo {
 		if (IsRegistered(drawable_entity))
 			return;
 
-		auto& var = Program::Instance().var_manager.Get<false>(Name() + L".__Ǘ");
-		std::any_cast<std::wstring&>(var) += std::wstring(drawable_entity->Name()) + L'\\';
+		auto& var = Program::Instance().var_manager.Get<false>(Name() + L".__管理中");
+		if (var.Is<Value::Elements>())
+			var.Get<Value::Elements>().push_back(std::wstring(drawable_entity->Name()));
 		drawing.push_back(drawable_entity);
 	}
 
@@ -116,46 +117,53 @@ namespace karapo {
 		auto iterator = std::find(drawing.begin(), drawing.end(), Target_Entity);
 		if (iterator != drawing.end()) {
 			drawing.erase(iterator);
-			auto& var = Program::Instance().var_manager.Get<false>(Name() + L".__Ǘ");
-			auto& str = std::any_cast<std::wstring&>(var);
-			const auto Position = str.find(Target_Entity->Name());
-			str.erase(Position, Position + wcslen(Target_Entity->Name()) + 1);
+			auto& var = Program::Instance().var_manager.Get<false>(Name() + L".__管理中");
+			if (!var.Is<Value::Elements>())
+				return;
+
+			auto& names = var.Get<Value::Elements>();
+			const std::wstring Target_Name = Target_Entity->Name();
+			const auto Position = std::find_if(names.begin(), names.end(), [&Target_Name](const Value& V) {
+				return V.Is<std::wstring>() && V.Get<std::wstring>() == Target_Name;
+			});
+			if (Position != names.end())
+				names.erase(Position);
 		}
 	}
 
 	/**
-	* Έʒu^C[
-	* base𒆐SƂĎ͂̕`ʂsC[B
+	* 相対位置型レイヤー
+	* baseを中心として周囲の描写を行うレイヤー。
 	*/
 	class RelativeLayer : public Layer {
 		std::shared_ptr<Entity> base = nullptr;
 	public:
 		inline RelativeLayer(const std::wstring& lname) noexcept : Layer(lname) {
 			SetFilter(std::make_unique<filter::None>());
-			Program::Instance().var_manager.MakeNew(lname + L".x[X") = std::wstring(L"");
+			Program::Instance().var_manager.MakeNew(lname + L".ベース") = std::wstring(L"");
 		}
 
 		~RelativeLayer() noexcept {
-			Program::Instance().var_manager.Delete(Name() + L".x[X");
+			Program::Instance().var_manager.Delete(Name() + L".ベース");
 		}
 
 		void Execute() noexcept override {
 			Layer::Execute();
 			if (base != nullptr && base->CanDelete()) {
-				Program::Instance().var_manager.Get<false>(Name() + L".x[X") = std::wstring(L"");
+				Program::Instance().var_manager.Get<false>(Name() + L".ベース") = std::wstring(L"");
 				base = nullptr;
 			}
 		}
 
-		// SƂȂEntityݒ肷B
+		// 中心となるEntityを設定する。
 		void SetBase(std::shared_ptr<Entity>& ent) noexcept {
 			base = ent;
-			Program::Instance().var_manager.Get<false>(Name() + L".x[X") = std::wstring(base->Name());
+			Program::Instance().var_manager.Get<false>(Name() + L".ベース") = std::wstring(base->Name());
 		}
 
 		/**
-		* `
-		* (0,0) <= base_origin <= (W, H)𖞂悤ɉʕ`ʂsB
+		* 描写
+		* (0,0) <= base_origin <= (W, H)を満たすように画面描写を行う。
 		*/
 		void Draw() noexcept override {
 			static WorldVector old_origin = { 0.0, 0.0 };
@@ -176,12 +184,12 @@ namespace karapo {
 		}
 
 		const wchar_t* KindName() const noexcept {
-			return L"XN[";
+			return L"スクロール";
 		}
 	};
 
 	/**
-	* Έʒu^C[
+	* 絶対位置型レイヤー
 	*/
 	class AbsoluteLayer : public Layer {
 	public:
@@ -205,7 +213,7 @@ namespace karapo {
 		}
 
 		const wchar_t* KindName() const noexcept {
-			return L"Œ";
+			return L"固定";
 		}
 	};
 }
@@ -261,7 +269,7 @@ namespace karapo {
 		if (selecting_layer != layers.end() && (*selecting_layer)->Name() == Name)
 			selecting_layer = layers.end();
 
-		Program::Instance().var_manager.Delete((*layer)->Name() + L".__Ǘ");
+		Program::Instance().var_manager.Delete((*layer)->Name() + L".__管理中");
 		const std::wstring&& Selecting_Name = (selecting_layer != layers.end() ? (*selecting_layer)->Name() : L"");
 		layers.erase(layer);
 		if (!Selecting_Name.empty())
@@ -276,7 +284,7 @@ namespace karapo {
 		if (selecting_layer != layers.end() && (*selecting_layer)->Name() == (*(layers.begin() + Index))->Name())
 			selecting_layer = layers.end();
 
-		Program::Instance().var_manager.Delete(layers[Index]->Name() + L".__Ǘ");
+		Program::Instance().var_manager.Delete(layers[Index]->Name() + L".__管理中");
 
 		const std::wstring&& Selecting_Name = (selecting_layer != layers.end() ? (*selecting_layer)->Name() : L"");
 		layers.erase(layers.begin() + Index);
@@ -361,9 +369,9 @@ namespace karapo {
 		}
 
 		std::wstring sen{};
-		sen += layers[Index]->Name() + L'=';						// O
-		sen += std::wstring(layers[Index]->KindName()) + L':';		// ޖ
-		sen += std::to_wstring(Index);								// vfʒu
+		sen += layers[Index]->Name() + L'=';						// 名前
+		sen += std::wstring(layers[Index]->KindName()) + L':';		// 種類名
+		sen += std::to_wstring(Index);								// 要素位置
 		return sen;
 	}
 
@@ -1,5 +1,5 @@
 /**
-* Canvas.hpp - Q[ł̃LoXEC[@\̒`QB
+* Canvas.hpp - ゲーム上でのキャンバス・レイヤー機能の定義群。
 */
 #pragma once
 
@@ -17,10 +17,10 @@ namespace karapo {
 		std::unique_ptr<Filter> Generate(const std::wstring&);
 	};
 
-	// C[
+	// レイヤー
 	class Layer {
 		TargetRender screen;
-		std::wstring name{};	// C[
+		std::wstring name{};	// レイヤー名
 		bool hide = false;
 		bool IsShowing() const noexcept { return !hide; }
 	protected:
@@ -32,7 +32,7 @@ namespace karapo {
 		void SetFilter(std::unique_ptr<Filter>) noexcept;
 
 		virtual void Execute() noexcept;
-		// \[Xo^B
+		// リソースを登録する。
 		virtual void Register(std::shared_ptr<Entity>&) noexcept;
 		bool IsRegistered(const std::shared_ptr<Entity>&) const noexcept;
 		void Remove(const std::shared_ptr<Entity>&) noexcept;
@@ -46,17 +46,17 @@ namespace karapo {
 		virtual const wchar_t* KindName() const noexcept = 0;
 	};
 
-	// LoX
+	// キャンバス
 	class Canvas final : private Singleton {
-		// C[̃|C^
+		// レイヤーのポインタ
 		using LayerPtr = std::unique_ptr<Layer>;
-		// C[
+		// レイヤー
 		using Layers = std::vector<LayerPtr>;
-		// ǗC[
+		// 管理中レイヤー
 		Layers layers;
 		std::vector<std::pair<int, LayerPtr>> hiding{};
 
-		// Ώۂ̃C[
+		// 操作対象のレイヤー
 		Layers::iterator selecting_layer{};
 
 		template<typename T>
@@ -80,12 +80,12 @@ namespace karapo {
 			Register(std::shared_ptr<Entity>&, const int), 
 			Register(std::shared_ptr<Entity>&, const std::wstring&);
 
-		// C[쐬AǉB
+		// レイヤーを作成し、追加する。
 		bool CreateRelativeLayer(const std::wstring&), CreateAbsoluteLayer(const std::wstring&);
 		bool CreateRelativeLayer(const std::wstring&, const int), CreateAbsoluteLayer(const std::wstring&, const int);
 		bool CreateLayer(std::unique_ptr<Layer>, const int);
 		bool DeleteLayer(const std::wstring&) noexcept, DeleteLayer(const int) noexcept;
-		// Ώۂ̃C[IB
+		// 操作対象のレイヤーを選択する。
 		void SelectLayer(const int) noexcept, SelectLayer(const std::wstring&) noexcept;
 		void SetBasis(std::shared_ptr<Entity>&, const std::wstring&);
 
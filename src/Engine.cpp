@@ -151,7 +151,7 @@ namespace karapo {
 
 		for (int i = 0; i < 256; i++) {
 			auto& key = keys_state[i];
-			// L[Ăꍇ
+			// キーが押されている場合
 			if (chs[i]) 
 				key++;
 			else 
@@ -235,9 +235,9 @@ namespace karapo {
 			{ L"apps", KEY_INPUT_APPS },
 			{ L"pause", KEY_INPUT_PAUSE },
 			{ L"convert", KEY_INPUT_CONVERT },
-			{ L"ϊ", KEY_INPUT_CONVERT },
+			{ L"変換", KEY_INPUT_CONVERT },
 			{ L"noconvert", KEY_INPUT_NOCONVERT },
-			{ L"ϊ", KEY_INPUT_NOCONVERT },
+			{ L"無変換", KEY_INPUT_NOCONVERT },
 			{ L"/", KEY_INPUT_SLASH },
 			{ L"\\", KEY_INPUT_BACKSLASH },
 			{ L",", KEY_INPUT_COMMA },
@@ -259,11 +259,11 @@ namespace karapo {
 			{ L"f11", KEY_INPUT_F11 },
 			{ L"f12", KEY_INPUT_F12 },
 			{ L"leftclick", MOUSE_INPUT_LEFT },
-			{ L"NbN", MOUSE_INPUT_LEFT },
+			{ L"左クリック", MOUSE_INPUT_LEFT },
 			{ L"rightclick", MOUSE_INPUT_RIGHT },
-			{ L"ENbN", MOUSE_INPUT_RIGHT },
+			{ L"右クリック", MOUSE_INPUT_RIGHT },
 			{ L"wheelclick", MOUSE_INPUT_MIDDLE },
-			{ L"NbN", MOUSE_INPUT_MIDDLE }
+			{ L"中央クリック", MOUSE_INPUT_MIDDLE }
 		};
 
 		if (iswdigit(Key_Name[0])) {
@@ -379,8 +379,8 @@ namespace karapo {
 		.LoadEvent = [](const std::wstring& Path) { Program::Instance().event_manager.LoadEvent(Path); },
 		.ExecuteEventByName = [](const std::wstring& Name) { Program::Instance().event_manager.Call(Name); },
 		.ExecuteEventByOrigin = [](const WorldVector& Origin) { Program::Instance().event_manager.ExecuteEvent(Origin); },
-		.MakeVar = [](const std::wstring& Var_Name) -> std::any& { return Program::Instance().var_manager.MakeNew(Var_Name); },
-		.GetVar = [](const std::wstring& Var_Name) -> std::any& { return Program::Instance().var_manager.Get<false>(Var_Name); },
+		.MakeVar = [](const std::wstring& Var_Name) -> Value& { return Program::Instance().var_manager.MakeNew(Var_Name); },
+		.GetVar = [](const std::wstring& Var_Name) -> Value& { return Program::Instance().var_manager.Get<false>(Var_Name); },
 		.GetEventEditor = []() { return Program::Instance().MakeEventEditor(); },
 		.MakeNewEvent = [](event::EventEditor* editor, const std::wstring& Event_Name) { editor->MakeNewEvent(Event_Name); },
 		.SetTargetEvent = [](event::EventEditor* editor, const std::wstring& Event_Name) { editor->SetTarget(Event_Name); },
@@ -389,7 +389,7 @@ namespace karapo {
 		.ChangeEventRange = [](event::EventEditor* editor, const WorldVector Min, const WorldVector Max) { editor->ChangeRange(Min, Max); },
 		.FreeEventEditor = [](event::EventEditor* editor) { Program::Instance().FreeEventEditor(editor); },
 		.GetParamInfo = [](const std::wstring& Param) -> std::pair<std::wstring, std::wstring> {
-			// ̏B
+			// 引数の情報。
 			const auto Index = Param.rfind(L':');
 			const auto Var = (Index == Param.npos ? Param : Param.substr(0, Index));
 			const auto Type = (Index == Param.npos ? L"" : Param.substr(Index + 1));
@@ -487,6 +487,10 @@ namespace karapo {
 			.Left_Click = (value::Key)MOUSE_INPUT_LEFT,
 			.Right_Click = (value::Key)MOUSE_INPUT_RIGHT,
 			.Wheel_Click = (value::Key)MOUSE_INPUT_MIDDLE
-		}
+		},
+		.GetEventHandle = [](const std::wstring& Name) { return Program::Instance().event_manager.FindHandle(Name); },
+		.ExecuteEventByHandle = [](const event::EventHandle Handle) { return Program::Instance().event_manager.Call(Handle); },
+		.EnableProfiler = [](const bool Enable) { Program::Instance().event_manager.profiler.Enable(Enable); },
+		.DumpProfile = [](const std::wstring& Base_Path) { return Program::Instance().event_manager.profiler.Dump(Base_Path); }
 	};
 }
\ No newline at end of file
@@ -5,15 +5,23 @@
 namespace karapo {
 	namespace variable {
 		class Manager final : private Singleton {
-			std::unordered_map<std::wstring, std::any> vars;
+			std::unordered_map<std::wstring, Value> vars;
+			// 変数の追加・削除が行われる度に増える値。
+			uint64 generation = 0;
 			Manager();
 			~Manager() = default;
 		public:
-			std::any& MakeNew(const std::wstring&);
+			Value& MakeNew(const std::wstring&);
 			void Delete(const std::wstring&) noexcept;
 
+			// 変数の構成が変わった回数を返す。
+			// 値が変わっていなければ、以前にGetで得た参照は同じ変数を指す。
+			uint64 Generation() const noexcept {
+				return generation;
+			}
+
 			template<bool throw_except>
-			std::any& Get(const std::wstring& Var_Name) noexcept(!throw_except) {
+			Value& Get(const std::wstring& Var_Name) noexcept(!throw_except) {
 				if constexpr (throw_except) {
 					return vars.at(Var_Name);
 				} else {
@@ -46,6 +54,7 @@ namespace karapo {
 				using Initializer = void(WINAPI*)(ProgramInterface);
 				using LoopableMain = bool(WINAPI*)();
 				using EventRegister = void(WINAPI*)(std::unordered_map<std::wstring, event::GenerateFunc>*);
+				using VersionGetter = std::uint32_t(WINAPI*)();
 
 				HMODULE mod;
 				Initializer Init;
@@ -54,6 +63,8 @@ namespace karapo {
 			};
 
 			std::unordered_map<std::wstring, DLL> dlls;
+			// DLLの接続・切断の度に増える値
+			uint64 generation = 0;
 
 			Manager() = default;
 			~Manager() = default;
@@ -66,6 +77,11 @@ namespace karapo {
 			void RegisterExternalCommand(std::unordered_map<std::wstring, event::GenerateFunc>*);
 			HMODULE Get(const std::wstring&) noexcept;
 
+			// DLLの構成を表す値を返す。接続・切断の度に変わる。
+			uint64 Generation() const noexcept {
+				return generation;
+			}
+
 			static Manager& Instance() noexcept {
 				static Manager manager;
 				return manager;
@@ -104,8 +120,8 @@ namespace karapo {
 			bool Failed() const noexcept;
 
 			resource::Resource LoadImage(const std::wstring&) noexcept, LoadSound(const std::wstring&) noexcept;
-			// ẅ̉摜Rs[B
-			// Rs[ARs[pathRs[̖OɏB
+			// 指定領域を元の画像からコピーする。
+			// コピー後、コピー元を示すpathをコピー先の名前に書き換える。
 			resource::Resource CopyImage(std::wstring* path, const ScreenVector Position, const ScreenVector Length) noexcept;
 
 			void SetBlend(const BlendMode, const int);
@@ -7,6 +7,7 @@
 #include <thread>
 #include <future>
 #include <forward_list>
+#include <algorithm>
 
 namespace karapo::entity {
 	Manager::Manager() {
@@ -51,6 +52,11 @@ namespace karapo::entity {
 		return (it != results.end() ? *it : glacial_chunk.Get(Condition));
 	}
 
+	void Manager::ForEach(const std::function<void(const std::shared_ptr<Entity>&)>& Func) const {
+		for (auto& group : chunks)
+			group.ForEach(Func);
+	}
+
 	void Manager::Kill(const std::wstring& Name) noexcept {
 		killable_entities.insert(Name);
 	}
@@ -73,9 +79,12 @@ namespace karapo::entity {
 				candidate = &chunks.front();
 			}
 			candidate->Register(entity);
-			auto var = std::any_cast<std::wstring>(Program::Instance().var_manager.Get<false>(variable::Managing_Entity_Name));
-			var += std::wstring(entity->Name()) + L"=" + std::wstring(entity->KindName()) + L"\n";
-			Program::Instance().var_manager.Get<false>(variable::Managing_Entity_Name) = var;
+			auto& names = Program::Instance().var_manager.Get<false>(variable::Managing_Entity_Name);
+			auto& kinds = Program::Instance().var_manager.Get<false>(variable::Managing_Entity_Kind_Name);
+			if (names.Is<Value::Elements>() && kinds.Is<Value::Elements>()) {
+				names.Get<Value::Elements>().push_back(std::wstring(entity->Name()));
+				kinds.Get<Value::Elements>().push_back(std::wstring(entity->KindName()));
+			}
 			if (!Layer_Name.empty())
 				Program::Instance().canvas.Register(entity, Layer_Name);
 			else
@@ -153,6 +162,11 @@ namespace karapo::entity {
 		return nullptr;
 	}
 
+	void Chunk::ForEach(const std::function<void(const std::shared_ptr<Entity>&)>& Func) const {
+		for (auto& ent : entities)
+			Func(ent.second);
+	}
+
 	// 管理中の数を返す。
 	size_t Chunk::Size() const noexcept {
 		return entities.size();
@@ -162,13 +176,21 @@ namespace karapo::entity {
 	void Chunk::Kill(const std::wstring& Name) noexcept {
 		auto ent = entities.find(Name);
 		if (ent != entities.end()) {
-			auto& var = Program::Instance().var_manager.Get<false>(variable::Managing_Entity_Name);
-			auto& str = std::any_cast<std::wstring&>(var);
-			auto pos = str.find(Name);
-			if (pos != str.npos) {
-				auto name_begin = str.substr(0, pos - 1);
-				auto name_end = str.substr(pos + Name.size());
-				str = name_begin + name_end;
+			auto& names_var = Program::Instance().var_manager.Get<false>(variable::Managing_Entity_Name);
+			auto& kinds_var = Program::Instance().var_manager.Get<false>(variable::Managing_Entity_Kind_Name);
+			if (names_var.Is<Value::Elements>() && kinds_var.Is<Value::Elements>()) {
+				// 名前と種類は同じ添字に並んでいるので、両方から同じ位置を削除する。
+				auto& names = names_var.Get<Value::Elements>();
+				auto& kinds = kinds_var.Get<Value::Elements>();
+				const auto Position = std::find_if(names.begin(), names.end(), [&Name](const Value& V) {
+					return V.Is<std::wstring>() && V.Get<std::wstring>() == Name;
+				});
+				if (Position != names.end()) {
+					const auto Index = Position - names.begin();
+					names.erase(Position);
+					if (Index < static_cast<decltype(Index)>(kinds.size()))
+						kinds.erase(kinds.begin() + Index);
+				}
 			}
 			Program::Instance().canvas.Remove(ent->second);
 			entities.erase(ent);
@@ -198,7 +220,7 @@ namespace karapo::entity {
 		path = Path;
 
 		auto& var = Program::Instance().var_manager.Get<false>(std::wstring(Name()) + L".path");
-		if (var.type() != typeid(std::nullptr_t)) {
+		if (!var.Is<std::nullptr_t>()) {
 			var = path;
 		} else {
 			Program::Instance().var_manager.MakeNew(std::wstring(Name()) + L".path") = path;
@@ -318,7 +340,7 @@ namespace karapo::entity {
 	Text::~Text() noexcept {}
 
 	int Text::Main() {
-		text = std::any_cast<std::wstring>(Program::Instance().var_manager.Get<false>(name + L".text"));
+		text = Program::Instance().var_manager.Get<false>(name + L".text").Get<std::wstring>();
 		return 0;
 	}
 
@@ -401,15 +423,15 @@ namespace karapo::entity {
 		{
 			auto& path_var = Program::Instance().var_manager.Get<false>(std::wstring(name) + L".path");
 			
-			if (path_var.type() == typeid(std::wstring) && std::any_cast<std::wstring&>(path_var) != Path()) {
-				Load(std::any_cast<std::wstring&>(path_var));
-			} else if (path_var.type() == typeid(animation::FrameRef) && &std::any_cast<animation::FrameRef&>(path_var) != Frame()) {
-				Load(&std::any_cast<animation::FrameRef&>(path_var));
+			if (path_var.Is<std::wstring>() && path_var.Get<std::wstring>() != Path()) {
+				Load(path_var.Get<std::wstring>());
+			} else if (path_var.Is<animation::FrameRef>() && &path_var.Get<animation::FrameRef>() != Frame()) {
+				Load(&path_var.Get<animation::FrameRef>());
 			}
 		}
 
-		length[0] = std::any_cast<int>(Program::Instance().var_manager.Get<false>(std::wstring(name) + L".w"));
-		length[1] = std::any_cast<int>(Program::Instance().var_manager.Get<false>(std::wstring(name) + L".h"));
+		length[0] = Program::Instance().var_manager.Get<false>(std::wstring(name) + L".w").Get<int>();
+		length[1] = Program::Instance().var_manager.Get<false>(std::wstring(name) + L".h").Get<int>();
 	}
 
 	void Button::Collide() noexcept {
@@ -426,7 +448,7 @@ namespace karapo::entity {
 				collided_enough = true;
 			}
 
-			const bool Is_Clicking = std::any_cast<int>(Program::Instance().var_manager.Get<false>(L"マウスポインタ.左クリック"));
+			const bool Is_Clicking = Program::Instance().var_manager.Get<false>(L"マウスポインタ.左クリック").Get<int>();
 			if (Is_Clicking) {
 				Program::Instance().event_manager.Call(Clicking_Event_Name);
 			}
@@ -1,5 +1,5 @@
 /**
-* Entity.hpp - Q[̃LN^[IuWFNg\ׂ̒`QB
+* Entity.hpp - ゲーム内のキャラクターやオブジェクトを表す為の定義群。
 */
 #pragma once
 
@@ -12,7 +12,7 @@ namespace karapo::entity {
 		void Teleport(WorldVector) override;
 	};
 
-	// 摜EntityNX
+	// 画像Entityクラス
 	class Image : public Object {
 		resource::Image image;
 		bool can_delete = false;
@@ -34,7 +34,7 @@ namespace karapo::entity {
 		WorldVector Length() const noexcept final;
 	};
 
-	// EntityNX
+	// 音Entityクラス
 	class Sound : public Object {
 		resource::Sound sound;
 		bool can_delete = false;
@@ -87,13 +87,13 @@ namespace karapo::entity {
 		WorldVector Length() const noexcept final { return { 0.0, 0.0 }; }
 	};
 
-	// {^
+	// ボタン
 	class Button : public Image {
 		std::wstring name{};
 		bool collided_enough{};
 
 		void Update();
-		// Փˎ̏
+		// 衝突時の処理
 		void Collide() noexcept;
 
 	public:
@@ -107,32 +107,34 @@ namespace karapo::entity {
 		void Draw(WorldVector) override;
 	};
 
-	// Entity̉(z)ŊǗNX
+	// Entityを一つの塊(配列)で管理するクラス
 	class Chunk {
 		std::unordered_map<std::wstring, std::shared_ptr<Entity>> entities{};
 	public:
-		// EntityXVB
+		// Entityを更新する。
 		void Update() noexcept;
-		// Entityo^B
+		// Entityを登録する。
 		void Register(std::shared_ptr<Entity>&) noexcept;
-		// Y閼OEntity擾B
+		// 該当する名前のEntityを取得する。
 		std::shared_ptr<Entity> Get(const std::wstring& Name) const noexcept;
-		// YEntity擾B
+		// 該当する条件のEntityを取得する。
 		std::shared_ptr<Entity> Get(std::function<bool(std::shared_ptr<Entity>)> Condition) const noexcept;
-		// Ǘ̐ԂB
+		// 管理中のEntityを順に渡す。
+		void ForEach(const std::function<void(const std::shared_ptr<Entity>&)>& Func) const;
+		// 管理中の数を返す。
 		size_t Size() const noexcept;
-		// EntityEB
+		// Entityを殺す。
 		void Kill(const std::wstring& Entity_Name) noexcept;
-		// Y閼OEntityChunk珜OB
+		// 該当する名前のEntityをChunkから除外する。
 		void Remove(const std::shared_ptr<Entity>& Target) noexcept;
 	};
 
-	// EntityǗNXB
+	// Entityを管理するクラス。
 	class Manager final : private Singleton {
 		std::unordered_set<std::wstring> freezable_entity_kind{},
 			killable_entities{};
-		std::vector<Chunk> chunks{};	// EntityXV`NB
-		Chunk glacial_chunk{};			// EntityXVȂ`NB
+		std::vector<Chunk> chunks{};	// Entityを更新するチャンク。
+		Chunk glacial_chunk{};			// Entityを更新しないチャンク。
 
 		error::UserErrorHandler error_handler{};
 		error::ErrorClass *entity_error_class{};
@@ -141,29 +143,31 @@ namespace karapo::entity {
 		Manager();
 		~Manager() = default;
 	public:
-		// EntityXVB
+		// Entityを更新する。
 		void Update() noexcept;
-		// Y閼OEntity肷B
+		// 該当する名前のEntityを入手する。
 		std::shared_ptr<Entity> GetEntity(const std::wstring& Name) const noexcept;
-		// ֐̏ɓĂ͂܂Entity肷B
+		// 関数内の条件に当てはまるEntityを入手する。
 		std::shared_ptr<Entity> GetEntity(std::function<bool(std::shared_ptr<Entity>)> Condition) const noexcept;
+		// 更新対象のEntityを順に渡す。
+		void ForEach(const std::function<void(const std::shared_ptr<Entity>&)>& Func) const;
 
-		// Y閼OEntityEB
+		// 該当する名前のEntityを殺す。
 		void Kill(const std::wstring&) noexcept;
 
-		// ǗɂEntity̐ԂB
+		// 管理下にあるEntityの数を返す。
 		size_t Amount() const noexcept;
 
-		// EntityǗɒuB
+		// Entityを管理下に置く。
 		void Register(std::shared_ptr<Entity>) noexcept, Register(std::shared_ptr<Entity>, const std::wstring&) noexcept;
 
-		// Y閼OEntityXVΏۂOB
+		// 該当する名前のEntityを更新対象から外す。
 		bool Freeze(std::shared_ptr<Entity>& target) noexcept;
-		// YEntity̎ނXVΏۂOB
+		// 該当するEntityの種類を更新対象から外す。
 		bool Freeze(const std::wstring& Entity_Name) noexcept;
-		// Y閼OEntityXVΏۂɂB
+		// 該当する名前のEntityを更新対象にする。
 		bool Defrost(std::shared_ptr<Entity>& target) noexcept;
-		// YEntity̎ނXVΏۂɂB
+		// 該当するEntityの種類を更新対象にする。
 		bool Defrost(const std::wstring& Entity_Name) noexcept;
 
 		static Manager& Instance() noexcept {
@@ -3,9 +3,9 @@
 namespace karapo::error {
 	struct ErrorContent final {
 		ErrorClass *parent{};
-		std::wstring message{};		// bZ[WB
-		int mb{};					// MB_n}Ni[ϐB
-		unsigned level{};			// G[xB
+		std::wstring message{};		// メッセージ。
+		int mb{};					// MB_系マクロを格納する変数。
+		unsigned level{};			// エラーレベル。
 	};
 
 	struct ErrorClass final {
@@ -32,13 +32,34 @@ namespace karapo::error {
 	}
 
 	void UserErrorHandler::SendGlobalError(ErrorContent* eclass, const std::wstring& External_Sentence, void(* Func)(const int)) {
+		if (staging != nullptr) {
+			staging->global.push_back({ eclass, External_Sentence, Func });
+			return;
+		}
 		global_errors.push_front({ eclass, External_Sentence, Func });
 	}
 
 	void UserErrorHandler::SendLocalError(ErrorContent* eclass, const std::wstring& External_Sentence, void(*Func)(const int)) {
+		if (staging != nullptr) {
+			staging->local.push_back({ eclass, External_Sentence, Func });
+			return;
+		}
 		local_errors.push_front({ eclass, External_Sentence, Func });
 	}
 
+	void UserErrorHandler::Stage(StagedErrors* staged) noexcept {
+		staging = staged;
+	}
+
+	void UserErrorHandler::Commit(StagedErrors* staged) {
+		for (auto& [content, extra, func] : staged->global)
+			global_errors.push_front({ content, std::move(extra), func });
+		for (auto& [content, extra, func] : staged->local)
+			local_errors.push_front({ content, std::move(extra), func });
+		staged->global.clear();
+		staged->local.clear();
+	}
+
 	bool UserErrorHandler::ShowError(ErrorElement* error_elements, const unsigned Error_Level) {
 		bool any_errors = false;
 		while (!error_elements->empty()) {
@@ -1,26 +1,40 @@
 /**
-* Error.hpp - Q[̃G[߂̒`QB
+* Error.hpp - ゲーム内のエラーを扱うための定義群。
 */
 #pragma once
 namespace karapo::error {
-	// [ŨG[NXB
+	// ユーザのエラーを扱うクラス。
 	class UserErrorHandler {
 		using ErrorElement = std::list<std::tuple<ErrorContent*, std::wstring, void(*)(const int)>>;
-		// Q[ŜƂẴG[QB
+		// ゲーム全体としてのエラー群。
 		inline static ErrorElement global_errors{};
-		// Q[̓̃G[QB
+		// ゲームの特定のエラー群。
 		ErrorElement local_errors{};
 
 		static bool ShowError(ErrorElement*, const unsigned Error_Level);
 	public:
+		// 作業スレッドから送られたエラー群
+		// 送られた順に溜めておき、後で決まった順に送り直す。
+		struct StagedErrors final {
+			ErrorElement local{}, global{};
+		};
+	private:
+		// エラーを溜めている場合の送り先(スレッド毎)
+		inline static thread_local StagedErrors* staging = nullptr;
+	public:
+		// 以降にこのスレッドから送られるエラーを、stagedへ溜める。nullptrを渡すと元に戻す。
+		static void Stage(StagedErrors* staged) noexcept;
+		// 溜めたエラーを、送られた順に送り直して空にする。ローカルなエラーはこのエラー群へ送る。
+		void Commit(StagedErrors* staged);
+
 		static void SendGlobalError(ErrorContent*, const std::wstring & = L"", void(*)(const int) = nullptr);
 		static bool ShowGlobalError(const unsigned Error_Level);
 		void SendLocalError(ErrorContent*, const std::wstring & = L"", void(*)(const int) = nullptr);
 		bool ShowLocalError(const unsigned Error_Level);
 		
-		// VȃG[̃O[v쐬B
+		// 新たなエラーのグループを作成する。
 		static ErrorClass* MakeErrorClass(const wchar_t* Error_Title);
-		// VȃG[쐬B
+		// 新たなエラーを作成する。
 		static ErrorContent* MakeError(ErrorClass*, const wchar_t* Error_Message, const int MB_Type, const unsigned Level);
 	};
 }
\ No newline at end of file
@@ -5,57 +5,326 @@
 #include "Engine.hpp"
 
 #include <queue>
+#include <map>
 #include <chrono>
 #include <forward_list>
+#include <optional>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <filesystem>
  
 #define DYNAMIC_COMMAND(NAME) class NAME : public DynamicCommand
 #define DYNAMIC_COMMAND_CONSTRUCTOR(NAME) NAME(const std::vector<std::wstring>& Param) : DynamicCommand(Param)
 
 namespace karapo::event {
 	namespace {
-		// 񒆂{}Ŏw肳ꂽɕϐ̒lŒuB
-		void ReplaceFormat(std::wstring* const sentence) noexcept {
-			size_t pos = 0;
-			for (;;) {
-				pos = sentence->find(L'{', pos);
-				if (pos == sentence->npos)
-					break;
-				auto epos = sentence->find('}', pos);
-
-				auto begin = sentence->substr(0, pos);
-				auto str = sentence->substr(pos + 1, epos - pos - 1);
-				auto end = sentence->substr(epos + 1);
-				if (begin == L"{")
-					begin.clear();
-				if (end == L"}")
-					end.clear();
-
-				auto executing_name = std::any_cast<std::wstring>(
-					Program::Instance().var_manager.Get<false>(variable::Executing_Event_Name)
-				);
-				executing_name.pop_back();
-				if (auto pos = executing_name.rfind(L'\n'); pos != executing_name.npos)
-					executing_name = executing_name.substr(pos);
-				if (auto pos = executing_name.find(L'\n'); pos != executing_name.npos)
-					executing_name.erase(executing_name.begin());
-				auto var = Program::Instance().var_manager.Get<false>(executing_name + L'.' + str);
-				if (var.type() == typeid(std::wstring)) {
-					*sentence = begin + std::any_cast<std::wstring>(var) + end;
-				} else if (var.type() == typeid(int)) {
-					*sentence = begin + std::to_wstring(std::any_cast<int>(var)) + end;
-				} else if (var.type() == typeid(Dec)) {
-					*sentence = begin + std::to_wstring(std::any_cast<Dec>(var)) + end;
-				} else {
-					*sentence = begin + end;
+		// 書式文字列
+		// {}で囲まれた部分を変数名とし、実行中のイベント内の変数の値へ置き換えて出力する。
+		// 生成時に定数部分と変数部分へ分けておき、出力時は保持しているバッファへ書き足すのみとする。
+		// {}を含まない文字列は、元の文字列をそのまま返す。
+		class FormatString final {
+			struct Segment final {
+				std::wstring text{};	// 定数部分、または変数名
+				bool is_var = false;
+
+				// 前回参照した変数
+				// 実行中のイベントと変数の構成が変わらない限り、探し直さない。
+				const std::wstring* event_name{};
+				uint64 generation = ~uint64{ 0 }, event_generation = ~uint64{ 0 };
+				const Value *var{};
+				uint32 argument = ~uint32{ 0 };		// 実行中のイベントの引数であれば、その位置
+			};
+
+			std::wstring source{};
+			// 変数部分を含まない場合は空。
+			mutable std::vector<Segment> segments{};
+			mutable std::wstring buffer{};
+
+			void Compile() {
+				segments.clear();
+				size_t pos = 0;
+				while (pos < source.size()) {
+					const auto Open = source.find(L'{', pos);
+					if (Open == source.npos)
+						break;
+					// 閉じられていない{以降は定数として扱う。
+					const auto Close = source.find(L'}', Open + 1);
+					if (Close == source.npos)
+						break;
+
+					if (Open > pos)
+						segments.push_back(Segment{ .text = source.substr(pos, Open - pos) });
+					segments.push_back(Segment{ .text = source.substr(Open + 1, Close - Open - 1), .is_var = true });
+					pos = Close + 1;
+				}
+				if (!segments.empty() && pos < source.size())
+					segments.push_back(Segment{ .text = source.substr(pos) });
+			}
+
+			void Append(const Value& Var) const {
+				switch (Var.GetType()) {
+					case Value::Type::String:
+						buffer += Var.Get<std::wstring>();
+						break;
+					case Value::Type::Int:
+					{
+						wchar_t text[16]{};
+						swprintf(text, std::size(text), L"%d", Var.Get<int>());
+						buffer += text;
+						break;
+					}
+					case Value::Type::Dec:
+					{
+						// std::to_wstringと同じ書式
+						wchar_t text[400]{};
+						swprintf(text, std::size(text), L"%f", Var.Get<Dec>());
+						buffer += text;
+						break;
+					}
+					case Value::Type::Array:
+					{
+						// 要素を改行で区切って並べる。
+						const auto& Elements = Var.Get<Value::Elements>();
+						for (size_t i = 0; i < Elements.size(); i++) {
+							if (i > 0)
+								buffer += L'\n';
+							Append(Elements[i]);
+						}
+						break;
+					}
+				}
+			}
+		public:
+			FormatString() = default;
+
+			FormatString(const std::wstring& Source) : source(Source) {
+				Compile();
+			}
+
+			// 元の文字列が変わった場合のみ解析し直す。
+			FormatString& operator=(const std::wstring& Source) {
+				if (Source != source) {
+					source = Source;
+					Compile();
+				}
+				return *this;
+			}
+
+			const std::wstring& Source() const noexcept {
+				return source;
+			}
+
+			bool IsEmpty() const noexcept {
+				return source.empty();
+			}
+
+			// 変数の値を埋め込んだ文字列を返す。
+			// 返した参照は、次に出力するまで有効。
+			const std::wstring& Render() const {
+				if (segments.empty())
+					return source;
+
+				auto& var_manager = Program::Instance().var_manager;
+				auto& event_manager = Program::Instance().event_manager;
+				const auto& Event_Name = event_manager.ExecutingEventName();
+				buffer.clear();
+				for (auto& segment : segments) {
+					if (!segment.is_var) {
+						buffer += segment.text;
+						continue;
+					}
+					if (segment.event_name != &Event_Name || segment.generation != var_manager.Generation() || segment.event_generation != event_manager.Generation()) {
+						segment.var = &var_manager.Get<false>(Event_Name + L'.' + segment.text);
+						segment.argument = ~uint32{ 0 };
+						if (!event_manager.Frames().empty()) {
+							const auto& Param_Names = event_manager.Frames().back().event->param_names;
+							if (auto it = std::find(Param_Names.begin(), Param_Names.end(), segment.text); it != Param_Names.end())
+								segment.argument = static_cast<uint32>(it - Param_Names.begin());
+						}
+						segment.event_name = &Event_Name;
+						segment.generation = var_manager.Generation();
+						segment.event_generation = event_manager.Generation();
+					}
+					if (const auto *const Argument = event_manager.Argument(segment.argument); Argument != nullptr && !Argument->Is<std::nullptr_t>())
+						Append(*Argument);
+					else
+						Append(*segment.var);
 				}
-				pos++;
+				return buffer;
+			}
+		};
+
+		// 文字列中の{}で指定された部分に変数の値で置換する。
+		// 繰り返し用いる文字列は、FormatStringとして予め解析しておく。
+		void ReplaceFormat(std::wstring* const sentence) noexcept {
+			if (sentence->find(L'{') == sentence->npos)
+				return;
+			*sentence = FormatString(*sentence).Render();
+		}
+
+		// 比較演算子を比較方法へ変換する。
+		Comparison ToComparison(const std::wstring& Mode) noexcept {
+			if (Mode == L"==")
+				return Comparison::Equal;
+			else if (Mode == L"!")
+				return Comparison::NotEqual;
+			else if (Mode == L"<=")
+				return Comparison::LessEqual;
+			else if (Mode == L">=")
+				return Comparison::GreaterEqual;
+			else if (Mode == L"<")
+				return Comparison::Less;
+			else if (Mode == L">")
+				return Comparison::Greater;
+			return Comparison::Unknown;
+		}
+
+		// 同じ型の値同士を比較する。
+		// 該当しない比較方法の場合はtrueを返す。
+		template<typename T>
+		bool Compare(const Comparison Mode, const T& Left, const T& Right) noexcept {
+			switch (Mode) {
+				case Comparison::Equal:
+					return Left == Right;
+				case Comparison::NotEqual:
+					return Left != Right;
+				case Comparison::LessEqual:
+					return Left <= Right;
+				case Comparison::GreaterEqual:
+					return Left >= Right;
+				case Comparison::Less:
+					return Left < Right;
+				case Comparison::Greater:
+					return Left > Right;
+				default:
+					return true;
+			}
+		}
+
+		// 条件対象と値を比較する。
+		// 同じ型のみを比較し、型が異なる場合や比較できない場合はtrueを返す。
+		bool EvaluteCondition(const Comparison Mode, const Value& Target, const Value& Right_Value) noexcept {
+			if (Target.GetType() != Right_Value.GetType())
+				return true;
+
+			switch (Target.GetType()) {
+				case Value::Type::Int:
+					return Compare(Mode, Target.Get<int>(), Right_Value.Get<int>());
+				case Value::Type::Dec:
+					return Compare(Mode, Target.Get<Dec>(), Right_Value.Get<Dec>());
+				case Value::Type::String:
+					// 文字列は一致・不一致のみを比較する。
+					if (Mode == Comparison::Equal || Mode == Comparison::NotEqual)
+						return Compare(Mode, Target.Get<std::wstring>(), Right_Value.Get<std::wstring>());
+					return true;
+				default:
+					return true;
+			}
+		}
+
+		// 型Tの値同士をModeで比較する条件式
+		// 値が想定した型でなければEvaluteConditionによる比較へ戻す。
+		// Hashedの場合、文字列はハッシュ値が異なれば中身を比べずに不一致とする。
+		template<typename T, const Comparison Mode, const bool Hashed>
+		bool PredicateKernel(const Value& Target, const size_t Target_Hash, const Value& Right_Value, const size_t Right_Hash) noexcept {
+			if (!Target.Is<T>() || !Right_Value.Is<T>()) [[unlikely]]
+				return EvaluteCondition(Mode, Target, Right_Value);
+			if constexpr (Hashed && std::is_same_v<T, std::wstring>) {
+				if (Target_Hash != Right_Hash)
+					return Mode == Comparison::NotEqual;
+			}
+			return Compare(Mode, Target.Get<T>(), Right_Value.Get<T>());
+		}
+
+		// 比較できない組み合わせの条件式
+		// EvaluteConditionと同じく、型に関わらず常に真となる。
+		bool AlwaysTrue(const Value&, const size_t, const Value&, const size_t) noexcept {
+			return true;
+		}
+
+		template<typename T, const bool Hashed = false>
+		Predicate SelectPredicate(const Comparison Mode) noexcept {
+			switch (Mode) {
+				case Comparison::Equal:
+					return &PredicateKernel<T, Comparison::Equal, Hashed>;
+				case Comparison::NotEqual:
+					return &PredicateKernel<T, Comparison::NotEqual, Hashed>;
+				case Comparison::LessEqual:
+					return &PredicateKernel<T, Comparison::LessEqual, Hashed>;
+				case Comparison::GreaterEqual:
+					return &PredicateKernel<T, Comparison::GreaterEqual, Hashed>;
+				case Comparison::Less:
+					return &PredicateKernel<T, Comparison::Less, Hashed>;
+				case Comparison::Greater:
+					return &PredicateKernel<T, Comparison::Greater, Hashed>;
+				default:
+					return &AlwaysTrue;
+			}
+		}
+
+		// 比較方法と比較する値の型に合う条件式を返す。
+		// Hashedの場合、文字列の比較には両者のハッシュ値を渡さなければならない。
+		Predicate SelectPredicate(const Comparison Mode, const Value::Type Type, const bool Hashed) noexcept {
+			switch (Type) {
+				case Value::Type::Int:
+					return SelectPredicate<int>(Mode);
+				case Value::Type::Dec:
+					return SelectPredicate<Dec>(Mode);
+				case Value::Type::String:
+					// 文字列は一致・不一致のみを比較する。
+					if (Mode != Comparison::Equal && Mode != Comparison::NotEqual)
+						return &AlwaysTrue;
+					return (Hashed ? SelectPredicate<std::wstring, true>(Mode) : SelectPredicate<std::wstring>(Mode));
+				default:
+					return &AlwaysTrue;
 			}
 		}
 	}
-	using Context = std::list<std::wstring>;
+
+	// 字句
+	// 文字列そのものは持たず、原文上の範囲と種類のみを持つ。
+	struct Token final {
+		enum class Kind : uint8 {
+			Word,		// 単語(コマンド名・変数名・演算子)
+			Number,		// 数値
+			String,		// 文字列('で囲まれた部分)
+			Bracket,	// 括弧({}[]<>())
+			NewLine		// 改行
+		};
+
+		Kind kind = Kind::Word;
+		uint32 begin = 0;		// 原文上の開始位置
+		uint32 length = 0;		// 原文上の長さ
+	};
+
+	// 字句解析の結果
+	struct Context final {
+		std::wstring source{};			// 解析対象の原文
+		std::vector<Token> tokens{};	// 字句列
+
+		std::wstring_view View(const Token& T) const noexcept {
+			return std::wstring_view(source).substr(T.begin, T.length);
+		}
+
+		// 字句を型情報付きの単語(名前:型)として取り出す。
+		std::wstring Word(const Token& T) const {
+			std::wstring word(View(T));
+			switch (T.kind) {
+				case Token::Kind::Number:
+					word += std::wstring(L":") + innertype::Number;
+					break;
+				case Token::Kind::String:
+					word += std::wstring(L":") + innertype::String;
+					break;
+			}
+			return word;
+		}
+	};
 
 	namespace command {
-		// EntitynR}h
+		// Entity操作系コマンド
 		class EntityCommand : public Command {
 			std::wstring entity_name;
 		protected:
@@ -64,11 +333,77 @@ namespace karapo::event {
 			}
 		};
 
-		// IR}hۃNXB
-		// R}hsɓǂݍވׂ̃o֐B
+		// 動的コマンド向け抽象クラス。
+		// 引数をコマンド実行時に読み込む為のメンバ関数を持つ。
 		class DynamicCommand : public Command {
-			// ǂݍޗ\̈B
+			// 読み込む予定の引数名。
 			std::vector<std::wstring> param_names{};
+
+			// 生成時に解析した引数
+			struct ParamSlot final {
+				std::wstring var{};			// 型を除いた引数名
+				Value literal{};			// 数値型・文字列型の場合の値
+				bool is_literal = false;
+
+				// 前回参照した変数
+				// 実行中のイベントと変数の構成が変わらない限り、探し直さない。
+				const std::wstring* event_name{};
+				uint64 generation = ~uint64{ 0 };
+				Value *local{}, *global{};
+				uint32 argument = ~uint32{ 0 };		// イベントの引数であれば、その位置(BindArgumentsで設定する)
+
+				// 添字付きの引数(配列[添字])であれば、配列と添字を読む為の引数の位置
+				// どちらもslotsの内、param_names以降に置かれる。
+				uint32 base = ~uint32{ 0 }, index = ~uint32{ 0 };
+			};
+			mutable std::vector<ParamSlot> slots{};
+
+			// 変数を探す時に用いる引数名
+			const std::wstring& SearchName(const size_t Index) const noexcept {
+				return (Index < param_names.size() ? param_names[Index] : slots[Index].var);
+			}
+
+			// 引数の変数を、イベントの引数・イベント内の変数・全体の変数の順に探す。
+			const Value& Search(const size_t Index) const noexcept {
+				auto& slot = slots[Index];
+				// 引数は呼出情報から直接読む。
+				if (slot.argument != ~uint32{ 0 }) {
+					if (const auto *const Argument = Program::Instance().event_manager.Argument(slot.argument); Argument != nullptr && !Argument->Is<std::nullptr_t>())
+						return *Argument;
+				}
+
+				auto& var_manager = Program::Instance().var_manager;
+				const auto& Event_Name = Program::Instance().event_manager.ExecutingEventName();
+				if (slot.event_name != &Event_Name || slot.generation != var_manager.Generation()) {
+					slot.global = &var_manager.Get<false>(SearchName(Index));
+					slot.local = &var_manager.Get<false>(Event_Name + L'.' + SearchName(Index));
+					slot.event_name = &Event_Name;
+					slot.generation = var_manager.Generation();
+				}
+
+				if (!slot.local->Is<std::nullptr_t>())
+					return *slot.local;
+				else
+					return *slot.global;
+			}
+
+			// 該当する引数が無い場合に返す値
+			inline static const Value null_value{};
+
+			// 添字付きの引数が指す配列の要素を返す。
+			// 配列でない、または添字が範囲外の場合はnullを返す。
+			const Value& SearchElement(const ParamSlot& Slot) const noexcept {
+				const auto& Array = Search(Slot.base);
+				const auto& Index = (slots[Slot.index].is_literal ? slots[Slot.index].literal : Search(Slot.index));
+				if (!Array.Is<Value::Elements>() || !Index.Is<int>())
+					return null_value;
+
+				const auto& Elements = Array.Get<Value::Elements>();
+				const int I = Index.Get<int>();
+				if (I < 0 || I >= static_cast<int>(Elements.size()))
+					return null_value;
+				return Elements[I];
+			}
 		protected:
 			inline static error::ErrorClass *command_error_class{};
 			inline static error::ErrorContent *incorrect_type_error{},
@@ -78,90 +413,139 @@ namespace karapo::event {
 
 			DynamicCommand() noexcept {
 				if (command_error_class == nullptr) [[unlikely]]
-					command_error_class = error::UserErrorHandler::MakeErrorClass(L"R}hG[");
+					command_error_class = error::UserErrorHandler::MakeErrorClass(L"コマンドエラー");
 				if (incorrect_type_error == nullptr) [[unlikely]]
-					incorrect_type_error = error::UserErrorHandler::MakeError(command_error_class, L"̌^sK؂łB", MB_OK | MB_ICONERROR, 1);
+					incorrect_type_error = error::UserErrorHandler::MakeError(command_error_class, L"引数の型が不適切です。", MB_OK | MB_ICONERROR, 1);
 				if (lack_of_parameters_error == nullptr) [[unlikely]]
-					lack_of_parameters_error = error::UserErrorHandler::MakeError(command_error_class, L"ȂׁAR}hsł܂B", MB_OK | MB_ICONERROR, 1);
+					lack_of_parameters_error = error::UserErrorHandler::MakeError(command_error_class, L"引数が足りない為、コマンドを実行できません。", MB_OK | MB_ICONERROR, 1);
 				if (empty_name_error == nullptr) [[unlikely]]
-					empty_name_error = error::UserErrorHandler::MakeError(command_error_class, L"Oɂ邱Ƃ͂ł܂B", MB_OK | MB_ICONERROR, 2);
+					empty_name_error = error::UserErrorHandler::MakeError(command_error_class, L"名前を空にすることはできません。", MB_OK | MB_ICONERROR, 2);
 				if (entity_not_found_error == nullptr) [[unlikely]]
-					entity_not_found_error = error::UserErrorHandler::MakeError(command_error_class, L"Entity܂B", MB_OK | MB_ICONERROR, 2);
+					entity_not_found_error = error::UserErrorHandler::MakeError(command_error_class, L"Entityが見つかりません。", MB_OK | MB_ICONERROR, 2);
 			}
 
 			DynamicCommand(const decltype(param_names)& Param) noexcept : DynamicCommand() {
 				param_names = Param;
+				slots.resize(param_names.size());
+				for (size_t i = 0; i < param_names.size(); i++) {
+					auto& slot = slots[i];
+					auto [var, type] = Default_ProgramInterface.GetParamInfo(param_names[i]);
+					if (Default_ProgramInterface.IsNumberType(type)) {
+						auto [iv, ip] = ToInt(var.c_str());
+						auto [fv, fp] = ToDec<Dec>(var.c_str());
+						if (wcslen(ip) <= 0)
+							slot.literal = iv;
+						else
+							slot.literal = fv;
+						slot.is_literal = true;
+					} else if (Default_ProgramInterface.IsStringType(type)) {
+						slot.literal = var;
+						slot.is_literal = true;
+					}
+					slot.var = std::move(var);
+				}
+
+				// 添字付きの引数は、配列名と添字を別の引数として加える。
+				for (size_t i = 0; i < param_names.size(); i++) {
+					if (slots[i].is_literal)
+						continue;
+
+					const std::wstring Var = slots[i].var;
+					const auto Open = Var.find(L'[');
+					if (Open == 0 || Open == Var.npos || Var.back() != L']')
+						continue;
+
+					ParamSlot base{}, index{};
+					base.var = Var.substr(0, Open);
+					index.var = Var.substr(Open + 1, Var.size() - Open - 2);
+					if (auto [iv, ip] = ToInt(index.var.c_str()); !index.var.empty() && wcslen(ip) <= 0) {
+						index.literal = iv;
+						index.is_literal = true;
+					}
+					slots[i].base = static_cast<uint32>(slots.size());
+					slots[i].index = static_cast<uint32>(slots.size() + 1);
+					slots.push_back(std::move(base));
+					slots.push_back(std::move(index));
+				}
 			}
 
-			// R}hsɓǂݍޕKv邩ۂB
+			// 引数をコマンド実行時に読み込む必要があるか否か。
 			bool MustSearch() const noexcept {
 				return !param_names.empty();
 			}
 
+			// 引数の数
+			int ParamCount() const noexcept {
+				return static_cast<int>(param_names.size());
+			}
+
+			// 引数の値を、写さずに変数や定数への参照として返す。
+			// 参照先の変数は書き換えられうる為、変数を書き換えた後も使う場合は写しておくこと。
+			// Get_Param_Nameが真の場合は、引数名を文字列の値として返す。
 			template<const bool Get_Param_Name = false>
-			std::any GetParam(const int Index) const noexcept {
+			std::conditional_t<Get_Param_Name, Value, const Value&> GetParam(const int Index) const noexcept(!Get_Param_Name) {
 				if (Index < 0 || Index >= param_names.size())
-					return nullptr;
+					return null_value;
 
-				auto [var, type] = Default_ProgramInterface.GetParamInfo(param_names[Index]);
+				auto& slot = slots[Index];
 				if constexpr (!Get_Param_Name) {
-					if (Default_ProgramInterface.IsNumberType(type)) {
-						auto [iv, ip] = ToInt(var.c_str());
-						auto [fv, fp] = ToDec<Dec>(var.c_str());
-						if (wcslen(ip) <= 0)
-							return iv;
-						else
-							return fv;
-					} else if (Default_ProgramInterface.IsStringType(type)) {
-						return var;
+					if (slot.is_literal) {
+						return slot.literal;
+					} else if (slot.base != ~uint32{ 0 }) {
+						return SearchElement(slot);
 					} else {
-						auto event_name = std::any_cast<std::wstring>(Program::Instance().var_manager.Get<false>(variable::Executing_Event_Name));
-						event_name = event_name.substr(0, event_name.size() - 1);
-						if (auto pos = event_name.rfind(L'\n'); pos != std::wstring::npos)
-							event_name = event_name.substr(pos);
-						if (auto pos = event_name.find(L'\n'); pos != std::wstring::npos)
-							event_name.erase(event_name.begin());
-
-						auto& global_var = Program::Instance().var_manager.Get<false>(param_names[Index]);
-						auto& local_var = Program::Instance().var_manager.Get<false>(event_name + L'.' + param_names[Index]);
-						if (local_var.type() != typeid(std::nullptr_t))
-							return local_var;
-						else
-							return global_var;	// 
+						return Search(Index);
 					}
 				} else {
-					if (Default_ProgramInterface.IsStringType(type) || Default_ProgramInterface.IsNumberType(type))
-						return var;
+					if (slot.is_literal)
+						return slot.var;
 					else
 						return param_names[Index];
 				}
 			}
 
-			void SetAllParams(std::vector<std::any>* to) {
-				for (int i = 0; i < param_names.size(); i++) {
-					auto value = GetParam(i);
-					if (value.type() == typeid(std::nullptr_t)) {
-						auto value_name = std::any_cast<std::wstring>(GetParam<true>(i));
-						auto [fv, fp] = ToDec<Dec>(value_name.c_str());
-						auto [iv, ip] = ToInt(value_name.c_str());
-
-						if (wcslen(ip) <= 0)
-							value = iv;
-						else if (wcslen(fp) <= 0)
-							value = fv;
-						else
-							value = value_name;
-					}
-					to->push_back(value);
+		public:
+			// 引数の内、イベントの引数名と一致するものを、その位置へ結び付ける。
+			// コマンドを含むイベントが命令列へ変換される時に呼ばれる。
+			void BindArguments(const std::vector<std::wstring>& Param_Names) noexcept {
+				for (size_t i = 0; i < slots.size(); i++) {
+					auto& slot = slots[i];
+					slot.argument = ~uint32{ 0 };
+					if (slot.is_literal)
+						continue;
+					if (auto it = std::find(Param_Names.begin(), Param_Names.end(), SearchName(i)); it != Param_Names.end())
+						slot.argument = static_cast<uint32>(it - Param_Names.begin());
 				}
 			}
+		protected:
+			// 値の引数を写して返す。
+			// 変数が無い場合は、引数名を数値または文字列として扱う。
+			Value Operand(const int Index) const {
+				if (const auto& Param = GetParam(Index); !Param.Is<std::nullptr_t>())
+					return Param;
+
+				auto text = GetParam<true>(Index).Get<std::wstring>();
+				auto [iv, ip] = ToInt(text.c_str());
+				auto [fv, fp] = ToDec<Dec>(text.c_str());
+				if (wcslen(ip) <= 0)
+					return iv;
+				else if (wcslen(fp) <= 0)
+					return fv;
+				else
+					return std::move(text);
+			}
+
+			void SetAllParams(std::vector<Value>* to) {
+				for (int i = 0; i < param_names.size(); i++)
+					to->push_back(Operand(i));
+			}
 		};
 
-		// ϐ
+		// 変数
 		DYNAMIC_COMMAND(Variable) {
 		protected:
 			std::wstring varname;
-			std::any value;
+			Value value;
 		public:
 			Variable(const std::wstring& VName, const std::wstring& Any_Value) noexcept : Variable(std::vector<std::wstring>{}) {
 				varname = VName;
@@ -191,15 +575,15 @@ namespace karapo::event {
 				if (MustSearch()) {
 					auto name = GetParam<true>(0);
 					auto any_value = GetParam<true>(1);
-					if (name.type() == typeid(std::nullptr_t))
+					if (name.Is<std::nullptr_t>())
 						goto noname_error;
-					else if (any_value.type() == typeid(std::nullptr_t))
+					else if (any_value.Is<std::nullptr_t>())
 						goto novalue_error;
 
-					varname = std::any_cast<std::wstring>(name);
+					varname = name.Get<std::wstring>();
 					value = GetParam(1);
-					if (value.type() == typeid(std::nullptr_t)) {
-						auto value_name = std::any_cast<std::wstring>(any_value);
+					if (value.Is<std::nullptr_t>()) {
+						auto value_name = any_value.Get<std::wstring>();
 						auto [fv, fp] = ToDec<Dec>(value_name.c_str());
 						auto [iv, ip] = ToInt(value_name.c_str());
 						if (wcslen(ip) <= 0)
@@ -214,11 +598,11 @@ namespace karapo::event {
 				}
 				return true;
 
-			// ϐĂȂꍇ̃G[(=0)B
+			// 変数名が書かれていない場合のエラー(=引数が0個)。
 			noname_error:
-			// lw肳ĂȂꍇ̃G[(=1)B 
+			// 初期値が指定されていない場合のエラー(=引数が1個)。 
 			novalue_error:
-				event::Manager::Instance().error_handler.SendLocalError(lack_of_parameters_error, L"R}h: var/ϐ");
+				event::Manager::Instance().error_handler.SendLocalError(lack_of_parameters_error, L"コマンド名: var/変数");
 				goto return_failed;
 			return_failed:
 				return false;
@@ -235,7 +619,7 @@ namespace karapo::event {
 			}
 		};
 
-		// O[oϐ
+		// グローバル変数
 		class Global final : public Variable {
 		public:
 			using Variable::Variable;
@@ -248,13 +632,13 @@ namespace karapo::event {
 			}
 		};
 		
-		// ϐ/֐/Entity̑݊mF
+		// 変数/関数/Entityの存在確認
 		DYNAMIC_COMMAND(Exist final) {
 			inline static error::ErrorContent *assign_error{};
 		public:
 			DYNAMIC_COMMAND_CONSTRUCTOR(Exist) {
 				if (assign_error == nullptr) [[unlikely]]
-					assign_error = error::UserErrorHandler::MakeError(event::Manager::Instance().error_class, L"̕ϐ݂܂B\nV̕ϐ쐬܂?", MB_YESNO | MB_ICONERROR, 2);
+					assign_error = error::UserErrorHandler::MakeError(event::Manager::Instance().error_class, L"代入先の変数が存在しません。\n新しくこの変数を作成しますか?", MB_YESNO | MB_ICONERROR, 2);
 			}
 
 			~Exist() noexcept final {}
@@ -262,30 +646,30 @@ namespace karapo::event {
 			void Execute() final {
 				std::wstring name[2]{ {}, {} };
 				for (int i = 0; i < 2; i++)
-					name[i] = std::any_cast<std::wstring>(GetParam<true>(i));
+					name[i] = GetParam<true>(i).Get<std::wstring>();
 
 				int result = 0;
-				if (Program::Instance().var_manager.Get<false>(name[0]).type() != typeid(std::nullptr_t)) {
-					result |= std::any_cast<int>(Program::Instance().var_manager.Get<false>(L"__ϐ"));
+				if (!Program::Instance().var_manager.Get<false>(name[0]).Is<std::nullptr_t>()) {
+					result |= Program::Instance().var_manager.Get<false>(L"__変数存在").Get<int>();
 				}
 				if (Program::Instance().event_manager.GetEvent(name[0]) != nullptr) {
-					result |= std::any_cast<int>(Program::Instance().var_manager.Get<false>(L"__Cxg"));
+					result |= Program::Instance().var_manager.Get<false>(L"__イベント存在").Get<int>();
 				}
 				if (Program::Instance().entity_manager.GetEntity(name[0]) != nullptr) {
-					result |= std::any_cast<int>(Program::Instance().var_manager.Get<false>(L"__L"));
+					result |= Program::Instance().var_manager.Get<false>(L"__キャラ存在").Get<int>();
 				}
 
 				auto *v = &Program::Instance().var_manager.Get<false>(name[1]);
-				if (v->type() != typeid(std::nullptr_t)) {
+				if (!v->Is<std::nullptr_t>()) {
 					*v = static_cast<int>(result);
 				} else {
-					event::Manager::Instance().error_handler.SendLocalError(assign_error, L"ϐ: " + name[1], [](const int Result) {
+					event::Manager::Instance().error_handler.SendLocalError(assign_error, L"変数: " + name[1], [](const int Result) {
 						switch (Result) {
 							case IDYES:
 							{
 								auto& var = Program::Instance().var_manager.Get<false>(L"__assignable");
 								auto& value = Program::Instance().var_manager.Get<false>(L"__calculated");
-								Program::Instance().var_manager.MakeNew(std::any_cast<std::wstring>(var)) = std::any_cast<int>(value);
+								Program::Instance().var_manager.MakeNew(var.Get<std::wstring>()) = value.Get<int>();
 								break;
 							}
 							case IDNO:
@@ -302,9 +686,9 @@ namespace karapo::event {
 			}
 		};
 
-		// Ώېݒ
+		// 条件対象設定
 		DYNAMIC_COMMAND(Case final) {
-			std::any value;
+			Value value;
 		public:
 			Case(const std::wstring& Param) noexcept : Case(std::vector<std::wstring>{}) {
 				const auto [Value, Type] = Default_ProgramInterface.GetParamInfo(Param);
@@ -319,51 +703,80 @@ namespace karapo::event {
 
 			~Case() noexcept final {}
 
+			// 条件対象が定数であれば、その値を返す。
+			const Value* Literal() const noexcept {
+				return (!MustSearch() ? &value : nullptr);
+			}
+
 			void Execute() override {
-				if (MustSearch()) {
-					value = GetParam(0);
-				}
-				Program::Instance().event_manager.NewCaseTarget(value);
+				Program::Instance().event_manager.NewCaseTarget(MustSearch() ? GetParam(0) : value);
 			}
 		};
 
-		// 
+		// 条件式
+		// 比較演算子は生成時に比較方法へ変換しておく。
+		// 定数との比較は、生成時に値の型と比較方法に合う条件式を選び、文字列のハッシュ値も求めておく。
 		DYNAMIC_COMMAND(Of final) {
-			std::wstring mode;
-			std::any value;
+			Comparison comparison = Comparison::Unknown;
+			Value value;
+			Predicate predicate = &AlwaysTrue;
+			size_t hash = 0;
+			// 比較する値が変数でも数値でもない場合に用いる文字列
+			FormatString text{};
 		public:
-			Of(const std::wstring& Condition_Sentence, const std::any& V) noexcept : Of(std::vector<std::wstring>{}) {
-				mode = Condition_Sentence;
+			Of(const std::wstring& Condition_Sentence, const Value& V) noexcept : Of(std::vector<std::wstring>{}) {
+				comparison = ToComparison(Condition_Sentence);
 				value = V;
+				predicate = SelectPredicate(comparison, value.GetType(), true);
+				if (value.Is<std::wstring>())
+					hash = std::hash<std::wstring>{}(value.Get<std::wstring>());
 			}
 
-			DYNAMIC_COMMAND_CONSTRUCTOR(Of) {}
+			DYNAMIC_COMMAND_CONSTRUCTOR(Of) {
+				if (MustSearch())
+					comparison = ToComparison(GetParam<true>(0).Get<std::wstring>());
+				if (ParamCount() >= 2)
+					text = GetParam<true>(1).Get<std::wstring>();
+			}
 
 			~Of() noexcept final {}
 
+			// 定数との一致判定であれば、その定数を返す。
+			const Value* EqualityLiteral() const noexcept {
+				return (!MustSearch() && comparison == Comparison::Equal ? &value : nullptr);
+			}
+
+			// 定数との比較であれば、その定数を返す。
+			const Value* Literal() const noexcept {
+				return (!MustSearch() ? &value : nullptr);
+			}
+
+			Comparison GetComparison() const noexcept {
+				return comparison;
+			}
+
 			void Execute() override {
 				if (MustSearch()) {
-					mode = std::any_cast<std::wstring>(GetParam<true>(0));
-					auto vname = std::any_cast<std::wstring>(GetParam<true>(1));
-					value = Program::Instance().var_manager.Get<false>(vname);
-					if (value.type() == typeid(std::nullptr_t)) {
-						auto [iv, ip] = ToInt(vname.c_str());
-						auto [fv, fp] = ToDec<Dec>(vname.c_str());
+					const auto& Var_Name = text.Source();
+					value = Program::Instance().var_manager.Get<false>(Var_Name);
+					if (value.Is<std::nullptr_t>()) {
+						auto [iv, ip] = ToInt(Var_Name.c_str());
+						auto [fv, fp] = ToDec<Dec>(Var_Name.c_str());
 						if (wcslen(ip) <= 0)
 							value = iv;
 						else if (wcslen(fp) <= 0)
 							value = fv;
-						else {
-							ReplaceFormat(&vname);
-							value = vname;
-						}
+						else
+							value = text.Render();
 					}
+					predicate = SelectPredicate(comparison, value.GetType(), false);
 				}
-				Program::Instance().var_manager.Get<false>(L"of_state") = (int)Program::Instance().event_manager.Evalute(mode, value);
+				auto& event_manager = Program::Instance().event_manager;
+				event_manager.OfState() = (int)event_manager.Evalute(predicate, value, hash);
 			}
 		};
 
-		// (SĊYȂ̏ꍇ)
+		// 条件式(全て該当なしの場合)
 		DYNAMIC_COMMAND(Else final) {
 		public:
 			Else() noexcept : Else(std::vector<std::wstring>{}) {}
@@ -373,11 +786,12 @@ namespace karapo::event {
 			~Else() noexcept final {}
 
 			void Execute() override {
-				Program::Instance().var_manager.Get<false>(L"of_state") = (int)!std::any_cast<int>(Program::Instance().var_manager.Get<false>(L"of_state"));
+				auto& of_state = Program::Instance().event_manager.OfState();
+				of_state = (int)!of_state.Get<int>();
 			}
 		};
 
-		// I
+		// 条件終了
 		DYNAMIC_COMMAND(EndCase final) {
 		public:
 			EndCase() noexcept : EndCase(std::vector<std::wstring>{}) {}
@@ -390,7 +804,7 @@ namespace karapo::event {
 			}
 		};
 
-		// 摜ǂݍ݁A\B
+		// 画像を読み込み、表示させる。
 		DYNAMIC_COMMAND(Image) {
 			std::shared_ptr<karapo::entity::Image> image;
 			std::wstring path;
@@ -408,35 +822,35 @@ namespace karapo::event {
 
 			void Execute() override {
 				if (MustSearch()) {
-					auto path_param = GetParam(0),
+					const auto& path_param = GetParam(0),
 						x_param = GetParam(1),
 						y_param = GetParam(2),
 						w_param = GetParam(3),
 						h_param = GetParam(4);
 
-					if (path_param.type() == typeid(std::nullptr_t) ||
-						x_param.type() == typeid(std::nullptr_t) ||
-						y_param.type() == typeid(std::nullptr_t) ||
-						w_param.type() == typeid(std::nullptr_t) ||
-						h_param.type() == typeid(std::nullptr_t)) [[unlikely]]
+					if (path_param.Is<std::nullptr_t>() ||
+						x_param.Is<std::nullptr_t>() ||
+						y_param.Is<std::nullptr_t>() ||
+						w_param.Is<std::nullptr_t>() ||
+						h_param.Is<std::nullptr_t>()) [[unlikely]]
 					{
 						goto lack_error;
 					} 
-					else if (path_param.type() != typeid(std::wstring) ||
-						(x_param.type() != typeid(int) && x_param.type() != typeid(Dec)) ||
-						(y_param.type() != typeid(int) && y_param.type() != typeid(Dec)) ||
-						(w_param.type() != typeid(int) && w_param.type() != typeid(Dec)) ||
-						(h_param.type() != typeid(int) && h_param.type() != typeid(Dec))) [[unlikely]]
+					else if (!path_param.Is<std::wstring>() ||
+						(!x_param.Is<int>() && !x_param.Is<Dec>()) ||
+						(!y_param.Is<int>() && !y_param.Is<Dec>()) ||
+						(!w_param.Is<int>() && !w_param.Is<Dec>()) ||
+						(!h_param.Is<int>() && !h_param.Is<Dec>())) [[unlikely]]
 					{
 						goto type_error;
 					}
 
 
-					path = std::any_cast<std::wstring>(path_param);
-					Dec x = (x_param.type() == typeid(Dec) ? std::any_cast<Dec>(x_param) : std::any_cast<int>(x_param)),
-						y = (y_param.type() == typeid(Dec) ? std::any_cast<Dec>(y_param) : std::any_cast<int>(y_param)),
-						w = (w_param.type() == typeid(Dec) ? std::any_cast<Dec>(w_param) : std::any_cast<int>(w_param)),
-						h = (h_param.type() == typeid(Dec) ? std::any_cast<Dec>(h_param) : std::any_cast<int>(h_param));
+					path = path_param.Get<std::wstring>();
+					Dec x = (x_param.Is<Dec>() ? x_param.Get<Dec>() : x_param.Get<int>()),
+						y = (y_param.Is<Dec>() ? y_param.Get<Dec>() : y_param.Get<int>()),
+						w = (w_param.Is<Dec>() ? w_param.Get<Dec>() : w_param.Get<int>()),
+						h = (h_param.Is<Dec>() ? h_param.Get<Dec>() : h_param.Get<int>());
 					image = std::make_shared<karapo::entity::Image>(WorldVector{ x, y }, WorldVector{ w, h });
 				}
 				image->Load(path.c_str());
@@ -444,17 +858,17 @@ namespace karapo::event {
 				return;
 
 			lack_error:
-				event::Manager::Instance().error_handler.SendLocalError(lack_of_parameters_error, L"R}h: image/摜");
+				event::Manager::Instance().error_handler.SendLocalError(lack_of_parameters_error, L"コマンド名: image/画像");
 				goto end_of_function;
 			type_error:
-				event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"R}h: image/摜");
+				event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"コマンド名: image/画像");
 				goto end_of_function;
 			end_of_function:
 				return;
 			}
 		};
 
-		// Aj[Vpϐ쐬B
+		// アニメーション用変数を作成する。
 		DYNAMIC_COMMAND(Animation final) {
 			std::wstring var_name{};
 		public:
@@ -471,11 +885,11 @@ namespace karapo::event {
 				Program::Instance().var_manager.MakeNew(var_name + L".frame") = animation::FrameRef();
 				return;
 			name_error:
-				event::Manager::Instance().error_handler.SendLocalError(empty_name_error, L"R}h: animation/Aj");
+				event::Manager::Instance().error_handler.SendLocalError(empty_name_error, L"コマンド名: animation/アニメ");
 			}
 		};
 
-		// Aj[VϐɃt[ǉB
+		// アニメーション変数にフレームを追加する。
 		DYNAMIC_COMMAND(AddFrame final) {
 			std::wstring var_name{}, image_path{};
 		public:
@@ -492,25 +906,25 @@ namespace karapo::event {
 				if (MustSearch()) {
 					auto var_name_param = GetParam<true>(0),
 						path_param = GetParam(1);
-					if (var_name_param.type() == typeid(std::nullptr_t) || path_param.type() == typeid(std::nullptr_t)) [[unlikely]]
+					if (var_name_param.Is<std::nullptr_t>() || path_param.Is<std::nullptr_t>()) [[unlikely]]
 						goto lack_error;
-					else if (var_name_param.type() != typeid(std::wstring) || path_param.type() != typeid(std::wstring)) [[unlikely]]
+					else if (!var_name_param.Is<std::wstring>() || !path_param.Is<std::wstring>()) [[unlikely]]
 						goto type_error;
 
-					var_name = std::any_cast<std::wstring>(var_name_param);
-					image_path = std::any_cast<std::wstring>(path_param);
+					var_name = var_name_param.Get<std::wstring>();
+					image_path = path_param.Get<std::wstring>();
 				}
 
 				if (var_name.empty() || image_path.empty())
 					goto name_error;
 				else {
 					auto& anime_var = Program::Instance().var_manager.Get<false>(var_name);
-					if (anime_var.type() != typeid(animation::Animation))
+					if (!anime_var.Is<animation::Animation>())
 						goto type_error;
 					else {
-						auto& anime = std::any_cast<animation::Animation&>(anime_var);
+						auto& anime = anime_var.Get<animation::Animation>();
 						auto& frame_var = Program::Instance().var_manager.Get<false>(var_name + L".frame");
-						auto& frame = std::any_cast<animation::FrameRef&>(frame_var);
+						auto& frame = frame_var.Get<animation::FrameRef>();
 
 						resource::Image image;
 						image = Program::Instance().engine.LoadImage(image_path);
@@ -520,20 +934,20 @@ namespace karapo::event {
 				}
 				return;
 			lack_error:
-				event::Manager::Instance().error_handler.SendLocalError(lack_of_parameters_error, L"R}h: addframe/t[ǉ");
+				event::Manager::Instance().error_handler.SendLocalError(lack_of_parameters_error, L"コマンド名: addframe/フレーム追加");
 				goto end_of_function;
 			type_error:
-				event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"R}h: addframe/t[ǉ");
+				event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"コマンド名: addframe/フレーム追加");
 				goto end_of_function;
 			name_error:
-				event::Manager::Instance().error_handler.SendLocalError(empty_name_error, L"R}h: addframe/t[ǉ");
+				event::Manager::Instance().error_handler.SendLocalError(empty_name_error, L"コマンド名: addframe/フレーム追加");
 				goto end_of_function;
 			end_of_function:
 				return;
 			}
 		};
 
-		// t[ɐi߂B
+		// フレームを次に進める。
 		DYNAMIC_COMMAND(NextFrame final) {
 			std::wstring var_name{};
 		public:
@@ -548,24 +962,24 @@ namespace karapo::event {
 					goto name_error;
 				else {
 					auto& frame_var = Program::Instance().var_manager.Get<false>(var_name + L".frame");
-					if (frame_var.type() != typeid(animation::FrameRef))
+					if (!frame_var.Is<animation::FrameRef>())
 						goto type_error;
 					else {
-						std::any_cast<animation::FrameRef&>(frame_var)++;
-						auto frame = std::any_cast<animation::FrameRef&>(frame_var);
+						frame_var.Get<animation::FrameRef>()++;
+						auto frame = frame_var.Get<animation::FrameRef>();
 					}
 				}
 				return;
 			name_error:
-				event::Manager::Instance().error_handler.SendLocalError(empty_name_error, L"R}h: nextframe/t[");
+				event::Manager::Instance().error_handler.SendLocalError(empty_name_error, L"コマンド名: nextframe/次フレーム");
 				return;
 			type_error:
-				event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"R}h: nextframe/t[");
+				event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"コマンド名: nextframe/次フレーム");
 				return;
 			}
 		};
 
-		// t[Oɖ߂B
+		// フレームを前に戻す。
 		DYNAMIC_COMMAND(BackFrame final) {
 			std::wstring var_name{};
 		public:
@@ -580,23 +994,23 @@ namespace karapo::event {
 					goto name_error;
 				else {
 					auto& frame_var = Program::Instance().var_manager.Get<false>(var_name + L".frame");
-					if (frame_var.type() != typeid(animation::FrameRef))
+					if (!frame_var.Is<animation::FrameRef>())
 						goto type_error;
 					else {
-						std::any_cast<animation::FrameRef&>(frame_var)--;
+						frame_var.Get<animation::FrameRef>()--;
 					}
 				}
 				return;
 			name_error:
-				event::Manager::Instance().error_handler.SendLocalError(empty_name_error, L"R}h: backframe/Ot[");
+				event::Manager::Instance().error_handler.SendLocalError(empty_name_error, L"コマンド名: backframe/前フレーム");
 				return;
 			type_error:
-				event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"R}h: backframe/Ot[");
+				event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"コマンド名: backframe/前フレーム");
 				return;
 			}
 		};
 
-		// 摜ꕔRs[B
+		// 画像から一部をコピーする。
 		DYNAMIC_COMMAND(Capture) {
 			std::wstring variable_name{}, path{};
 			ScreenVector position{}, length{};
@@ -622,42 +1036,41 @@ namespace karapo::event {
 						w_param = GetParam(4),
 						h_param = GetParam(5);
 
-					path_param.has_value();
-					if (var_name.type() == typeid(std::nullptr_t) ||
-						path_param.type() == typeid(std::nullptr_t) ||
-						x_param.type() == typeid(std::nullptr_t) ||
-						y_param.type() == typeid(std::nullptr_t) ||
-						w_param.type() == typeid(std::nullptr_t) ||
-						h_param.type() == typeid(std::nullptr_t)) [[unlikely]]
+					if (var_name.Is<std::nullptr_t>() ||
+						path_param.Is<std::nullptr_t>() ||
+						x_param.Is<std::nullptr_t>() ||
+						y_param.Is<std::nullptr_t>() ||
+						w_param.Is<std::nullptr_t>() ||
+						h_param.Is<std::nullptr_t>()) [[unlikely]]
 					{
 						goto lack_error;
 					}
-					else if (var_name.type() != typeid(std::wstring) ||
-						path_param.type() != typeid(std::wstring) ||
-						x_param.type() != typeid(int) ||
-						y_param.type() != typeid(int) ||
-						w_param.type() != typeid(int) ||
-						h_param.type() != typeid(int)) [[unlikely]]
+					else if (!var_name.Is<std::wstring>() ||
+						!path_param.Is<std::wstring>() ||
+						!x_param.Is<int>() ||
+						!y_param.Is<int>() ||
+						!w_param.Is<int>() ||
+						!h_param.Is<int>()) [[unlikely]]
 					{
 						goto type_error;
 					}
 
-					variable_name = std::any_cast<std::wstring>(var_name);
-					path = std::any_cast<std::wstring>(path_param);
-					position[0] = std::any_cast<int>(x_param);
-					position[1] = std::any_cast<int>(y_param);
-					length[0] = std::any_cast<int>(w_param);
-					length[1] = std::any_cast<int>(h_param);
+					variable_name = var_name.Get<std::wstring>();
+					path = path_param.Get<std::wstring>();
+					position[0] = x_param.Get<int>();
+					position[1] = y_param.Get<int>();
+					length[0] = w_param.Get<int>();
+					length[1] = h_param.Get<int>();
 				}
 				Program::Instance().engine.CopyImage(&path, position, length);
 				Program::Instance().var_manager.Get<false>(variable_name) = path;
 				return;
 
 			lack_error:
-				event::Manager::Instance().error_handler.SendLocalError(lack_of_parameters_error, L"R}h: capture/摜؎");
+				event::Manager::Instance().error_handler.SendLocalError(lack_of_parameters_error, L"コマンド名: capture/画像切取");
 				goto end_of_function;
 			type_error:
-				event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"R}h: capture/摜؎");
+				event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"コマンド名: capture/画像切取");
 				goto end_of_function;
 			end_of_function:
 				return;
@@ -667,7 +1080,7 @@ namespace karapo::event {
 		// BGM
 		DYNAMIC_COMMAND(Music) {
 			std::shared_ptr<karapo::entity::Sound> music;
-			std::wstring path;
+			FormatString path;
 		public:
 			Music(const std::wstring & P) : Music(std::vector<std::wstring>{}) {
 				path = P;
@@ -681,34 +1094,33 @@ namespace karapo::event {
 
 			void Execute() override {
 				if (MustSearch()) {
-					auto path_param = GetParam(0);
-					if (path_param.type() == typeid(std::nullptr_t)) [[unlikely]]
+					const auto& path_param = GetParam(0);
+					if (path_param.Is<std::nullptr_t>()) [[unlikely]]
 						goto lack_error;
-					else if (path_param.type() != typeid(std::wstring)) [[unlikely]]
+					else if (!path_param.Is<std::wstring>()) [[unlikely]]
 						goto type_error;
 					
-					path = std::any_cast<std::wstring>(GetParam(0));
+					path = GetParam(0).Get<std::wstring>();
 				}
-				ReplaceFormat(&path);
-				music->Load(path);
+				music->Load(path.Render());
 				Program::Instance().entity_manager.Register(music);
 				return;
 
 			lack_error:
-				event::Manager::Instance().error_handler.SendLocalError(lack_of_parameters_error, L"R}h: music/BGM/y");
+				event::Manager::Instance().error_handler.SendLocalError(lack_of_parameters_error, L"コマンド名: music/BGM/音楽");
 				goto end_of_function;
 			type_error:
-				event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"R}h: music/BGM/y");
+				event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"コマンド名: music/BGM/音楽");
 				goto end_of_function;
 			end_of_function:
 				return;
 			}
 		};
 
-		// ʉ
+		// 効果音
 		DYNAMIC_COMMAND(Sound) {
 			std::shared_ptr<karapo::entity::Sound> sound;
-			std::wstring path;
+			FormatString path;
 		public:
 			Sound(const std::wstring& P, const WorldVector& WV) : Sound(std::vector<std::wstring>{}) {
 				path = P;
@@ -721,46 +1133,45 @@ namespace karapo::event {
 
 			void Execute() override {
 				if (MustSearch()) {
-					auto path_param = GetParam(0),
+					const auto& path_param = GetParam(0),
 						x_param = GetParam(1),
 						y_param = GetParam(2);
-					if (path_param.type() == typeid(std::nullptr_t) ||
-						x_param.type() == typeid(std::nullptr_t) ||
-						y_param.type() == typeid(std::nullptr_t)) [[unlikely]]
+					if (path_param.Is<std::nullptr_t>() ||
+						x_param.Is<std::nullptr_t>() ||
+						y_param.Is<std::nullptr_t>()) [[unlikely]]
 					{
 						goto lack_error;
 					}
-					else if (path_param.type() != typeid(std::wstring) ||
-						(x_param.type() != typeid(int) && x_param.type() != typeid(Dec)) ||
-						(y_param.type() != typeid(int) && y_param.type() != typeid(Dec))) [[unlikely]]
+					else if (!path_param.Is<std::wstring>() ||
+						(!x_param.Is<int>() && !x_param.Is<Dec>()) ||
+						(!y_param.Is<int>() && !y_param.Is<Dec>())) [[unlikely]]
 					{
 						goto type_error;
 					}
 
-					path = std::any_cast<std::wstring>(GetParam(0));
-					Dec x = (GetParam(1).type() == typeid(Dec) ? std::any_cast<Dec>(GetParam(1)) : std::any_cast<int>(GetParam(1))),
-						y = (GetParam(2).type() == typeid(Dec) ? std::any_cast<Dec>(GetParam(2)) : std::any_cast<int>(GetParam(2)));
+					path = GetParam(0).Get<std::wstring>();
+					Dec x = (GetParam(1).Is<Dec>() ? GetParam(1).Get<Dec>() : GetParam(1).Get<int>()),
+						y = (GetParam(2).Is<Dec>() ? GetParam(2).Get<Dec>() : GetParam(2).Get<int>());
 					sound = std::make_shared<karapo::entity::Sound>(WorldVector{ x, y });
 				}
-				ReplaceFormat(&path);
-				sound->Load(path);
+				sound->Load(path.Render());
 				Program::Instance().entity_manager.Register(sound);
 				return;
 			lack_error:
-				event::Manager::Instance().error_handler.SendLocalError(lack_of_parameters_error, L"R}h: Sound/ʉ");
+				event::Manager::Instance().error_handler.SendLocalError(lack_of_parameters_error, L"コマンド名: Sound/効果音");
 				goto end_of_function;
 			type_error:
-				event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"R}h: Sound/ʉ");
+				event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"コマンド名: Sound/効果音");
 				goto end_of_function;
 			end_of_function:
 				return;
 			}
 		};
 
-		// {^
+		// ボタン
 		DYNAMIC_COMMAND(Button final) {
 			std::shared_ptr<karapo::entity::Button> button;
-			std::any path{};
+			Value path{};
 		public:
 			Button(const std::wstring& Name,
 				const WorldVector& WV,
@@ -779,66 +1190,64 @@ namespace karapo::event {
 
 			void Execute() final {
 				if (MustSearch()) {
-					auto name_param = GetParam(0),
+					const auto& name_param = GetParam(0),
 						x_param = GetParam(1),
 						y_param = GetParam(2);
-					if (name_param.type() == typeid(std::nullptr_t) ||
-						x_param.type() == typeid(std::nullptr_t) ||
-						y_param.type() == typeid(std::nullptr_t)) [[unlikely]]
+					if (name_param.Is<std::nullptr_t>() ||
+						x_param.Is<std::nullptr_t>() ||
+						y_param.Is<std::nullptr_t>()) [[unlikely]]
 					{
 						goto lack_error;
 					} 
-					else if (name_param.type() != typeid(std::wstring) ||
-						(x_param.type() != typeid(Dec) && x_param.type() != typeid(int)) ||
-						(y_param.type() != typeid(Dec) && y_param.type() != typeid(int))) [[unlikely]]
+					else if (!name_param.Is<std::wstring>() ||
+						(!x_param.Is<Dec>() && !x_param.Is<int>()) ||
+						(!y_param.Is<Dec>() && !y_param.Is<int>())) [[unlikely]]
 					{
 						goto type_error;
 					}
 
-					auto name = std::any_cast<std::wstring>(name_param);
-					Dec x = (GetParam(1).type() == typeid(Dec) ? std::any_cast<Dec>(x_param) : std::any_cast<int>(x_param)),
-						y = (GetParam(2).type() == typeid(Dec) ? std::any_cast<Dec>(y_param) : std::any_cast<int>(y_param));
+					auto name = name_param.Get<std::wstring>();
+					Dec x = (GetParam(1).Is<Dec>() ? x_param.Get<Dec>() : x_param.Get<int>()),
+						y = (GetParam(2).Is<Dec>() ? y_param.Get<Dec>() : y_param.Get<int>());
 
-					auto w_param = GetParam(3),
+					const auto& w_param = GetParam(3),
 						h_param = GetParam(4),
 						path_param = GetParam(5);
 					Dec w{}, h{};
-					if (w_param.type() != typeid(std::nullptr_t) && h_param.type() != typeid(std::nullptr_t) && path_param.type() != typeid(std::nullptr_t)) {
-						w = (GetParam(3).type() == typeid(Dec) ? std::any_cast<Dec>(w_param) : std::any_cast<int>(w_param));
-						h = (GetParam(4).type() == typeid(Dec) ? std::any_cast<Dec>(h_param) : std::any_cast<int>(h_param));
+					if (!w_param.Is<std::nullptr_t>() && !h_param.Is<std::nullptr_t>() && !path_param.Is<std::nullptr_t>()) {
+						w = (GetParam(3).Is<Dec>() ? w_param.Get<Dec>() : w_param.Get<int>());
+						h = (GetParam(4).Is<Dec>() ? h_param.Get<Dec>() : h_param.Get<int>());
 						path = std::move(path_param);
 					}
 					ReplaceFormat(&name);
 					button = std::make_shared<karapo::entity::Button>(name, WorldVector{ x, y }, WorldVector{ w, h });
 				}
 
-				if (path.type() == typeid(std::wstring)) {
-					auto path_string = std::any_cast<std::wstring>(path);
+				if (path.Is<std::wstring>()) {
+					auto path_string = path.Get<std::wstring>();
 					ReplaceFormat(&path_string);
 					button->Load(path_string);
-				} else if (path.type() == typeid(animation::FrameRef)) {
-					button->Load(&std::any_cast<animation::FrameRef&>(
-							Program::Instance().var_manager.Get<false>(
-								std::any_cast<std::wstring>(GetParam<true>(5))
-							)
-						)
+				} else if (path.Is<animation::FrameRef>()) {
+					button->Load(&(Program::Instance().var_manager.Get<false>(
+								GetParam<true>(5).Get<std::wstring>()
+							)).Get<animation::FrameRef>()
 					);
 				}
 
 				Program::Instance().entity_manager.Register(button);
 				return;
 			lack_error:
-				event::Manager::Instance().error_handler.SendLocalError(lack_of_parameters_error, L"R}h: Button/{^");
+				event::Manager::Instance().error_handler.SendLocalError(lack_of_parameters_error, L"コマンド名: Button/ボタン");
 				goto end_of_function;
 			type_error:
-				event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"R}h: Button/{^");
+				event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"コマンド名: Button/ボタン");
 				goto end_of_function;
 			end_of_function:
 				return;
 			}
 		};
 
-		// o
+		// 文字出力
 		DYNAMIC_COMMAND(Print final) {
 			std::shared_ptr<karapo::entity::Text> text;
 		public:
@@ -856,24 +1265,24 @@ namespace karapo::event {
 
 			void Execute() final {
 				if (MustSearch()) {
-					auto name_param = GetParam(0),
+					const auto& name_param = GetParam(0),
 						x_param = GetParam(1),
 						y_param = GetParam(2);
-					if (name_param.type() == typeid(std::nullptr_t) ||
-						x_param.type() == typeid(std::nullptr_t) ||
-						y_param.type() == typeid(std::nullptr_t)) [[unlikely]]
+					if (name_param.Is<std::nullptr_t>() ||
+						x_param.Is<std::nullptr_t>() ||
+						y_param.Is<std::nullptr_t>()) [[unlikely]]
 					{
 						goto lack_error;
 					}
-					else if (name_param.type() != typeid(std::wstring) ||
-						(x_param.type() != typeid(Dec) && x_param.type() != typeid(int)) ||
-						(y_param.type() != typeid(Dec) && y_param.type() != typeid(int))) [[unlikely]]
+					else if (!name_param.Is<std::wstring>() ||
+						(!x_param.Is<Dec>() && !x_param.Is<int>()) ||
+						(!y_param.Is<Dec>() && !y_param.Is<int>())) [[unlikely]]
 					{
 						goto type_error;
 					}
-					auto name = std::any_cast<std::wstring>(name_param);
-					Dec x = (x_param.type() == typeid(Dec) ? std::any_cast<Dec>(x_param) : std::any_cast<int>(x_param)),
-						y = (y_param.type() == typeid(Dec) ? std::any_cast<Dec>(y_param) : std::any_cast<int>(y_param));
+					auto name = name_param.Get<std::wstring>();
+					Dec x = (x_param.Is<Dec>() ? x_param.Get<Dec>() : x_param.Get<int>()),
+						y = (y_param.Is<Dec>() ? y_param.Get<Dec>() : y_param.Get<int>());
 					ReplaceFormat(&name);
 
 					Program::Instance().var_manager.MakeNew(name + L".text") = std::wstring(L"");
@@ -882,21 +1291,21 @@ namespace karapo::event {
 				Program::Instance().entity_manager.Register(text);
 				return;
 			lack_error:
-				event::Manager::Instance().error_handler.SendLocalError(lack_of_parameters_error, L"R}h: text/");
+				event::Manager::Instance().error_handler.SendLocalError(lack_of_parameters_error, L"コマンド名: text/文章");
 				goto end_of_function;
 			type_error:
-				event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"R}h: text/");
+				event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"コマンド名: text/文章");
 				goto end_of_function;
 			end_of_function:
 				return;
 			}
 		};
 
-		// 
+		// 文字入力
 		DYNAMIC_COMMAND(Input final) {
 			size_t length = 10000;
 			ScreenVector pos{ 0, 0 };
-			std::any *var{};
+			Value *var{};
 		public:
 			DYNAMIC_COMMAND_CONSTRUCTOR(Input) {}
 
@@ -908,34 +1317,34 @@ namespace karapo::event {
 						x_param = GetParam(1),
 						y_param = GetParam(2),
 						len_param = GetParam(3);
-					if (name_param.type() == typeid(std::nullptr_t) ||
-						x_param.type() == typeid(std::nullptr_t) ||
-						y_param.type() == typeid(std::nullptr_t) ||
-						len_param.type() == typeid(std::nullptr_t)) [[unlikely]]
+					if (name_param.Is<std::nullptr_t>() ||
+						x_param.Is<std::nullptr_t>() ||
+						y_param.Is<std::nullptr_t>() ||
+						len_param.Is<std::nullptr_t>()) [[unlikely]]
 					{
 						goto lack_error;
 					} 
-					else if (name_param.type() != typeid(std::wstring) ||
-						x_param.type() != typeid(int) ||
-						y_param.type() != typeid(int) ||
-						len_param.type() != typeid(int)) [[unlikely]]
+					else if (!name_param.Is<std::wstring>() ||
+						!x_param.Is<int>() ||
+						!y_param.Is<int>() ||
+						!len_param.Is<int>()) [[unlikely]]
 					{
 						goto type_error;
 					}
-					var = &Program::Instance().var_manager.Get<false>(std::any_cast<std::wstring>(name_param));
-					pos[0] = std::any_cast<int>(x_param);
-					pos[1] = std::any_cast<int>(y_param);
-					length = std::any_cast<int>(len_param);
+					var = &Program::Instance().var_manager.Get<false>(name_param.Get<std::wstring>());
+					pos[0] = x_param.Get<int>();
+					pos[1] = y_param.Get<int>();
+					length = len_param.Get<int>();
 				}
 				wchar_t str[10000];
 				Program::Instance().engine.GetString(pos, str, length);
 				*var = std::wstring(str);
 				return;
 			lack_error:
-				event::Manager::Instance().error_handler.SendLocalError(lack_of_parameters_error, L"R}h: input/");
+				event::Manager::Instance().error_handler.SendLocalError(lack_of_parameters_error, L"コマンド名: input/入力");
 				goto end_of_function;
 			type_error:
-				event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"R}h: input/");
+				event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"コマンド名: input/入力");
 				goto end_of_function;
 			end_of_function:
 				return;
@@ -943,9 +1352,9 @@ namespace karapo::event {
 		};
 
 		namespace entity {
-			// Entitÿړ
+			// Entityの移動
 			DYNAMIC_COMMAND(Teleport final) {
-				std::wstring entity_name;
+				FormatString entity_name;
 				WorldVector move;
 			public:
 				Teleport(const std::wstring& ename, const WorldVector& MV) noexcept : Teleport(std::vector<std::wstring>{}) {
@@ -959,40 +1368,39 @@ namespace karapo::event {
 
 				void Execute() override {
 					if (MustSearch()) {
-						auto name_param = GetParam(0),
+						const auto& name_param = GetParam(0),
 							x_param = GetParam(1),
 							y_param = GetParam(2);
-						if (name_param.type() == typeid(std::nullptr_t) ||
-							x_param.type() == typeid(std::nullptr_t) ||
-							y_param.type() == typeid(std::nullptr_t)) [[unlikely]]
+						if (name_param.Is<std::nullptr_t>() ||
+							x_param.Is<std::nullptr_t>() ||
+							y_param.Is<std::nullptr_t>()) [[unlikely]]
 						{
 							goto lack_error;
 						} 
-						else if (name_param.type() != typeid(std::wstring)) [[unlikely]]
+						else if (!name_param.Is<std::wstring>()) [[unlikely]]
 						{
 							goto type_error;
 						}
-						entity_name = std::any_cast<std::wstring>(name_param);
+						entity_name = name_param.Get<std::wstring>();
 						Dec x{}, y{};
-						if (x_param.type() == typeid(Dec))
-							x = std::any_cast<Dec>(x_param);
-						else if (x_param.type() == typeid(int))
-							x = std::any_cast<int>(x_param);
+						if (x_param.Is<Dec>())
+							x = x_param.Get<Dec>();
+						else if (x_param.Is<int>())
+							x = x_param.Get<int>();
 						else [[unlikely]]
 							goto type_error;
 
-						if (y_param.type() == typeid(Dec))
-							y = std::any_cast<Dec>(y_param);
-						else if (y_param.type() == typeid(int))
-							y = std::any_cast<int>(y_param);
+						if (y_param.Is<Dec>())
+							y = y_param.Get<Dec>();
+						else if (y_param.Is<int>())
+							y = y_param.Get<int>();
 						else [[unlikely]]
 							goto type_error;
 						move = { x, y };
 					}
 
 					{
-						ReplaceFormat(&entity_name);
-						auto ent = Program::Instance().entity_manager.GetEntity(entity_name);
+						auto ent = Program::Instance().entity_manager.GetEntity(entity_name.Render());
 						if (ent != nullptr)
 							ent->Teleport(move);
 						else
@@ -1001,22 +1409,22 @@ namespace karapo::event {
 					}
 					return;
 				entity_error:
-					event::Manager::Instance().error_handler.SendLocalError(entity_not_found_error, L"R}h: teleport/uԈړ");
+					event::Manager::Instance().error_handler.SendLocalError(entity_not_found_error, L"コマンド名: teleport/瞬間移動");
 					goto end_of_function;
 				lack_error:
-					event::Manager::Instance().error_handler.SendLocalError(lack_of_parameters_error, L"R}h: teleport/uԈړ");
+					event::Manager::Instance().error_handler.SendLocalError(lack_of_parameters_error, L"コマンド名: teleport/瞬間移動");
 					goto end_of_function;
 				type_error:
-					event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"R}h: teleport/uԈړ");
+					event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"コマンド名: teleport/瞬間移動");
 					goto end_of_function;
 				end_of_function:
 					return;
 				}
 			};
 
-			// Entity̍폜B
+			// Entityの削除。
 			DYNAMIC_COMMAND(Kill final) {
-				std::wstring entity_name{};
+				FormatString entity_name{};
 			public:
 				Kill(const std::wstring & ename) noexcept : Kill(std::vector<std::wstring>{}) {
 					entity_name = ename;
@@ -1028,57 +1436,51 @@ namespace karapo::event {
 
 				void Execute() override {
 					if (MustSearch()) {
-						auto name_param = GetParam(0);
-						if (name_param.type() == typeid(std::nullptr_t)) [[unlikely]]
+						const auto& name_param = GetParam(0);
+						if (name_param.Is<std::nullptr_t>()) [[unlikely]]
 							goto lack_error;
-						else if (name_param.type() != typeid(std::wstring)) [[unlikely]]
+						else if (!name_param.Is<std::wstring>()) [[unlikely]]
 							goto type_error;
 
-						entity_name = std::any_cast<std::wstring>(name_param);
+						entity_name = name_param.Get<std::wstring>();
 					}
-					if (entity_name.empty())
+					if (entity_name.IsEmpty())
 						goto name_error;
 
-					ReplaceFormat(&entity_name);
-					if (entity_name == L"__all" || entity_name == L"__S") {
+					if (const auto& Entity_Name = entity_name.Render(); Entity_Name == L"__all" || Entity_Name == L"__全員") {
+						// 削除する度に管理中のEntityの配列が縮む為、名前を写してから削除する。
 						std::vector<std::wstring> names{};
-						auto sen = std::any_cast<std::wstring>(Program::Instance().var_manager.Get<false>(variable::Managing_Entity_Name));
-						{
-							std::wstring temp{};
-							for (auto ch : sen) {
-								if (ch != L'\n') {
-									temp += ch;
-								} else {
-									names.push_back(temp);
-									temp.clear();
-								}
+						if (const auto& Managing = Program::Instance().var_manager.Get<false>(variable::Managing_Entity_Name); Managing.Is<Value::Elements>()) {
+							for (const auto& Name : Managing.Get<Value::Elements>()) {
+								if (Name.Is<std::wstring>())
+									names.push_back(Name.Get<std::wstring>());
 							}
 						}
 
 						for (const auto& name : names) {
-							Program::Instance().entity_manager.Kill(name.substr(0, name.find(L'=')));
+							Program::Instance().entity_manager.Kill(name);
 						}
 						Program::Instance().entity_manager.Register(std::make_shared<karapo::entity::Mouse>());
 					} else {
-						Program::Instance().entity_manager.Kill(entity_name);
+						Program::Instance().entity_manager.Kill(Entity_Name);
 					}
 					
 					return;
 				name_error:
-					event::Manager::Instance().error_handler.SendLocalError(empty_name_error, L"R}h: kill/EQ");
+					event::Manager::Instance().error_handler.SendLocalError(empty_name_error, L"コマンド名: kill/殺害");
 					goto end_of_function;
 				lack_error:
-					event::Manager::Instance().error_handler.SendLocalError(lack_of_parameters_error, L"R}h: kill/EQ");
+					event::Manager::Instance().error_handler.SendLocalError(lack_of_parameters_error, L"コマンド名: kill/殺害");
 					goto end_of_function;
 				type_error:
-					event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"R}h: kill/EQ");
+					event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"コマンド名: kill/殺害");
 					goto end_of_function;
 				end_of_function:
 					return;
 				}
 			};
 
-			// Entity܂Entity̎ނ̍XVB
+			// EntityまたはEntityの種類の更新凍結。
 			DYNAMIC_COMMAND(Freeze final) {
 				std::wstring candidate_name{};
 			public:
@@ -1092,11 +1494,11 @@ namespace karapo::event {
 
 				void Execute() override {
 					if (MustSearch()) {
-						auto candidate_name_param = GetParam(0);
-						if (candidate_name_param.type() != typeid(std::wstring)) {
+						const auto& candidate_name_param = GetParam(0);
+						if (!candidate_name_param.Is<std::wstring>()) {
 							goto type_error;
 						}
-						candidate_name = std::any_cast<std::wstring>(candidate_name_param);
+						candidate_name = candidate_name_param.Get<std::wstring>();
 					}
 
 					if (candidate_name.empty()) {
@@ -1111,20 +1513,20 @@ namespace karapo::event {
 					}
 					goto end_of_function;
 				name_error:
-					event::Manager::Instance().error_handler.SendLocalError(empty_name_error, L"R}h: freeze/");
+					event::Manager::Instance().error_handler.SendLocalError(empty_name_error, L"コマンド名: freeze/凍結");
 					goto end_of_function;
 				lack_error:
-					event::Manager::Instance().error_handler.SendLocalError(lack_of_parameters_error, L"R}h: freeze/");
+					event::Manager::Instance().error_handler.SendLocalError(lack_of_parameters_error, L"コマンド名: freeze/凍結");
 					goto end_of_function;
 				type_error:
-					event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"R}h: freeze/");
+					event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"コマンド名: freeze/凍結");
 					goto end_of_function;
 				end_of_function:
 					return;
 				}
 			};
 
-			// Entity܂Entity̎ނ̍XVĊJB
+			// EntityまたはEntityの種類の更新再開。
 			DYNAMIC_COMMAND(Defrost final) {
 				std::wstring candidate_name{};
 			public:
@@ -1138,11 +1540,11 @@ namespace karapo::event {
 
 				void Execute() override {
 					if (MustSearch()) {
-						auto candidate_name_param = GetParam(0);
-						if (candidate_name_param.type() != typeid(std::wstring)) {
+						const auto& candidate_name_param = GetParam(0);
+						if (!candidate_name_param.Is<std::wstring>()) {
 							goto type_error;
 						}
-						candidate_name = std::any_cast<std::wstring>(candidate_name_param);
+						candidate_name = candidate_name_param.Get<std::wstring>();
 					}
 					if (candidate_name.empty()) {
 						goto name_error;
@@ -1160,13 +1562,13 @@ namespace karapo::event {
 					}
 					goto end_of_function;
 				name_error:
-					event::Manager::Instance().error_handler.SendLocalError(empty_name_error, L"R}h: defrost/");
+					event::Manager::Instance().error_handler.SendLocalError(empty_name_error, L"コマンド名: defrost/解凍");
 					goto end_of_function;
 				lack_error:
-					event::Manager::Instance().error_handler.SendLocalError(lack_of_parameters_error, L"R}h: defrost/");
+					event::Manager::Instance().error_handler.SendLocalError(lack_of_parameters_error, L"コマンド名: defrost/解凍");
 					goto end_of_function;
 				type_error:
-					event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"R}h: defrost/");
+					event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"コマンド名: defrost/解凍");
 					goto end_of_function;
 				end_of_function:
 					return;
@@ -1174,7 +1576,7 @@ namespace karapo::event {
 			};
 		}
 
-		// L[͖̃R}h
+		// キー入力毎のコマンド割当
 		class Bind final : public DynamicCommand {
 			std::wstring key_name{}, command_sentence{};
 		public:
@@ -1186,7 +1588,7 @@ namespace karapo::event {
 			void Execute() override;
 		};
 
-		// R}h̕ʖ
+		// コマンドの別名
 		class Alias : public DynamicCommand {
 			std::wstring newone, original;
 		public:
@@ -1202,7 +1604,7 @@ namespace karapo::event {
 
 		DYNAMIC_COMMAND(Filter final) {
 			int potency{};
-			std::wstring layer_name{}, kind_name{};
+			FormatString layer_name{}, kind_name{};
 		public:
 			Filter(const std::wstring& N, const std::wstring& KN, const int P) noexcept : Filter(std::vector<std::wstring>{}) {
 				layer_name = N;
@@ -1216,42 +1618,40 @@ namespace karapo::event {
 
 			void Execute() final {
 				if (MustSearch()) {
-					auto layer_name_param = GetParam(0),
+					const auto& layer_name_param = GetParam(0),
 						kind_name_param = GetParam(1),
 						potecy_param = GetParam(2);
-					if (layer_name_param.type() == typeid(std::nullptr_t) ||
-						kind_name_param.type() == typeid(std::nullptr_t) ||
-						potecy_param.type() == typeid(std::nullptr_t)) [[unlikely]]
+					if (layer_name_param.Is<std::nullptr_t>() ||
+						kind_name_param.Is<std::nullptr_t>() ||
+						potecy_param.Is<std::nullptr_t>()) [[unlikely]]
 					{
 						goto lack_error;
 					} 
-					else if (layer_name_param.type() != typeid(std::wstring) ||
-						kind_name_param.type() != typeid(std::wstring) ||
-						potecy_param.type() != typeid(int)) [[unlikely]]
+					else if (!layer_name_param.Is<std::wstring>() ||
+						!kind_name_param.Is<std::wstring>() ||
+						!potecy_param.Is<int>()) [[unlikely]]
 					{
 						goto type_error;
 					}
-					layer_name = std::any_cast<std::wstring>(layer_name_param);
-					kind_name = std::any_cast<std::wstring>(kind_name_param);
-					potency = std::any_cast<int>(potecy_param);
+					layer_name = layer_name_param.Get<std::wstring>();
+					kind_name = kind_name_param.Get<std::wstring>();
+					potency = potecy_param.Get<int>();
 				}
 
-				if (layer_name.empty() || kind_name.empty()) [[unlikely]] {
+				if (layer_name.IsEmpty() || kind_name.IsEmpty()) [[unlikely]] {
 					goto name_error;
 				}
-				ReplaceFormat(&layer_name);
-				ReplaceFormat(&kind_name);
-				Program::Instance().canvas.ApplyFilter(layer_name, kind_name, potency);
+				Program::Instance().canvas.ApplyFilter(layer_name.Render(), kind_name.Render(), potency);
 				
 				return;
 			name_error:
-				event::Manager::Instance().error_handler.SendLocalError(empty_name_error, L"R}h: filter/tB^[");
+				event::Manager::Instance().error_handler.SendLocalError(empty_name_error, L"コマンド名: filter/フィルター");
 				goto end_of_function;
 			lack_error:
-				event::Manager::Instance().error_handler.SendLocalError(lack_of_parameters_error, L"R}h: filter/tB^[");
+				event::Manager::Instance().error_handler.SendLocalError(lack_of_parameters_error, L"コマンド名: filter/フィルター");
 				goto end_of_function;
 			type_error:
-				event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"R}h: filter/tB^[");
+				event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"コマンド名: filter/フィルター");
 				goto end_of_function;
 			end_of_function:
 				return;
@@ -1269,7 +1669,7 @@ namespace karapo::event {
 			~DLLCommand() override {}
 		};
 
-		// DLLA^b`
+		// DLLアタッチ
 		class Attach final : public DLLCommand {
 		public:
 			inline Attach(const std::wstring& dname) : DLLCommand(dname) {}
@@ -1290,16 +1690,28 @@ namespace karapo::event {
 			}
 		};
 
-		// Cxgďo
+		// イベント呼出
 		DYNAMIC_COMMAND(Call final) {
-			std::wstring event_name{};
+			FormatString event_name{};
+			// イベント名が定数の場合は、解決した呼出先を覚えておき、
+			// イベント一覧の構成が変わった場合のみ解決し直す。
+			bool is_constant_name = false;
+			EventHandle handle{};
+			uint64 event_generation = ~uint64{ 0 };
 			inline static error::ErrorContent *event_not_found_error{};
 		public:
 			DYNAMIC_COMMAND_CONSTRUCTOR(Call) {
+				if (!Param.empty()) {
+					const auto [Name, Type] = Default_ProgramInterface.GetParamInfo(Param[0]);
+					if (Default_ProgramInterface.IsStringType(Type) && !Name.empty() && Name.find(L'{') == Name.npos) {
+						is_constant_name = true;
+						event_name = Name;
+					}
+				}
 				if (event_not_found_error == nullptr)
 					event_not_found_error = error::UserErrorHandler::MakeError(
 						event::Manager::Instance().error_class,
-						L"w肳ꂽCxg܂B",
+						L"指定されたイベントが見つかりません。",
 						MB_OK | MB_ICONERROR,
 						1
 					);
@@ -1308,63 +1720,212 @@ namespace karapo::event {
 			~Call() noexcept final {}
 
 			void Execute() override {
-				std::vector<std::any> params{};
-				SetAllParams(&params);
-				if (MustSearch()) {
-					if (params[0].type() == typeid(std::nullptr_t)) [[unlikely]]
-						goto lack_error;
-					else if (params[0].type() != typeid(std::wstring)) [[unlikely]]
-						goto type_error;
-
-					event_name = std::any_cast<std::wstring>(params[0]);
-				}
-				if (event_name.empty()) [[unlikely]]
-					goto name_error;
-				else {
-					ReplaceFormat(&event_name);
-					Event* e = Program::Instance().event_manager.GetEvent(event_name);
-					if (e == nullptr)
-						goto event_error;
-					else if (!params.empty()) {
-						for (int i = 0; i < e->param_names.size(); i++) {
-							auto value = params[i + 1];
-							auto& newvar = Program::Instance().var_manager.MakeNew(event_name + std::wstring(L".") + e->param_names[i]);
-							if (value.type() == typeid(int))
-								newvar = std::any_cast<int>(value);
-							else if (value.type() == typeid(Dec))
-								newvar = std::any_cast<Dec>(value);
-							else if (value.type() == typeid(std::wstring))
-								newvar = std::any_cast<std::wstring>(value);
-						}
+				auto& manager = Program::Instance().event_manager;
+				EventHandle target{};
+				if (is_constant_name) {
+					if (event_generation != manager.Generation()) {
+						handle = manager.FindHandle(event_name.Source());
+						event_generation = manager.Generation();
 					}
-					if (!Program::Instance().event_manager.Call(event_name)) {
-						goto event_error;
+					target = handle;
+				} else {
+					if (MustSearch()) {
+						const auto Name = Operand(0);
+						if (Name.Is<std::nullptr_t>()) [[unlikely]]
+							goto lack_error;
+						else if (!Name.Is<std::wstring>()) [[unlikely]]
+							goto type_error;
+
+						event_name = Name.Get<std::wstring>();
 					}
+					if (event_name.IsEmpty()) [[unlikely]]
+						goto name_error;
+					target = manager.FindHandle(event_name.Render());
 				}
+
+				// 先頭の引数はイベント名なので、残りを引数領域へ直接積んで渡す。
+				for (int i = 1; i < ParamCount(); i++)
+					manager.PushArgument(Operand(i));
+				if (!manager.CallPushed(target, static_cast<uint32>(std::max(ParamCount() - 1, 0))))
+					goto event_error;
 				return;
 			event_error:
-				event::Manager::Instance().error_handler.SendLocalError(event_not_found_error, L"R}h: call/ďo");
+				event::Manager::Instance().error_handler.SendLocalError(event_not_found_error, L"コマンド名: call/呼出");
 				goto end_of_function;
 			name_error:
-				event::Manager::Instance().error_handler.SendLocalError(empty_name_error, L"R}h: call/ďo");
+				event::Manager::Instance().error_handler.SendLocalError(empty_name_error, L"コマンド名: call/呼出");
+				goto end_of_function;
+			lack_error:
+				event::Manager::Instance().error_handler.SendLocalError(lack_of_parameters_error, L"コマンド名: call/呼出");
+				goto end_of_function;
+			type_error:
+				event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"コマンド名: call/呼出");
+				goto end_of_function;
+			end_of_function:
+				return;
+			}
+		};
+
+		// 実行中のイベントを中断し、指定したフレーム数または時間の後に再開する。
+		// 単位はframe/フレーム(既定)、またはms/ミリ秒。
+		DYNAMIC_COMMAND(Wait final) {
+			inline static error::ErrorContent *unit_error{};
+		public:
+			DYNAMIC_COMMAND_CONSTRUCTOR(Wait) {
+				if (unit_error == nullptr)
+					unit_error = error::UserErrorHandler::MakeError(command_error_class, L"時間の単位が不適切です。", MB_OK | MB_ICONERROR, 1);
+			}
+
+			~Wait() noexcept final {}
+
+			void Execute() override {
+				std::vector<Value> params{};
+				WakeKind kind = WakeKind::Frame;
+				int64 amount = 0;
+				SetAllParams(&params);
+				if (params.empty() || params[0].Is<std::nullptr_t>()) [[unlikely]]
+					goto lack_error;
+				else if (params[0].Is<int>())
+					amount = params[0].Get<int>();
+				else if (params[0].Is<Dec>())
+					amount = static_cast<int64>(params[0].Get<Dec>());
+				else [[unlikely]]
+					goto type_error;
+
+				if (params.size() >= 2) {
+					if (!params[1].Is<std::wstring>()) [[unlikely]]
+						goto unit_error_label;
+
+					const auto& Unit = params[1].Get<std::wstring>();
+					if (Unit == L"ms" || Unit == L"ミリ秒")
+						kind = WakeKind::Time;
+					else if (Unit != L"frame" && Unit != L"フレーム") [[unlikely]]
+						goto unit_error_label;
+				}
+				event::Manager::Instance().Suspend(kind, amount);
+				return;
+			lack_error:
+				event::Manager::Instance().error_handler.SendLocalError(lack_of_parameters_error, L"コマンド名: wait/待機");
 				goto end_of_function;
+			type_error:
+				event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"コマンド名: wait/待機");
+				goto end_of_function;
+			unit_error_label:
+				event::Manager::Instance().error_handler.SendLocalError(unit_error, L"コマンド名: wait/待機");
+				goto end_of_function;
+			end_of_function:
+				return;
+			}
+		};
+
+		// 実行中のイベントを、変数が条件を満たすまで中断する。
+		// 比較方法を省略した場合は一致を待つ。変数と値の型が異なる間は条件を満たさないものとする。
+		DYNAMIC_COMMAND(WaitUntil final) {
+		public:
+			DYNAMIC_COMMAND_CONSTRUCTOR(WaitUntil) {}
+
+			~WaitUntil() noexcept final {}
+
+			void Execute() override {
+				std::vector<Value> params{};
+				Comparison comparison = Comparison::Equal;
+				SetAllParams(&params);
+				if (params.size() < 2) [[unlikely]]
+					goto lack_error;
+
+				if (params.size() >= 3) {
+					comparison = ToComparison(GetParam<true>(1).Get<std::wstring>());
+					if (comparison == Comparison::Unknown) [[unlikely]]
+						goto type_error;
+				}
+				event::Manager::Instance().SuspendUntil(GetParam<true>(0).Get<std::wstring>(), comparison, params.back());
+				return;
 			lack_error:
-				event::Manager::Instance().error_handler.SendLocalError(lack_of_parameters_error, L"R}h: call/ďo");
+				event::Manager::Instance().error_handler.SendLocalError(lack_of_parameters_error, L"コマンド名: waituntil/条件待機");
 				goto end_of_function;
 			type_error:
-				event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"R}h: call/ďo");
+				event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"コマンド名: waituntil/条件待機");
+				goto end_of_function;
+			end_of_function:
+				return;
+			}
+		};
+
+		// 実行中のイベントを中断し、次のフレームで再開する。
+		DYNAMIC_COMMAND(Yield final) {
+		public:
+			Yield() noexcept : Yield(std::vector<std::wstring>{}) {}
+
+			DYNAMIC_COMMAND_CONSTRUCTOR(Yield) {}
+
+			~Yield() noexcept final {}
+
+			void Execute() override {
+				event::Manager::Instance().Suspend(WakeKind::Frame, 1);
+			}
+		};
+
+		// 実行時間の計測
+		// on/開始で計測を始め、off/停止で止める。reset/初期化で統計を0へ戻し、
+		// dump/出力で"<ファイル名>.csv"と"<ファイル名>.folded"へ書き出す。(ファイル名の既定はprofile)
+		DYNAMIC_COMMAND(Profile final) {
+			inline static error::ErrorContent *action_error{}, *dump_error{};
+		public:
+			DYNAMIC_COMMAND_CONSTRUCTOR(Profile) {
+				if (action_error == nullptr)
+					action_error = error::UserErrorHandler::MakeError(command_error_class, L"計測の指定が不適切です。", MB_OK | MB_ICONERROR, 1);
+				if (dump_error == nullptr)
+					dump_error = error::UserErrorHandler::MakeError(command_error_class, L"計測結果を書き出せません。", MB_OK | MB_ICONERROR, 1);
+			}
+
+			~Profile() noexcept final {}
+
+			void Execute() override {
+				std::vector<Value> params{};
+				auto& profiler = event::Manager::Instance().profiler;
+				SetAllParams(&params);
+				if (params.empty()) [[unlikely]]
+					goto lack_error;
+				else if (!params[0].Is<std::wstring>()) [[unlikely]]
+					goto action_error_label;
+				else {
+					const auto& Action = params[0].Get<std::wstring>();
+					if (Action == L"on" || Action == L"開始") {
+						profiler.Enable(true);
+					} else if (Action == L"off" || Action == L"停止") {
+						profiler.Enable(false);
+					} else if (Action == L"reset" || Action == L"初期化") {
+						profiler.Reset();
+					} else if (Action == L"dump" || Action == L"出力") {
+						const std::wstring Base_Path = (params.size() >= 2 && params[1].Is<std::wstring>() ? params[1].Get<std::wstring>() : L"profile");
+						if (!profiler.Dump(Base_Path))
+							goto dump_error_label;
+					} else [[unlikely]] {
+						goto action_error_label;
+					}
+				}
+				return;
+			lack_error:
+				event::Manager::Instance().error_handler.SendLocalError(lack_of_parameters_error, L"コマンド名: profile/計測");
+				goto end_of_function;
+			action_error_label:
+				event::Manager::Instance().error_handler.SendLocalError(action_error, L"コマンド名: profile/計測");
+				goto end_of_function;
+			dump_error_label:
+				event::Manager::Instance().error_handler.SendLocalError(dump_error, L"コマンド名: profile/計測");
 				goto end_of_function;
 			end_of_function:
 				return;
 			}
 		};
 
-		// CxgǉǍ
+		// イベント追加読込
+		// 複数のファイルが指定された場合は、まとめて読み込む。
 		DYNAMIC_COMMAND(Import final) {
-			std::wstring file_name;
+			std::vector<std::wstring> file_names;
 		public:
-			Import(const std::wstring& File_Name) noexcept : Import(std::vector<std::wstring>{}) {
-				file_name = File_Name;
+			Import(const std::vector<std::wstring>& File_Names, std::nullptr_t) noexcept : Import(std::vector<std::wstring>{}) {
+				file_names = File_Names;
 			}
 
 			DYNAMIC_COMMAND_CONSTRUCTOR(Import) {}
@@ -1372,38 +1933,46 @@ namespace karapo::event {
 			~Import() noexcept final {}
 
 			void Execute() override {
+				std::vector<std::wstring> paths = file_names;
 				if (MustSearch()) {
-					auto name_param = GetParam(0);
-					if (name_param.type() == typeid(std::nullptr_t)) [[unlikely]]
-						goto lack_error;
-					else if (name_param.type() != typeid(std::wstring)) [[unlikely]]
-						goto type_error;
-					file_name = std::any_cast<std::wstring>(name_param);
+					paths.clear();
+					for (int i = 0; i < ParamCount(); i++) {
+						const auto& name_param = GetParam(i);
+						if (name_param.Is<std::nullptr_t>()) [[unlikely]]
+							goto lack_error;
+						else if (!name_param.Is<std::wstring>()) [[unlikely]]
+							goto type_error;
+						paths.push_back(name_param.Get<std::wstring>());
+					}
 				}
-				if (file_name.empty()) [[unlikely]]
+				if (paths.empty()) [[unlikely]]
 					goto name_error;
 
-				ReplaceFormat(&file_name);
-				Program::Instance().event_manager.ImportEvent(file_name);
+				for (auto& path : paths) {
+					if (path.empty()) [[unlikely]]
+						goto name_error;
+					ReplaceFormat(&path);
+				}
+				Program::Instance().event_manager.ImportEvent(paths);
 				
 				return;
 			name_error:
-				event::Manager::Instance().error_handler.SendLocalError(empty_name_error, L"R}h: import/捞");
+				event::Manager::Instance().error_handler.SendLocalError(empty_name_error, L"コマンド名: import/取込");
 				goto end_of_function;
 			lack_error:
-				event::Manager::Instance().error_handler.SendLocalError(lack_of_parameters_error, L"R}h: import/捞");
+				event::Manager::Instance().error_handler.SendLocalError(lack_of_parameters_error, L"コマンド名: import/取込");
 				goto end_of_function;
 			type_error:
-				event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"R}h: import/捞");
+				event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"コマンド名: import/取込");
 				goto end_of_function;
 			end_of_function:
 				return;
 			}
 		};
 
-		// CxgǍ
+		// イベント読込
 		DYNAMIC_COMMAND(Load final) {
-			std::wstring file_name;
+			FormatString file_name;
 		public:
 			Load(const std::wstring & File_Name) noexcept : Load(std::vector<std::wstring>{}) {
 				file_name = File_Name;
@@ -1415,28 +1984,27 @@ namespace karapo::event {
 
 			void Execute() override {
 				if (MustSearch()) {
-					auto name_param = GetParam(0);
-					if (name_param.type() == typeid(std::nullptr_t)) [[unlikely]]
+					const auto& name_param = GetParam(0);
+					if (name_param.Is<std::nullptr_t>()) [[unlikely]]
 						goto lack_error;
-					else if (name_param.type() != typeid(std::wstring)) [[unlikely]]
+					else if (!name_param.Is<std::wstring>()) [[unlikely]]
 						goto type_error;
-					file_name = std::any_cast<std::wstring>(name_param);
+					file_name = name_param.Get<std::wstring>();
 				}
-				if (file_name.empty()) [[unlikely]]
+				if (file_name.IsEmpty()) [[unlikely]]
 					goto name_error;
 
-				ReplaceFormat(&file_name);
-				Program::Instance().event_manager.RequestEvent(file_name);
+				Program::Instance().event_manager.RequestEvent(file_name.Render());
 				
 				return;
 			name_error:
-				event::Manager::Instance().error_handler.SendLocalError(empty_name_error, L"R}h: load/Ǎ");
+				event::Manager::Instance().error_handler.SendLocalError(empty_name_error, L"コマンド名: load/読込");
 				goto end_of_function;
 			lack_error:
-				event::Manager::Instance().error_handler.SendLocalError(lack_of_parameters_error, L"R}h: load/Ǎ");
+				event::Manager::Instance().error_handler.SendLocalError(lack_of_parameters_error, L"コマンド名: load/読込");
 				goto end_of_function;
 			type_error:
-				event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"R}h: load/Ǎ");
+				event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"コマンド名: load/読込");
 				goto end_of_function;
 			end_of_function:
 				return;
@@ -1444,21 +2012,21 @@ namespace karapo::event {
 		};
 
 		namespace layer {
-			// C[(wʒu)
+			// レイヤー生成(指定位置)
 			DYNAMIC_COMMAND(Make final) {
-				std::wstring kind_name{}, layer_name{};
+				FormatString kind_name{}, layer_name{};
 				int index = 0;
 				inline static const std::unordered_map<std::wstring, bool (Canvas::*)(const std::wstring&, const int)> Create{
-					// ΈʒuC[
+					// 相対位置レイヤー
 					{ L"scroll",  &Canvas::CreateRelativeLayer },
-					{ L"XN[",  &Canvas::CreateRelativeLayer },
+					{ L"スクロール",  &Canvas::CreateRelativeLayer },
 					{ L"relative",  &Canvas::CreateRelativeLayer },
-					{ L"Έʒu",  &Canvas::CreateRelativeLayer },
-					// ΈʒuC[
+					{ L"相対位置",  &Canvas::CreateRelativeLayer },
+					// 絶対位置レイヤー
 					{ L"fixed",  &Canvas::CreateAbsoluteLayer },
-					{ L"Œ",  &Canvas::CreateAbsoluteLayer },
+					{ L"固定",  &Canvas::CreateAbsoluteLayer },
 					{ L"absolute",  &Canvas::CreateAbsoluteLayer },
-					{ L"Έʒu",  &Canvas::CreateAbsoluteLayer }
+					{ L"絶対位置",  &Canvas::CreateAbsoluteLayer }
 				};
 
 				inline static error::ErrorContent *layer_kind_not_found_error{};
@@ -1471,40 +2039,38 @@ namespace karapo::event {
 
 				DYNAMIC_COMMAND_CONSTRUCTOR(Make) {
 					if (layer_kind_not_found_error == nullptr) [[unlikely]]
-						layer_kind_not_found_error = error::UserErrorHandler::MakeError(command_error_class, L"C[̎ނ܂B", MB_OK | MB_ICONERROR, 2);
+						layer_kind_not_found_error = error::UserErrorHandler::MakeError(command_error_class, L"レイヤーの種類が見つかりません。", MB_OK | MB_ICONERROR, 2);
 				}
 
 				~Make() final {}
 
 				void Execute() final {
 					if (MustSearch()) {
-						auto index_param = GetParam(0),
+						const auto& index_param = GetParam(0),
 							kind_param = GetParam(1),
 							layer_param = GetParam(2);
-						if (index_param.type() == typeid(std::nullptr_t) ||
-							kind_param.type() == typeid(std::nullptr_t) ||
-							layer_param.type() == typeid(std::nullptr_t)) [[unlikely]]
+						if (index_param.Is<std::nullptr_t>() ||
+							kind_param.Is<std::nullptr_t>() ||
+							layer_param.Is<std::nullptr_t>()) [[unlikely]]
 						{
 							goto lack_error;
 						}
-						else if (index_param.type() != typeid(int) ||
-							kind_param.type() != typeid(std::wstring) ||
-							layer_param.type() != typeid(std::wstring)) [[unlikely]]
+						else if (!index_param.Is<int>() ||
+							!kind_param.Is<std::wstring>() ||
+							!layer_param.Is<std::wstring>()) [[unlikely]]
 						{
 							goto type_error;
 						}
-						index = std::any_cast<int>(index_param);
-						kind_name = std::any_cast<std::wstring>(kind_param);
-						layer_name = std::any_cast<std::wstring>(layer_param);
+						index = index_param.Get<int>();
+						kind_name = kind_param.Get<std::wstring>();
+						layer_name = layer_param.Get<std::wstring>();
 					}
-					if (kind_name.empty() || layer_name.empty()) [[unlikely]]
+					if (kind_name.IsEmpty() || layer_name.IsEmpty()) [[unlikely]]
 						goto name_error;
 					{
-						ReplaceFormat(&kind_name);
-						ReplaceFormat(&layer_name);
-						auto it = Create.find(kind_name);
+						auto it = Create.find(kind_name.Render());
 						if (it != Create.end()) [[likely]] {
-							(Program::Instance().canvas.*it->second)(layer_name, index);
+							(Program::Instance().canvas.*it->second)(layer_name.Render(), index);
 						} else
 							goto kind_not_found_error;
 
@@ -1512,25 +2078,25 @@ namespace karapo::event {
 					}
 					return;
 				kind_not_found_error:
-					event::Manager::Instance().error_handler.SendLocalError(layer_kind_not_found_error, L"R}h: makelayer/C[");
+					event::Manager::Instance().error_handler.SendLocalError(layer_kind_not_found_error, L"コマンド名: makelayer/レイヤー生成");
 					goto end_of_function;
 				name_error:
-					event::Manager::Instance().error_handler.SendLocalError(empty_name_error, L"R}h: makelayer/C[");
+					event::Manager::Instance().error_handler.SendLocalError(empty_name_error, L"コマンド名: makelayer/レイヤー生成");
 					goto end_of_function;
 				lack_error:
-					event::Manager::Instance().error_handler.SendLocalError(lack_of_parameters_error, L"R}h: makelayer/C[");
+					event::Manager::Instance().error_handler.SendLocalError(lack_of_parameters_error, L"コマンド名: makelayer/レイヤー生成");
 					goto end_of_function;
 				type_error:
-					event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"R}h: makelayer/C[");
+					event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"コマンド名: makelayer/レイヤー生成");
 					goto end_of_function;
 				end_of_function:
 					return;
 				}
 			};
 
-			// C[ύX
+			// レイヤー変更
 			DYNAMIC_COMMAND(Select final) {
-				std::wstring layer_name{};
+				FormatString layer_name{};
 			public:
 				Select(const std::wstring & LN) noexcept : Select(std::vector<std::wstring>{}) {
 					layer_name = LN;
@@ -1542,39 +2108,38 @@ namespace karapo::event {
 
 				void Execute() final {
 					if (MustSearch()) {
-						auto layer_name_param = GetParam(0);
-						if (layer_name_param.type() == typeid(std::nullptr_t)) [[unlikely]]
+						const auto& layer_name_param = GetParam(0);
+						if (layer_name_param.Is<std::nullptr_t>()) [[unlikely]]
 							goto lack_error;
-						else if (layer_name_param.type() != typeid(std::wstring)) [[unlikely]]
+						else if (!layer_name_param.Is<std::wstring>()) [[unlikely]]
 							goto type_error;
 
-						layer_name = std::any_cast<std::wstring>(layer_name_param);
+						layer_name = layer_name_param.Get<std::wstring>();
 					}
 
-					if (layer_name.empty()) [[unlikely]]
+					if (layer_name.IsEmpty()) [[unlikely]]
 						goto name_error;
 
-					ReplaceFormat(&layer_name);
-					Program::Instance().canvas.SelectLayer(layer_name);
+					Program::Instance().canvas.SelectLayer(layer_name.Render());
 					
 					return;
 				name_error:
-					event::Manager::Instance().error_handler.SendLocalError(empty_name_error, L"R}h: selectlayer/C[I");
+					event::Manager::Instance().error_handler.SendLocalError(empty_name_error, L"コマンド名: selectlayer/レイヤー選択");
 					goto end_of_function;
 				lack_error:
-					event::Manager::Instance().error_handler.SendLocalError(lack_of_parameters_error, L"R}h: selectlayer/C[I");
+					event::Manager::Instance().error_handler.SendLocalError(lack_of_parameters_error, L"コマンド名: selectlayer/レイヤー選択");
 					goto end_of_function;
 				type_error:
-					event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"R}h: selectlayer/C[I");
+					event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"コマンド名: selectlayer/レイヤー選択");
 					goto end_of_function;
 				end_of_function:
 					return;
 				}
 			};
 
-			// ΈʒuC[̊ݒ
+			// 相対位置レイヤーの基準設定
 			DYNAMIC_COMMAND(SetBasis final) {
-				std::wstring entity_name{}, layer_name{};
+				FormatString entity_name{}, layer_name{};
 			public:
 				SetBasis(const std::wstring & EN, const std::wstring & LN) noexcept : SetBasis(std::vector<std::wstring>{}) {
 					entity_name = EN;
@@ -1587,51 +2152,49 @@ namespace karapo::event {
 
 				void Execute() final {
 					if (MustSearch()) {
-						auto entity_name_param = GetParam(0),
+						const auto& entity_name_param = GetParam(0),
 							layer_name_param = GetParam(1);
 
-						if (entity_name_param.type() == typeid(std::nullptr_t) || layer_name_param.type() == typeid(std::nullptr_t)) [[unlikely]]
+						if (entity_name_param.Is<std::nullptr_t>() || layer_name_param.Is<std::nullptr_t>()) [[unlikely]]
 							goto lack_error;
-						else if (entity_name_param.type() != typeid(std::wstring) || layer_name_param.type() != typeid(std::wstring)) [[unlikely]]
+						else if (!entity_name_param.Is<std::wstring>() || !layer_name_param.Is<std::wstring>()) [[unlikely]]
 							goto type_error;
 
-						entity_name = std::any_cast<std::wstring>(GetParam(0));
-						layer_name = std::any_cast<std::wstring>(GetParam(1));
+						entity_name = GetParam(0).Get<std::wstring>();
+						layer_name = GetParam(1).Get<std::wstring>();
 					}
 
-					if (entity_name.empty() || layer_name.empty())
+					if (entity_name.IsEmpty() || layer_name.IsEmpty())
 						goto name_error;
 
 					{
-						ReplaceFormat(&entity_name);
-						ReplaceFormat(&layer_name);
-						auto ent = Program::Instance().entity_manager.GetEntity(entity_name);
+						auto ent = Program::Instance().entity_manager.GetEntity(entity_name.Render());
 						if (ent == nullptr) [[unlikely]]
 							goto entity_error;
 
-						Program::Instance().canvas.SetBasis(ent, layer_name);
+						Program::Instance().canvas.SetBasis(ent, layer_name.Render());
 					}
 					return;
 				entity_error:
-					event::Manager::Instance().error_handler.SendLocalError(entity_not_found_error, L"R}h: setbasis/C[");
+					event::Manager::Instance().error_handler.SendLocalError(entity_not_found_error, L"コマンド名: setbasis/レイヤー基準");
 					goto end_of_function;
 				name_error:
-					event::Manager::Instance().error_handler.SendLocalError(empty_name_error, L"R}h: setbasis/C[");
+					event::Manager::Instance().error_handler.SendLocalError(empty_name_error, L"コマンド名: setbasis/レイヤー基準");
 					goto end_of_function;
 				lack_error:
-					event::Manager::Instance().error_handler.SendLocalError(lack_of_parameters_error, L"R}h: setbasis/C[");
+					event::Manager::Instance().error_handler.SendLocalError(lack_of_parameters_error, L"コマンド名: setbasis/レイヤー基準");
 					goto end_of_function;
 				type_error:
-					event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"R}h: setbasis/C[");
+					event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"コマンド名: setbasis/レイヤー基準");
 					goto end_of_function;
 				end_of_function:
 					return;
 				}
 			};
 
-			// C[폜
+			// レイヤー削除
 			DYNAMIC_COMMAND(Delete final) {
-				std::wstring name{};
+				FormatString name{};
 			public:
 				Delete(const std::wstring& N) noexcept : Delete(std::vector<std::wstring>{}) {
 					name = N;
@@ -1643,35 +2206,34 @@ namespace karapo::event {
 
 				void Execute() final {
 					if (MustSearch()) {
-						auto name_param = GetParam(0);
-						if (name_param.type() == typeid(std::nullptr_t)) [[unlikely]]
+						const auto& name_param = GetParam(0);
+						if (name_param.Is<std::nullptr_t>()) [[unlikely]]
 							goto lack_error;
-						else if (name_param.type() != typeid(std::wstring)) [[unlikely]]
+						else if (!name_param.Is<std::wstring>()) [[unlikely]]
 							goto type_error;
 
-						name = std::any_cast<std::wstring>(name_param);
+						name = name_param.Get<std::wstring>();
 					}
-					if (name.empty()) [[unlikely]]
+					if (name.IsEmpty()) [[unlikely]]
 						goto name_error;
 
-					ReplaceFormat(&name);
-					if (name == L"__all" || name == L"__S") {
+					if (const auto& Name = name.Render(); Name == L"__all" || Name == L"__全部") {
 						for (int i = 0; Program::Instance().canvas.DeleteLayer(i););
-						Program::Instance().canvas.CreateAbsoluteLayer(L"ftHgC[");
-						Program::Instance().canvas.SelectLayer(L"ftHgC[");
+						Program::Instance().canvas.CreateAbsoluteLayer(L"デフォルトレイヤー");
+						Program::Instance().canvas.SelectLayer(L"デフォルトレイヤー");
 					} else {
-						Program::Instance().canvas.DeleteLayer(name);
+						Program::Instance().canvas.DeleteLayer(Name);
 					}
 					
 					return;
 				name_error:
-					event::Manager::Instance().error_handler.SendLocalError(empty_name_error, L"R}h: deletelayer/C[폜");
+					event::Manager::Instance().error_handler.SendLocalError(empty_name_error, L"コマンド名: deletelayer/レイヤー削除");
 					goto end_of_function;
 				lack_error:
-					event::Manager::Instance().error_handler.SendLocalError(lack_of_parameters_error, L"R}h: deletelayer/C[폜");
+					event::Manager::Instance().error_handler.SendLocalError(lack_of_parameters_error, L"コマンド名: deletelayer/レイヤー削除");
 					goto end_of_function;
 				type_error:
-					event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"R}h: deletelayer/C[폜");
+					event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"コマンド名: deletelayer/レイヤー削除");
 					goto end_of_function;
 				end_of_function:
 					return;
@@ -1679,7 +2241,7 @@ namespace karapo::event {
 			};
 
 			DYNAMIC_COMMAND(Show final) {
-				std::wstring name{};
+				FormatString name{};
 			public:
 				Show(const std::wstring &N) noexcept : Show(std::vector<std::wstring>{}) {
 					name = N;
@@ -1691,28 +2253,27 @@ namespace karapo::event {
 
 				void Execute() final {
 					if (MustSearch()) {
-						auto name_param = GetParam(0);
-						if (name_param.type() == typeid(std::nullptr_t)) [[unlikely]]
+						const auto& name_param = GetParam(0);
+						if (name_param.Is<std::nullptr_t>()) [[unlikely]]
 							goto lack_error;
-						else if (name_param.type() != typeid(std::wstring)) [[unlikely]]
+						else if (!name_param.Is<std::wstring>()) [[unlikely]]
 							goto type_error;
 
-						name = std::any_cast<std::wstring>(name_param);
+						name = name_param.Get<std::wstring>();
 					}
-					if (name.empty()) [[unlikely]]
+					if (name.IsEmpty()) [[unlikely]]
 						goto name_error;
-					ReplaceFormat(&name);
-					Program::Instance().canvas.Show(name);
+					Program::Instance().canvas.Show(name.Render());
 					
 					return;
 				name_error:
-					event::Manager::Instance().error_handler.SendLocalError(empty_name_error, L"R}h: showlayer/C[\");
+					event::Manager::Instance().error_handler.SendLocalError(empty_name_error, L"コマンド名: showlayer/レイヤー表示");
 					goto end_of_function;
 				lack_error:
-					event::Manager::Instance().error_handler.SendLocalError(lack_of_parameters_error, L"R}h: showlayer/C[\");
+					event::Manager::Instance().error_handler.SendLocalError(lack_of_parameters_error, L"コマンド名: showlayer/レイヤー表示");
 					goto end_of_function;
 				type_error:
-					event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"R}h: showlayer/C[\");
+					event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"コマンド名: showlayer/レイヤー表示");
 					goto end_of_function;
 				end_of_function:
 					return;
@@ -1720,7 +2281,7 @@ namespace karapo::event {
 			};
 
 			DYNAMIC_COMMAND(Hide final) {
-				std::wstring name{};
+				FormatString name{};
 			public:
 				Hide(const std::wstring &N) noexcept : Hide(std::vector<std::wstring>{}) {
 					name = N;
@@ -1732,28 +2293,27 @@ namespace karapo::event {
 
 				void Execute() final {
 					if (MustSearch()) {
-						auto name_param = GetParam(0);
-						if (name_param.type() == typeid(std::nullptr_t)) [[unlikely]]
+						const auto& name_param = GetParam(0);
+						if (name_param.Is<std::nullptr_t>()) [[unlikely]]
 							goto lack_error;
-						else if (name_param.type() != typeid(std::wstring)) [[unlikely]]
+						else if (!name_param.Is<std::wstring>()) [[unlikely]]
 							goto type_error;
 
-						name = std::any_cast<std::wstring>(name_param);
+						name = name_param.Get<std::wstring>();
 					}
-					if (name.empty()) [[unlikely]]
+					if (name.IsEmpty()) [[unlikely]]
 						goto name_error;
-					ReplaceFormat(&name);
-					Program::Instance().canvas.Hide(name);
+					Program::Instance().canvas.Hide(name.Render());
 					
 					return;
 				name_error:
-					event::Manager::Instance().error_handler.SendLocalError(empty_name_error, L"R}h: hidelayer/C[\");
+					event::Manager::Instance().error_handler.SendLocalError(empty_name_error, L"コマンド名: hidelayer/レイヤー非表示");
 					goto end_of_function;
 				lack_error:
-					event::Manager::Instance().error_handler.SendLocalError(lack_of_parameters_error, L"R}h: hidelayer/C[\");
+					event::Manager::Instance().error_handler.SendLocalError(lack_of_parameters_error, L"コマンド名: hidelayer/レイヤー非表示");
 					goto end_of_function;
 				type_error:
-					event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"R}h: hidelayer/C[\");
+					event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"コマンド名: hidelayer/レイヤー非表示");
 					goto end_of_function;
 				end_of_function:
 					return;
@@ -1764,21 +2324,9 @@ namespace karapo::event {
 		namespace math {
 #define MATH_COMMAND_CALCULATE(OPERATION) \
 	if (Is_Only_Int) { \
-		cal.i = std::any_cast<int>(value[0]) OPERATION std::any_cast<int>(value[1]); \
+		cal.i = value[0].Get<int>() OPERATION value[1].Get<int>(); \
 	} else { \
-		cal.d = 0.0; \
-		if (value[0].type() == typeid(int)) { \
-			cal.d = std::any_cast<int>(value[0]); \
-		} else { \
-			cal.d = std::any_cast<Dec>(value[0]); \
-		} \
- \
-		if (value[1].type() == typeid(int)) { \
-			\
-			cal.d OPERATION= std::any_cast<int>(value[1]); \
-		} else { \
-			cal.d OPERATION= std::any_cast<Dec>(value[1]); \
-		} \
+		cal.d = value[0].ToDec() OPERATION value[1].ToDec(); \
 	}
 
 			DYNAMIC_COMMAND(MathCommand) {
@@ -1792,12 +2340,12 @@ namespace karapo::event {
 						{
 							auto& var = Program::Instance().var_manager.Get<false>(L"__assignable");
 							auto& value = Program::Instance().var_manager.Get<false>(L"__calculated");
-							if (value.type() == typeid(Dec))
-								Program::Instance().var_manager.MakeNew(std::any_cast<std::wstring>(var)) = std::any_cast<Dec>(value);
-							else if (value.type() == typeid(int))
-								Program::Instance().var_manager.MakeNew(std::any_cast<std::wstring>(var)) = std::any_cast<int>(value);
-							else if (value.type() == typeid(std::wstring))
-								Program::Instance().var_manager.MakeNew(std::any_cast<std::wstring>(var)) = std::any_cast<std::wstring>(value);
+							if (value.Is<Dec>())
+								Program::Instance().var_manager.MakeNew(var.Get<std::wstring>()) = value.Get<Dec>();
+							else if (value.Is<int>())
+								Program::Instance().var_manager.MakeNew(var.Get<std::wstring>()) = value.Get<int>();
+							else if (value.Is<std::wstring>())
+								Program::Instance().var_manager.MakeNew(var.Get<std::wstring>()) = value.Get<std::wstring>();
 							break;
 						}
 						case IDNO:
@@ -1814,62 +2362,69 @@ namespace karapo::event {
 					Dec d;
 				};
 
-				void SendAssignError(const std::any& Value) {
-					event::Manager::Instance().error_handler.SendLocalError(assign_error, (L"ϐ: " + var_name).c_str(), &MathCommand::Reassign);
+				void SendAssignError(const Value& Calculated) {
+					event::Manager::Instance().error_handler.SendLocalError(assign_error, (L"変数: " + var_name).c_str(), &MathCommand::Reassign);
 					Program::Instance().var_manager.MakeNew(L"__assignable") = var_name;
-					if (Value.type() == typeid(int))
-						Program::Instance().var_manager.MakeNew(L"__calculated") = std::any_cast<int>(Value);
-					else if (Value.type() == typeid(Dec))
-						Program::Instance().var_manager.MakeNew(L"__calculated") = std::any_cast<Dec>(Value);
-					else if (Value.type() == typeid(std::wstring))
-						Program::Instance().var_manager.MakeNew(L"__calculated") = std::any_cast<std::wstring>(Value);
+					switch (Calculated.GetType()) {
+						case Value::Type::Int:
+						case Value::Type::Dec:
+						case Value::Type::String:
+							Program::Instance().var_manager.MakeNew(L"__calculated") = Calculated;
+							break;
+					}
 				}
 
 				void SendAssignError(const bool Is_Only_Int, const CalculateValue Cal_Value) {
-					event::Manager::Instance().error_handler.SendLocalError(assign_error, (L"ϐ: " + var_name).c_str(), &MathCommand::Reassign);
+					event::Manager::Instance().error_handler.SendLocalError(assign_error, (L"変数: " + var_name).c_str(), &MathCommand::Reassign);
 					Program::Instance().var_manager.MakeNew(L"__assignable") = var_name;
 					Program::Instance().var_manager.MakeNew(L"__calculated") = (Is_Only_Int ? Cal_Value.i : Cal_Value.d);
 				}
 			public:
 				MathCommand(const std::vector<std::wstring>& Params) : DynamicCommand(Params) {
 					if (operation_error_class == nullptr) [[unlikely]]
-						operation_error_class = error::UserErrorHandler::MakeErrorClass(L"ZG[");
+						operation_error_class = error::UserErrorHandler::MakeErrorClass(L"演算エラー");
 					if (assign_error == nullptr) [[unlikely]]
-						assign_error = error::UserErrorHandler::MakeError(operation_error_class, L"̕ϐ݂܂B\nV̕ϐ쐬܂?", MB_YESNO | MB_ICONERROR, 2);
+						assign_error = error::UserErrorHandler::MakeError(operation_error_class, L"代入先の変数が存在しません。\n新しくこの変数を作成しますか?", MB_YESNO | MB_ICONERROR, 2);
 				}
 
 				std::wstring var_name{};
-				std::any value[2]{};
+				Value value[2]{};
 
-				// vZɕKvȒlWJB
-				// ȂtrueAsȂfalseԂB
+				// 計算に必要な値を展開する。
+				// 成功ならtrue、失敗ならfalseを返す。
 				[[nodiscard]] bool Extract(const int Length) noexcept {
 					if (MustSearch()) {
-						var_name = std::any_cast<std::wstring>(GetParam<true>(0));
+						var_name = GetParam<true>(0).Get<std::wstring>();
 						for (int i = 0; i < Length; i++) {
-							value[i] = GetParam(i + 1);
-							// ^`FbN
-							if (value[i].type() == typeid(std::wstring)) {
-								value[i] = std::any_cast<std::wstring>(GetParam<true>(i + 1));
-								auto tmp = std::any_cast<std::wstring>(value[i]);
-								auto [iv, ip] = ToInt(tmp.c_str());
-								auto [fv, fp] = ToDec<Dec>(tmp.c_str());
-								if (wcslen(ip) <= 0)
-									value[i] = iv;
-								else if (wcslen(fp) <= 0)
-									value[i] = fv;
-							} else if (value[i].type() == typeid(int) || value[i].type() == typeid(Dec)) {
-								continue;
-							} else if (value[i].type() == typeid(animation::FrameRef)) {
-								value[i] = std::ref(
-									std::any_cast<animation::FrameRef&>(
-										Program::Instance().var_manager.Get<false>(std::any_cast<std::wstring>(GetParam<true>(i + 1)))
-									)
-								);
-							} else if (value[i].type() == typeid(std::nullptr_t)) [[unlikely]]
-								goto lack_error;
-							else
-								goto type_error;
+							// 型チェック(文字列は引数名から読み直す為、数値のみを写す)
+							const auto& Param = GetParam(i + 1);
+							switch (Param.GetType()) {
+								case Value::Type::String:
+								{
+									value[i] = GetParam<true>(i + 1).Get<std::wstring>();
+									const auto& Text = value[i].Get<std::wstring>();
+									auto [iv, ip] = ToInt(Text.c_str());
+									auto [fv, fp] = ToDec<Dec>(Text.c_str());
+									if (wcslen(ip) <= 0)
+										value[i] = iv;
+									else if (wcslen(fp) <= 0)
+										value[i] = fv;
+									break;
+								}
+								case Value::Type::Int:
+								case Value::Type::Dec:
+									value[i] = Param;
+									break;
+								case Value::Type::Frame:
+									value[i] = std::ref(
+										Program::Instance().var_manager.Get<false>(GetParam<true>(i + 1).Get<std::wstring>()).Get<animation::FrameRef>()
+									);
+									break;
+								case Value::Type::Null: [[unlikely]]
+									goto lack_error;
+								default:
+									goto type_error;
+							}
 						}
 					}
 					return true;
@@ -1885,26 +2440,39 @@ namespace karapo::event {
 			};
 
 			class Assign final : public MathCommand {
+				// 代入する値が文字列の定数であれば、その書式
+				std::optional<FormatString> literal_text{};
 			public:
-				using MathCommand::MathCommand;
+				Assign(const std::vector<std::wstring>& Params) : MathCommand(Params) {
+					if (Params.size() >= 2) {
+						const auto [Text, Type] = Default_ProgramInterface.GetParamInfo(Params[1]);
+						if (Default_ProgramInterface.IsStringType(Type))
+							literal_text.emplace(Text);
+					}
+				}
+
 				~Assign() final {}
 
 				void Execute() final {
 					if (Extract(1)) {
-						auto var_name = std::any_cast<std::wstring>(GetParam<true>(0));
+						auto var_name = GetParam<true>(0).Get<std::wstring>();
 						auto& v = Program::Instance().var_manager.Get<false>(var_name);
-						if (v.type() != typeid(std::nullptr_t)) [[likely]] {
-							if (value[0].type() == typeid(int))
-								v = std::any_cast<int>(value[0]);
-							else if (value[0].type() == typeid(Dec))
-								v = std::any_cast<Dec>(value[0]);
-							else if (value[0].type() == typeid(std::wstring)) {
-								auto txt = std::any_cast<std::wstring>(value[0]);
-								ReplaceFormat(&txt);
-								v = txt;
-							} else if (value[0].type() == typeid(std::reference_wrapper<animation::FrameRef>)) {
-								int i = 0;
-								v = std::any_cast<std::reference_wrapper<animation::FrameRef>&>(value[0]);
+						if (!v.Is<std::nullptr_t>()) [[likely]] {
+							switch (value[0].GetType()) {
+								case Value::Type::Int:
+								case Value::Type::Dec:
+								case Value::Type::FrameHandle:
+									v = value[0];
+									break;
+								case Value::Type::String:
+									if (literal_text.has_value()) {
+										v = literal_text->Render();
+									} else {
+										auto txt = value[0].Get<std::wstring>();
+										ReplaceFormat(&txt);
+										v = std::move(txt);
+									}
+									break;
 							}
 						} else {
 							SendAssignError(value[0]);
@@ -1914,7 +2482,7 @@ namespace karapo::event {
 				}
 			};
 
-			// Z
+			// 加算
 			class Sum final : public MathCommand {
 			public:
 				using MathCommand::MathCommand;
@@ -1923,13 +2491,13 @@ namespace karapo::event {
 
 				void Execute() final {
 					if (Extract(2)) {
-						const bool Is_Only_Int = (value[0].type() == typeid(int) && value[1].type() == typeid(int));
+						const bool Is_Only_Int = (value[0].GetType() == Value::Type::Int && value[1].GetType() == Value::Type::Int);
 
 						CalculateValue cal;
 						MATH_COMMAND_CALCULATE(+);
 
 						auto* v = &Program::Instance().var_manager.Get<false>(var_name);
-						if (v->type() != typeid(std::nullptr_t)) [[likely]] {
+						if (!v->Is<std::nullptr_t>()) [[likely]] {
 							if (Is_Only_Int)
 								*v = cal.i;
 							else
@@ -1942,7 +2510,7 @@ namespace karapo::event {
 				}
 			};
 
-			// Z
+			// 減算
 			class Sub final : public MathCommand {
 			public:
 				using MathCommand::MathCommand;
@@ -1950,13 +2518,13 @@ namespace karapo::event {
 
 				void Execute() final {
 					if (Extract(2)) {
-						const bool Is_Only_Int = (value[0].type() == typeid(int) && value[1].type() == typeid(int));
+						const bool Is_Only_Int = (value[0].GetType() == Value::Type::Int && value[1].GetType() == Value::Type::Int);
 
 						CalculateValue cal;
 						MATH_COMMAND_CALCULATE(-);
 
 						auto* v = &Program::Instance().var_manager.Get<false>(var_name);
-						if (v->type() != typeid(std::nullptr_t)) [[likely]] {
+						if (!v->Is<std::nullptr_t>()) [[likely]] {
 							if (Is_Only_Int)
 								*v = cal.i;
 							else
@@ -1969,7 +2537,7 @@ namespace karapo::event {
 				}
 			};
 
-			// Z
+			// 乗算
 			class Mul final : public MathCommand {
 			public:
 				using MathCommand::MathCommand;
@@ -1977,13 +2545,13 @@ namespace karapo::event {
 
 				void Execute() final {
 					if (Extract(2)) {
-						const bool Is_Only_Int = (value[0].type() == typeid(int) && value[1].type() == typeid(int));
+						const bool Is_Only_Int = (value[0].GetType() == Value::Type::Int && value[1].GetType() == Value::Type::Int);
 
 						CalculateValue cal;
 						MATH_COMMAND_CALCULATE(*);
 
 						auto *v = &Program::Instance().var_manager.Get<false>(var_name);
-						if (v->type() != typeid(std::nullptr_t)) [[likely]] {
+						if (!v->Is<std::nullptr_t>()) [[likely]] {
 							if (Is_Only_Int)
 								*v = cal.i;
 							else
@@ -1996,7 +2564,7 @@ namespace karapo::event {
 				}
 			};
 
-			// Z
+			// 徐算
 			class Div final : public MathCommand {
 			public:
 				using MathCommand::MathCommand;
@@ -2004,13 +2572,13 @@ namespace karapo::event {
 
 				void Execute() final {
 					if (Extract(2)) {
-						const bool Is_Only_Int = (value[0].type() == typeid(int) && value[1].type() == typeid(int));
+						const bool Is_Only_Int = (value[0].GetType() == Value::Type::Int && value[1].GetType() == Value::Type::Int);
 
 						CalculateValue cal;
 						MATH_COMMAND_CALCULATE(/ );
 
 						auto* v = &Program::Instance().var_manager.Get<false>(var_name);
-						if (v->type() != typeid(std::nullptr_t)) [[likely]] {
+						if (!v->Is<std::nullptr_t>()) [[likely]] {
 							if (Is_Only_Int)
 								*v = cal.i;
 							else
@@ -2030,28 +2598,17 @@ namespace karapo::event {
 
 				void Execute() final {
 					if (Extract(2)) {
-						const bool Is_Only_Int = (value[0].type() == typeid(int) && value[1].type() == typeid(int));
+						const bool Is_Only_Int = (value[0].GetType() == Value::Type::Int && value[1].GetType() == Value::Type::Int);
 
 						CalculateValue cal;
 						if (Is_Only_Int) {
-							cal.i = std::any_cast<int>(value[0]) % std::any_cast<int>(value[1]);
+							cal.i = value[0].Get<int>() % value[1].Get<int>();
 						} else {
-							cal.d = 0.0;
-							if (value[0].type() == typeid(int)) {
-								cal.d = std::any_cast<int>(value[0]);
-							} else {
-								cal.d = std::any_cast<Dec>(value[0]);
-							}
-
-							if (value[1].type() == typeid(int)) {
-								cal.d = fmod(cal.d, std::any_cast<int>(value[1]));
-							} else {
-								cal.d = fmod(cal.d, std::any_cast<int>(value[1]));
-							}
-						}
+							cal.d = fmod(value[0].ToDec(), value[1].ToDec());
+						}
 
 						auto* v = &Program::Instance().var_manager.Get<false>(var_name);
-						if (v->type() != typeid(std::nullptr_t)) [[likely]] {
+						if (!v->Is<std::nullptr_t>()) [[likely]] {
 							if (Is_Only_Int)
 								*v = cal.i;
 							else
@@ -2070,18 +2627,12 @@ namespace karapo::event {
 				inline static error::ErrorContent* not_integer_error{};
 
 				auto AddTypeName(std::wstring* extra_message, const int Index) noexcept {
-					auto source_name = value[Index].type().name();
-					auto converted_name = new(std::nothrow) wchar_t[strlen(source_name) + 1]{};
-					if (converted_name != nullptr) {
-						mbstowcs(converted_name, source_name, strlen(source_name) + 1);
-						*extra_message += std::any_cast<std::wstring>(GetParam<true>(Index)) + std::wstring(L": ") + converted_name + L'\n';
-						delete[] converted_name;
-					}
+					*extra_message += GetParam<true>(Index).Get<std::wstring>() + std::wstring(L": ") + value[Index].TypeName() + L'\n';
 				}
 
 				std::pair<bool, bool> CheckValueType() const noexcept {
-					const bool Is_First_Int = (value[0].type() == typeid(int));
-					const bool Is_Second_Int = (value[1].type() == typeid(int));
+					const bool Is_First_Int = (value[0].Is<int>());
+					const bool Is_Second_Int = (value[1].Is<int>());
 					return { Is_First_Int, Is_Second_Int };
 				}
 
@@ -2095,15 +2646,15 @@ namespace karapo::event {
 			public:
 				BitCommand(const std::vector<std::wstring>& Params) : MathCommand(Params) {
 					if (logic_operation_error_class == nullptr) [[unlikely]]
-						logic_operation_error_class = error::UserErrorHandler::MakeErrorClass(L"_ZG[");
+						logic_operation_error_class = error::UserErrorHandler::MakeErrorClass(L"論理演算エラー");
 					if (not_integer_error == nullptr) [[unlikely]]
-						not_integer_error = error::UserErrorHandler::MakeError(logic_operation_error_class, L"rbgZɗpϐ̒llł͂܂B", MB_OK | MB_ICONERROR, 2);
+						not_integer_error = error::UserErrorHandler::MakeError(logic_operation_error_class, L"ビット演算に用いる変数の値が整数値ではありません。", MB_OK | MB_ICONERROR, 2);
 				}
 
 				~BitCommand() override {}
 			};
 
-			// rbg_a
+			// ビット論理和
 			class Or final : public BitCommand {
 			public:
 				using BitCommand::BitCommand;
@@ -2115,22 +2666,22 @@ namespace karapo::event {
 
 						if (Is_Int.first && Is_Int.second) [[likely]] {
 							CalculateValue cal;
-							cal.i = std::any_cast<int>(value[0]) | std::any_cast<int>(value[1]);
+							cal.i = value[0].Get<int>() | value[1].Get<int>();
 							auto* v = &Program::Instance().var_manager.Get<false>(var_name);
-							if (v->type() != typeid(std::nullptr_t)) {
+							if (!v->Is<std::nullptr_t>()) {
 								*v = cal.i;
 							} else {
 								SendAssignError(true, cal);
 							}
 						} else {
-							SendBitLogicError(L"Z: rbg_a\n", Is_Int);
+							SendBitLogicError(L"演算: ビット論理和\n", Is_Int);
 						}
 					}
 					
 				}
 			};
 
-			// rbg_
+			// ビット論理積
 			class And final : public BitCommand {
 			public:
 				using BitCommand::BitCommand;
@@ -2141,22 +2692,22 @@ namespace karapo::event {
 						const auto Is_Int = CheckValueType();
 						if (Is_Int.first && Is_Int.second) [[likely]] {
 							CalculateValue cal;
-							cal.i = std::any_cast<int>(value[0]) & std::any_cast<int>(value[1]);
+							cal.i = value[0].Get<int>() & value[1].Get<int>();
 							auto* v = &Program::Instance().var_manager.Get<false>(var_name);
-							if (v->type() != typeid(std::nullptr_t)) {
+							if (!v->Is<std::nullptr_t>()) {
 								*v = cal.i;
 							} else {
 								SendAssignError(true, cal);
 							}
 						} else {
-							SendBitLogicError(L"Z: rbg_\n", Is_Int);
+							SendBitLogicError(L"演算: ビット論理積\n", Is_Int);
 						}
 					}
 					
 				}
 			};
 
-			// rbgrI_a
+			// ビット排他的論理和
 			class Xor final : public BitCommand {
 			public:
 				using BitCommand::BitCommand;
@@ -2168,22 +2719,22 @@ namespace karapo::event {
 
 						if (Is_Int.first && Is_Int.second) [[likely]] {
 							CalculateValue cal;
-							cal.i = std::any_cast<int>(value[0]) ^ std::any_cast<int>(value[1]);
+							cal.i = value[0].Get<int>() ^ value[1].Get<int>();
 							auto* v = &Program::Instance().var_manager.Get<false>(var_name);
-							if (v->type() != typeid(std::nullptr_t)) {
+							if (!v->Is<std::nullptr_t>()) {
 								*v = cal.i;
 							} else {
 								SendAssignError(true, cal);
 							}
 						} else {
-							SendBitLogicError(L"Z: rbgrI_a\n", Is_Int);
+							SendBitLogicError(L"演算: ビット排他的論理和\n", Is_Int);
 						}
 					}
 					
 				}
 			};
 
-			// rbg_ے
+			// ビット論理否定
 			class Not final : public BitCommand {
 			public:
 				using BitCommand::BitCommand;
@@ -2192,19 +2743,19 @@ namespace karapo::event {
 				void Execute() final {
 					if (Extract(1)) [[likely]] {
 						std::wstring var_name{};
-						var_name = std::any_cast<std::wstring>(GetParam<true>(0));
+						var_name = GetParam<true>(0).Get<std::wstring>();
 
-						if (value[0].type() == typeid(int)) [[likely]] {
+						if (value[0].Is<int>()) [[likely]] {
 							auto* v = &Program::Instance().var_manager.Get<false>(var_name);
 							CalculateValue cal;
-							cal.i = ~std::any_cast<int>(value[0]);
-							if (v->type() != typeid(std::nullptr_t)) {
+							cal.i = ~value[0].Get<int>();
+							if (!v->Is<std::nullptr_t>()) {
 								*v = cal.i;
 							} else {
 								SendAssignError(true, cal);
 							}
 						} else {
-							SendBitLogicError(L"Z: rbg_ے\n", { false, true });
+							SendBitLogicError(L"演算: ビット論理否定\n", { false, true });
 						}
 					}
 					
@@ -2212,475 +2763,976 @@ namespace karapo::event {
 			};
 		}
 
-		namespace hidden {
-			// EntityւSĂManagerXV
-			class UpdateEntity final : public DynamicCommand {
-			public:
-				UpdateEntity() noexcept {}
-				~UpdateEntity() noexcept final {}
+		namespace array {
+			// 配列操作系コマンド
+			// 第1引数を配列の変数名とする。
+			class ArrayCommand : public DynamicCommand {
+				inline static error::ErrorContent *out_of_range_error{};
+			protected:
+				// 引数が指す変数を、イベント内の変数・全体の変数の順に探す。
+				// どちらも無い場合は、値を持たない変数を返す。
+				Value& FindVariable(const int Index) const noexcept {
+					const auto Name = GetParam<true>(Index).Get<std::wstring>();
+					auto& var_manager = Program::Instance().var_manager;
+					auto& local = var_manager.Get<false>(Program::Instance().event_manager.ExecutingEventName() + L'.' + Name);
+					return (!local.Is<std::nullptr_t>() ? local : var_manager.Get<false>(Name));
+				}
 
-				void Execute() final {
-					Program::Instance().entity_manager.Update();
-					Program::Instance().canvas.Update();
+				// 配列の変数を探す。配列でない場合はnullptrを返す。
+				Value* FindArray() const noexcept {
+					auto& var = FindVariable(0);
+					return (var.Is<Value::Elements>() ? &var : nullptr);
+				}
 
-					
+				// 添字の引数を読む。
+				// 整数でない、または範囲外の場合は-1を返す。
+				int Subscript(const int Index, const size_t Size) const noexcept {
+					const auto& Value_Index = GetParam(Index);
+					if (!Value_Index.Is<int>())
+						return -1;
+					const int I = Value_Index.Get<int>();
+					return (I >= 0 && I < static_cast<int>(Size) ? I : -1);
+				}
+
+				// 結果を代入する。代入先はFindVariableと同じ順に探し、どちらにも無い場合は全体の変数として作成する。
+				void Store(const int Index, Value&& result) {
+					auto *var = &FindVariable(Index);
+					if (var->Is<std::nullptr_t>())
+						var = &Program::Instance().var_manager.MakeNew(GetParam<true>(Index).Get<std::wstring>());
+					*var = std::move(result);
+				}
+
+				void SendOutOfRangeError(const wchar_t* Command_Name) {
+					event::Manager::Instance().error_handler.SendLocalError(out_of_range_error, Command_Name);
+				}
+			public:
+				ArrayCommand(const std::vector<std::wstring>& Params) : DynamicCommand(Params) {
+					if (out_of_range_error == nullptr) [[unlikely]]
+						out_of_range_error = error::UserErrorHandler::MakeError(command_error_class, L"添字が配列の範囲外です。", MB_OK | MB_ICONERROR, 1);
 				}
 			};
-		}
-	}
 
-	// Cxg̃R}hsNX
-	class Manager::CommandExecuter final {
-	public:
-		CommandExecuter(const std::list<CommandTree>* commands) {
-			if (commands->empty())
-				return;
+			// 末尾への追加
+			class Push final : public ArrayCommand {
+			public:
+				using ArrayCommand::ArrayCommand;
+				~Push() final {}
 
-			Program::Instance().var_manager.MakeNew(L"of_state") = 1;
-			// AR}hsB
-			{
-				const CommandTree *executing = &commands->front();
-				const CommandTree *goal = &commands->back();
-				while (executing != nullptr) {
-					executing->command->Execute();
-					
-					// e݂AgS[łȂꍇ:
-					// gcaseR}hȂ̂ŁAofR}hTB
-					if (executing->parent == nullptr && executing != goal) {
-						auto command_iterator = std::find_if(commands->begin(), commands->end(), [executing](const CommandTree& tree) {
-							return executing == &tree;
-						});
+				void Execute() final {
+					auto *const Array = FindArray();
+					if (Array == nullptr) [[unlikely]]
+						goto type_error;
 
-						command_iterator++;
-						while (command_iterator != commands->end()) {
-							if (command_iterator->word == L"of" || command_iterator->word == L"else") {
-								command_iterator->command->Execute();
-								auto can_execute = std::any_cast<int>(Program::Instance().var_manager.Get<false>(L"of_state"));
-								if (can_execute) {
-									// s\ȃR}hȂ̂ŁAR}hsB
-									executing = command_iterator->parent;
-									break;
-								}
-							}
-							command_iterator++;
-						}
-					} else
-						executing = executing->parent;
+					Array->Get<Value::Elements>().push_back(Operand(1));
+					return;
+				type_error:
+					event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"コマンド名: push/末尾追加");
 				}
-			}
-		}
-	};
-
-	// CxgNX
-	// Cxgt@C̉́AR}h̐ACxg̐ݒEsB
-	class EventGenerator final : private Singleton {
-	public:
-		// ̓NX
-		class Parser final {
-			// \
-			struct Syntax final {
-				std::wstring text{};
-				Syntax* parent{};
 			};
 
-			// ꕶ̉͊B
-			// 󔒂ƂPPʂ̉͌ʂcontextƂĔroB
-			class LexicalParser final {
-				Context context;
+			// 末尾の削除
+			// 代入先が指定されていれば、削除した値を代入する。
+			class Pop final : public ArrayCommand {
 			public:
-				LexicalParser(const std::wstring Sentence) noexcept {
-					auto PushWord = [](Context  *const context, std::wstring *const text) noexcept {
-						wprintf_s(L"Pushed:%s\n", text->c_str());
-						context->push_back(*text);
-						text->clear();
-					};
+				using ArrayCommand::ArrayCommand;
+				~Pop() final {}
 
+				void Execute() final {
+					auto *const Array = FindArray();
+					if (Array == nullptr) [[unlikely]]
+						goto type_error;
 					{
-						// ǂݍƂPꂪAƂďĂ邩𔻒肷ׂ̕ϐ
-						// ltrue̊ԁA͊̓Xy[X؂蕶ƂĔFȂȂB
-						bool is_string = false;
-						auto text = std::wstring(L"");
-
-						for (auto c : Sentence) {
-							if (!is_string) {
-								
+						auto& elements = Array->Get<Value::Elements>();
+						if (elements.empty())
+							goto range_error;
+
+						auto last = std::move(elements.back());
+						elements.pop_back();
+						if (ParamCount() >= 2)
+							Store(1, std::move(last));
+					}
+					return;
+				type_error:
+					event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"コマンド名: pop/末尾削除");
+					return;
+				range_error:
+					SendOutOfRangeError(L"コマンド名: pop/末尾削除");
+				}
+			};
 
-								// Xy[X
-								if (IsSpace(c) || c == L'\0' || c == L'\n') {
-									// ߂񂾕PƂĊi[
-									if (!text.empty()) {
-										PushWord(&context, &text);
-									}
+			// 要素の取得
+			class GetElement final : public ArrayCommand {
+			public:
+				using ArrayCommand::ArrayCommand;
+				~GetElement() final {}
 
-									if (c == L'\n' && context.back() != L"\n") {
-										text = L'\n';
-										PushWord(&context, &text);
-									}
-									continue;
-								} else if (c == L'\r') {
-									// AR[h͖B
-									continue;
-								}
+				void Execute() final {
+					auto *const Array = FindArray();
+					if (Array == nullptr) [[unlikely]]
+						goto type_error;
+					{
+						const auto& Elements = Array->Get<Value::Elements>();
+						const int Index = Subscript(1, Elements.size());
+						if (Index < 0)
+							goto range_error;
 
-								// Zq
-								switch (c) {
-									case L'\'':
-										is_string = true;
-										break;
-									case L'/':
-									case L'~':
-									case L']':
-									case L'[':
-									case L'>':
-									case L'<':
-									case L'(':
-									case L')':
-									case L',':
-									case L'{':
-									case L'}':
-									{
-										// ߂񂾕PƂĊi[
-										if (!text.empty()) {
-											PushWord(&context, &text);
-										}
-										// L
-										text = c;
-										PushWord(&context, &text);
-										continue;
-									}
-									break;
-								}
-							} else {
-								// Zq
-								switch (c) {
-									case L'\'':
-										is_string = false;
-										text += c;
-										PushWord(&context, &text);
-										continue;
-								}
-							}
-							// ǂݍ񂾕t
-							text += c;
-						}
+						Store(2, Value(Elements[Index]));
 					}
+					return;
+				type_error:
+					event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"コマンド名: get/要素取得");
+					return;
+				range_error:
+					SendOutOfRangeError(L"コマンド名: get/要素取得");
+				}
+			};
+
+			// 要素の設定
+			class SetElement final : public ArrayCommand {
+			public:
+				using ArrayCommand::ArrayCommand;
+				~SetElement() final {}
 
+				void Execute() final {
+					auto *const Array = FindArray();
+					if (Array == nullptr) [[unlikely]]
+						goto type_error;
 					{
-						// ̌
-						// >A=A<A/ꂼꌋB
-
-						std::wstring tmp{};
-						Context::iterator it = context.begin();
-						while (it != context.end()) {
-							it = std::find_if(it, context.end(), [](std::wstring text) {
-								return text == L"<" || text == L"=" || text == L">" || text == L"/" || text == L"\n";
-							});
-
-							if (it != context.end()) {
-								if (*it == L"\n") {
-									tmp.clear();
-									it++;
-									continue;
-								}
-								tmp += *it;
-								if (tmp.size() == 2) {
-									if (tmp == L"<=" || tmp == L"==" || tmp == L">=" || tmp == L"//") {
-										// 
-										context.erase(it--);
-										context.insert(it, tmp);
-										context.erase(it++);
-										tmp.clear();
-									} else if (tmp == L"<>" || tmp == L"=>" || tmp == L"=<") {
-										// Zqł͂Ȃ̂ňꎞۑp𖖏B
-										tmp.clear();
-									}
-								}
-								it++;
-							}
-						}
+						auto& elements = Array->Get<Value::Elements>();
+						const int Index = Subscript(1, elements.size());
+						if (Index < 0)
+							goto range_error;
+
+						elements[Index] = Operand(2);
 					}
+					return;
+				type_error:
+					event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"コマンド名: set/要素設定");
+					return;
+				range_error:
+					SendOutOfRangeError(L"コマンド名: set/要素設定");
 				}
+			};
+
+			// 要素数の取得
+			class Length final : public ArrayCommand {
+			public:
+				using ArrayCommand::ArrayCommand;
+				~Length() final {}
 
-				auto Result() const noexcept {
-					return context;
+				void Execute() final {
+					if (const auto *const Array = FindArray(); Array != nullptr) [[likely]]
+						Store(1, static_cast<int>(Array->Get<Value::Elements>().size()));
+					else
+						event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"コマンド名: len/要素数");
 				}
 			};
 
-			class TypeDeterminer final {
-				Context compiled{};
+			// 全要素の削除
+			// 変数が配列でなければ空の配列にし、変数が無ければ空の配列として作成する。
+			class Clear final : public ArrayCommand {
 			public:
-				TypeDeterminer(Context& context) {
-					while (!context.empty()) {
-						auto&& word = std::move(context.front());
-						if (iswdigit(word[0]) || word[0] == L'-') {
-							word += std::wstring(L":") + innertype::Number;
-						} else if (word[0] == L'\'') {
-							word += std::wstring(L":") + innertype::String;
-							for (size_t pos = word.find(L'\''); pos != std::wstring::npos; pos = word.find(L'\'')) {
-								word.erase(pos, 1);
-							}
-						}
-						compiled.push_back(std::move(word));
-						context.pop_front();
+				using ArrayCommand::ArrayCommand;
+				~Clear() final {}
+
+				void Execute() final {
+					if (auto *const Array = FindArray(); Array != nullptr)
+						Array->Get<Value::Elements>().clear();
+					else
+						Store(0, Value::Elements{});
+				}
+			};
+
+			// 並べ替え
+			// 数値を値の小さい順に、文字列を辞書順に並べ、数値を文字列より前に置く。
+			class Sort final : public ArrayCommand {
+				// 並べ替えの際の型の順位
+				static int Rank(const Value& V) noexcept {
+					switch (V.GetType()) {
+						case Value::Type::Int:
+						case Value::Type::Dec:
+							return 0;
+						case Value::Type::String:
+							return 1;
+						default:
+							return 2;
 					}
 				}
+			public:
+				using ArrayCommand::ArrayCommand;
+				~Sort() final {}
 
-				auto Result() noexcept {
-					return std::move(compiled);
+				void Execute() final {
+					auto *const Array = FindArray();
+					if (Array == nullptr) [[unlikely]] {
+						event::Manager::Instance().error_handler.SendLocalError(incorrect_type_error, L"コマンド名: sort/並べ替え");
+						return;
+					}
+
+					auto& elements = Array->Get<Value::Elements>();
+					std::stable_sort(elements.begin(), elements.end(), [](const Value& A, const Value& B) {
+						const int Rank_A = Rank(A), Rank_B = Rank(B);
+						if (Rank_A != Rank_B)
+							return Rank_A < Rank_B;
+						else if (Rank_A == 0)
+							return A.ToDec() < B.ToDec();
+						else if (Rank_A == 1)
+							return A.Get<std::wstring>() < B.Get<std::wstring>();
+						return false;
+					});
 				}
 			};
+		}
 
-			// \؉
-			class SyntaxParser final {
-				std::list<Syntax> tree{};
-				inline static error::ErrorContent *invalid_operator_error{};
+		namespace hidden {
+			// Entityが関わる全てのManagerを更新
+			class UpdateEntity final : public DynamicCommand {
 			public:
-				SyntaxParser(Context* lexical_context) noexcept {
-					if (invalid_operator_error == nullptr)
-						invalid_operator_error = error::UserErrorHandler::MakeError(event::Manager::Instance().error_class, L"\Ɍ肪܂B", MB_OK | MB_ICONERROR, 1);
+				UpdateEntity() noexcept {}
+				~UpdateEntity() noexcept final {}
+
+				void Execute() final {
+					Program::Instance().entity_manager.Update();
+					Program::Instance().canvas.Update();
+
 					
-					error::ErrorContent *error_occurred{};
+				}
+			};
+		}
+	}
 
-					tree.push_front({});
-					tree.push_front(Syntax{ .parent = &tree.front() });
-					auto operator_iterator = tree.end();
-					auto tree_iterator = tree.begin();
+	bool Manager::CommandExecuter::IsBranch(const CommandTree& Tree) noexcept {
+		return Tree.word == L"of" || Tree.word == L"else";
+	}
 
-					while (!lexical_context->empty() && error_occurred == nullptr) {
-						auto str = lexical_context->front();
-						switch (str[0]) {
-							case L'{':
-							case L'}':
-							case L'[':
-							case L']':
-							case L'<':
-							case L'>':
-							case L'(':
-							case L')':
-							{
-								if (str.size() > 1)
-									goto not_operator;
-								auto old = tree_iterator;
-								if (operator_iterator == tree.end()) {
-									tree_iterator++;
-									operator_iterator = tree_iterator;
-								} else
-									tree_iterator = operator_iterator;
-								
-								tree_iterator->text += str[0];
-								// 
-								if (tree_iterator->text.size() == 2 && tree_iterator->text != L"()" && tree_iterator->text != L"<>" && tree_iterator->text != L"[]" && tree_iterator->text != L"{}") {
-									error_occurred = invalid_operator_error;
-									event::Manager::Instance().error_handler.SendLocalError(error_occurred, L": " + tree_iterator->text);
-								}
-								tree_iterator = old;
-								break;
-							}
-							case L'\n':
-							{
-								if (operator_iterator != tree.end()) {
-									if (operator_iterator->text != L"{") {
-										operator_iterator = tree.end();
-										tree_iterator->parent = nullptr;
-										tree.push_front(Syntax{ .parent = &(*tree_iterator) });
-									} else {
-										// R}h͕s̕ō\B
-										// ({}eƂ\؂݂B)
-										// 
-										// ׁ̈A{}eƂĐݒB
-										tree_iterator->parent = &(*operator_iterator);
-									}
-									tree_iterator = tree.begin();
-								}
+	// 並びはSortOfElse後のstd::list内の順序を保ち、caseに続く分岐コマンドの後には実行終了命令を置く。
+	// 分岐が全て同じ型の定数との一致判定であれば、caseの直後に分岐表を引く命令を置く。
+	void Manager::CommandExecuter::Compile(Event* event) {
+		// 変数の読み書きは、コマンドが変わった後に調べ直す。
+		event->access = {};
+
+		enum class Kind : uint8 {
+			Plain,		// 通常のコマンド
+			Case,		// caseコマンド
+			Arm			// caseに続く分岐コマンド
+		};
+
+		const auto& Commands = event->commands;
+		std::vector<const CommandTree*> trees{};
+		trees.reserve(Commands.size());
+		for (const auto& Tree : Commands)
+			trees.push_back(&Tree);
+		const CommandTree *goal = (trees.empty() ? nullptr : trees.back());
+
+		// 各コマンドの種類を決める。
+		std::vector<Kind> kinds(trees.size(), Kind::Plain);
+		for (size_t i = 0; i < trees.size(); i++) {
+			const bool In_Branch = (i > 0 && kinds[i - 1] != Kind::Plain);
+			if (In_Branch && IsBranch(*trees[i]))
+				kinds[i] = Kind::Arm;
+			else if (trees[i]->parent == nullptr && trees[i] != goal)
+				kinds[i] = Kind::Case;
+		}
+
+		// 分岐表へ変換できるか否か。
+		// elseは最初(省略されたelseを補ったもの)または最後の分岐である場合のみ認める。
+		auto is_switchable = [&](const size_t Case_Index) -> bool {
+			Value::Type type = Value::Type::Null;
+			size_t i = Case_Index + 1;
+			if (i < trees.size() && kinds[i] == Kind::Arm && trees[i]->word != L"of")
+				i++;
+			for (; i < trees.size() && kinds[i] == Kind::Arm; i++) {
+				if (trees[i]->word != L"of")
+					break;
+				const auto *const Literal = static_cast<const command::Of*>(trees[i]->command.get())->EqualityLiteral();
+				if (Literal == nullptr || (!Literal->Is<int>() && !Literal->Is<std::wstring>()))
+					return false;
+				if (type != Value::Type::Null && type != Literal->GetType())
+					return false;
+				type = Literal->GetType();
+			}
+			if (i < trees.size() && kinds[i] == Kind::Arm)
+				i++;
+			return type != Value::Type::Null && (i >= trees.size() || kinds[i] != Kind::Arm);
+		};
+		std::vector<bool> switchable(trees.size(), false);
+		for (size_t i = 0; i < trees.size(); i++) {
+			if (kinds[i] == Kind::Case)
+				switchable[i] = is_switchable(i);
+		}
+
+		// 各コマンドの位置を決める。
+		std::unordered_map<const CommandTree*, uint32> address{};
+		uint32 pc = 0;
+		for (size_t i = 0; i < trees.size(); i++) {
+			if (i > 0 && kinds[i - 1] != Kind::Plain && kinds[i] != Kind::Arm)
+				pc++;
+			address[trees[i]] = pc++;
+			if (switchable[i])
+				pc++;
+		}
+		if (!trees.empty() && kinds.back() != Kind::Plain)
+			pc++;
+
+		const uint32 Halt_Address = pc;
+		auto target_of = [&address, Halt_Address](const CommandTree* Parent) -> uint32 {
+			return (Parent != nullptr ? address.at(Parent) : Halt_Address);
+		};
+
+		// 引数を参照するコマンドは、引数の位置へ結び付けておく。
+		for (const auto* Tree : trees) {
+			if (auto *const dynamic = dynamic_cast<command::DynamicCommand*>(Tree->command.get()))
+				dynamic->BindArguments(event->param_names);
+		}
+
+		auto& profiler = Manager::Instance().profiler;
+		auto& code = event->program;
+		auto& tables = event->branch_tables;
+		code.clear();
+		tables.clear();
+		code.reserve(static_cast<size_t>(Halt_Address) + 1);
+		for (size_t i = 0; i < trees.size(); i++) {
+			const auto& Tree = *trees[i];
+			if (i > 0 && kinds[i - 1] != Kind::Plain && kinds[i] != Kind::Arm)
+				code.push_back(Instruction{ .op = Instruction::Op::Halt });
+
+			switch (kinds[i]) {
+				case Kind::Arm:
+					code.push_back(Instruction{ .op = Instruction::Op::Branch, .command = Tree.command.get(), .target = target_of(Tree.parent), .profile = profiler.CommandEntry(Tree.word) });
+					break;
+				case Kind::Case:
+					// 分岐コマンドはcaseの直後に並ぶので、次の命令へ進む。
+					code.push_back(Instruction{ .op = Instruction::Op::Execute, .command = Tree.command.get(), .target = static_cast<uint32>(code.size() + 1), .profile = profiler.CommandEntry(Tree.word) });
+					if (switchable[i]) {
+						BranchTable table{};
+						size_t j = i + 1;
+						if (trees[j]->word != L"of") {
+							table.has_leading_else = true;
+							table.leading_else_target = target_of(trees[j]->parent);
+							j++;
+						}
+						for (; j < trees.size() && kinds[j] == Kind::Arm && trees[j]->word == L"of"; j++) {
+							const auto& Literal = *static_cast<const command::Of*>(trees[j]->command.get())->EqualityLiteral();
+							const uint32 Target = target_of(trees[j]->parent);
+							table.type = Literal.GetType();
+							// 同じ定数が複数ある場合は、先の分岐を優先する。
+							if (Literal.Is<int>())
+								table.int_targets.try_emplace(Literal.Get<int>(), Target);
+							else
+								table.string_targets.try_emplace(Literal.Get<std::wstring>(), Target);
+						}
+						table.has_else = (j < trees.size() && kinds[j] == Kind::Arm);
+						// elseが無い場合は、分岐の後の実行終了命令へ進む。
+						table.default_target = (table.has_else ? target_of(trees[j]->parent) : address.at(trees[j - 1]) + 1);
+
+						code.push_back(Instruction{ .op = Instruction::Op::Switch, .target = static_cast<uint32>(tables.size()) });
+						tables.push_back(std::move(table));
+					}
+					break;
+				default:
+					code.push_back(Instruction{ .op = Instruction::Op::Execute, .command = Tree.command.get(), .target = target_of(Tree.parent), .profile = profiler.CommandEntry(Tree.word) });
+					break;
+			}
+		}
+		if (!trees.empty() && kinds.back() != Kind::Plain)
+			code.push_back(Instruction{ .op = Instruction::Op::Halt });
+		code.push_back(Instruction{ .op = Instruction::Op::Halt });
+	}
+
+	Manager::CommandExecuter::CommandExecuter(Event* event, SuspendedFrame* resuming) {
+		if (event->program.empty())
+			Compile(event);
+
+		if (event->commands.empty())
+			return;
+
+		auto& manager = Manager::Instance();
+		auto& context = manager.Context();
+		auto& of_state = (context.of_state != nullptr ? *context.of_state : Program::Instance().var_manager.MakeNew(L"of_state"));
+		of_state = (resuming != nullptr ? resuming->of_state : 1);
+
+		// このイベント内で始まったcaseは、中断する時に呼出情報へ移す。
+		auto& conditions = context.condition_manager;
+		const size_t Condition_Depth = conditions.size();
+		if (resuming != nullptr && !resuming->conditions.empty()) {
+			for (auto& condition : resuming->conditions)
+				conditions.push_back(std::move(condition));
+			context.condition_current = conditions.end() - 1;
+		}
+		const Instruction *const Code = event->program.data();
+		// 呼出によって実行される場合は、実行位置を呼出情報に持たせる。
+		uint32 local_pc = 0;
+		Frame *const Current_Frame = (!context.frames.empty() && context.frames.back().event == event ? &context.frames.back() : nullptr);
+		uint32& pc = (Current_Frame != nullptr ? Current_Frame->pc : local_pc);
+		pc = (resuming != nullptr ? resuming->pc : 0);
+		while (true) {
+			const Instruction& Current = Code[pc];
+			switch (Current.op) {
+				case Instruction::Op::Execute:
+					if (manager.profiler.IsEnabled()) [[unlikely]]
+						manager.profiler.Measure(Current.profile, Current.command);
+					else
+						Current.command->Execute();
+					pc = Current.target;
+					break;
+				case Instruction::Op::Branch:
+					if (manager.profiler.IsEnabled()) [[unlikely]]
+						manager.profiler.Measure(Current.profile, Current.command);
+					else
+						Current.command->Execute();
+					pc = (of_state.Get<int>() ? Current.target : pc + 1);
+					break;
+				case Instruction::Op::Switch:
+				{
+					const auto& Table = event->branch_tables[Current.target];
+					auto& condition = *context.condition_current;
+					const Value& Target = condition.Target();
+					// 型が異なる場合の比較規則は分岐コマンドに任せる。
+					if (Target.GetType() != Table.type) {
+						pc++;
+						break;
+					}
+					// 先頭のelseは、直前のof_stateを反転して判定する。
+					if (Table.has_leading_else && !of_state.Get<int>()) {
+						of_state = 1;
+						pc = Table.leading_else_target;
+						break;
+					}
+
+					uint32 next = Table.default_target;
+					bool matched = false;
+					if (Table.type == Value::Type::Int) {
+						if (auto it = Table.int_targets.find(Target.Get<int>()); it != Table.int_targets.end()) {
+							next = it->second;
+							matched = true;
+						}
+					} else {
+						if (auto it = Table.string_targets.find(Target.Get<std::wstring>()); it != Table.string_targets.end()) {
+							next = it->second;
+							matched = true;
+						}
+					}
+					// 分岐コマンドを順に実行した場合と同じ状態にする。
+					condition.SetResult(matched);
+					of_state = static_cast<int>(matched || Table.has_else);
+					pc = next;
+					break;
+				}
+				case Instruction::Op::Halt:
+					return;
+			}
+			// 分岐の命令も含め、1命令につき1単位の予算を使う。
+			manager.Consume();
+			// 中断が要求されたら(予算を超えた場合を含む)、次の命令から再開できるよう状態を保存して抜ける。
+			// 呼出元のイベントも、callコマンドから戻った所で同様に抜ける。
+			if (manager.is_suspending) [[unlikely]] {
+				if (Current_Frame != nullptr) {
+					auto& saved = manager.suspending.frames.emplace_back();
+					saved.event_name = *Current_Frame->event_name;
+					saved.event = event;
+					saved.generation = event->generation;
+					saved.pc = pc;
+					saved.of_state = of_state.Get<int>();
+					const auto Arguments = context.argument_stack.begin() + Current_Frame->argument_base;
+					saved.arguments.assign(Arguments, Arguments + Current_Frame->argument_count);
+					const auto First = conditions.begin() + std::min(Condition_Depth, conditions.size());
+					for (auto it = First; it != conditions.end(); it++)
+						saved.conditions.push_back(std::move(*it));
+					conditions.erase(First, conditions.end());
+					context.condition_current = (conditions.empty() ? conditions.end() : conditions.end() - 1);
+				}
+				return;
+			}
+		}
+	}
+
+	Manager::LegacyCommandExecuter::LegacyCommandExecuter(const std::list<CommandTree>* commands) {
+		if (commands->empty())
+			return;
+
+		Program::Instance().var_manager.MakeNew(L"of_state") = 1;
+		// ここから、コマンド実行。
+		{
+			const CommandTree *executing = &commands->front();
+			const CommandTree *goal = &commands->back();
+			while (executing != nullptr) {
+				executing->command->Execute();
+				
+				// 親が存在せず、自身がゴールでない場合:
+				// 自身がcaseコマンドなので、他のofコマンド候補を探す。
+				if (executing->parent == nullptr && executing != goal) {
+					auto command_iterator = std::find_if(commands->begin(), commands->end(), [executing](const CommandTree& tree) {
+						return executing == &tree;
+					});
+
+					command_iterator++;
+					while (command_iterator != commands->end()) {
+						if (command_iterator->word == L"of" || command_iterator->word == L"else") {
+							command_iterator->command->Execute();
+							auto can_execute = Program::Instance().var_manager.Get<false>(L"of_state").Get<int>();
+							if (can_execute) {
+								// 実行可能なコマンドなので、ここからコマンド実行。
+								executing = command_iterator->parent;
 								break;
 							}
-							case L',':
-								// J}͖B
-								break;
-							default:
-							not_operator:
-								if (str != L"//") {
-									tree_iterator->text = str;
-									tree.push_front(Syntax{ .parent = &(*tree_iterator) });
-									tree_iterator = tree.begin();
-									break;
-								} else {
-									while (lexical_context->front() != L"\n") {
-										lexical_context->pop_front();
-									}
-									continue;
-								}
 						}
-						lexical_context->pop_front();
+						command_iterator++;
 					}
-					tree.pop_front();
-				}
+				} else
+					executing = executing->parent;
+			}
+		}
+	}
 
-				auto& Result() noexcept {
-					return tree;
-				}
-			};
+	// コマンド名とコマンド生成関数の対応
+	// 組み込みコマンドはコンパイル時に作成した完全ハッシュ表から引き、
+	// DLLが登録したコマンドはDLLの接続・切断があった時にのみ作り直す表から引く。
+	namespace keyword {
+		using Generator = KeywordInfo(*)(const std::vector<std::wstring>&);
 
-			// Ӗ
-			class SemanticParser final {
-				std::list<Syntax*> visited{}, queue{};
-				std::list<std::wstring> stack{};
+		// 組み込みコマンド
+		struct Builtin final {
+			std::wstring_view names[3];		// コマンド名(英語名・日本語名等)
+			Generator generate;
+		};
 
-				std::unordered_map<std::wstring, Event> parsing_events{};
+		// コマンド名に対応する生成関数を返す。存在しない場合は空の関数を返す。
+		GenerateFunc Find(const std::wstring& Name);
 
-				CommandTree* parent = nullptr;
-				WorldVector origin[2]{ { -1, -1 }, { -1, -1 } };
-				TriggerType trigger_type = TriggerType::Invalid;
-				std::wstring event_name;
-				std::vector<std::wstring> params{};
-				std::list<CommandTree> commands{};
-				std::vector<std::wstring> command_parameters{};
-				std::unordered_map<std::wstring, GenerateFunc> words{};
-
-				error::ErrorContent *error_occurred{};
-				inline static error::ErrorContent 
-					*empty_name_error{}, 
-					*invalid_trigger_type_warning{},
-					*command_not_found_error{},
-					*lack_of_parameters_error{},
-					*too_many_parameters_warning{},
-					*already_new_event_name_defined_error{},
-					*already_new_trigger_type_defined_error{};
-			public:
-				SemanticParser() noexcept {
-					if (empty_name_error == nullptr)
-						empty_name_error = error::UserErrorHandler::MakeError(event::Manager::Instance().error_class, L"Cxgɂ邱Ƃ͂ł܂B", MB_OK | MB_ICONERROR, 1);
-					if (invalid_trigger_type_warning == nullptr)
-						invalid_trigger_type_warning = error::UserErrorHandler::MakeError(event::Manager::Instance().error_class, L"sȃCxg^Cvw肳ꂽ߁Aݒ肵܂B", MB_OK | MB_ICONWARNING, 4);
-					if (command_not_found_error == nullptr)
-						command_not_found_error = error::UserErrorHandler::MakeError(event::Manager::Instance().error_class, L"w肳ꂽR}h܂B", MB_OK | MB_ICONERROR, 2);
-					if (lack_of_parameters_error == nullptr)
-						lack_of_parameters_error = error::UserErrorHandler::MakeError(event::Manager::Instance().error_class, L"R}ḧȂׁAł܂B", MB_OK | MB_ICONERROR, 2);
-					if (too_many_parameters_warning == nullptr)
-						too_many_parameters_warning = error::UserErrorHandler::MakeError(event::Manager::Instance().error_class, L"R}ḧׁA]Ȃ͔̂p܂B", MB_OK | MB_ICONWARNING, 3);
-					if (already_new_event_name_defined_error == nullptr)
-						already_new_event_name_defined_error = error::UserErrorHandler::MakeError(event::Manager::Instance().error_class, L"ɃCxgݒ肳Ă܂B", MB_OK | MB_ICONERROR, 1);
-					if (already_new_trigger_type_defined_error == nullptr)
-						already_new_trigger_type_defined_error = error::UserErrorHandler::MakeError(event::Manager::Instance().error_class, L"ɔ^Cvw肳Ă܂B", MB_OK | MB_ICONERROR, 1);
-			
-					Program::Instance().dll_manager.RegisterExternalCommand(&words);
-
-					words[L"text"] =
-						words[L""] = [](const std::vector<std::wstring>& params) -> KeywordInfo
-					{
-						return {
-							.Result = [&]() noexcept -> CommandPtr {
-								const auto [Name, Name_Type] = Default_ProgramInterface.GetParamInfo(params[0]);
-								const auto [X, X_Type] = Default_ProgramInterface.GetParamInfo(params[1]);
-								const auto [Y, Y_Type] = Default_ProgramInterface.GetParamInfo(params[1]);
-								if (Default_ProgramInterface.IsStringType(Name_Type) &&
-									Default_ProgramInterface.IsStringType(X_Type) &&
-									Default_ProgramInterface.IsStringType(Y_Type))
-								{
-									auto [xv, xp] = ToDec<Dec>(X.c_str());
-									auto [yv, yp] = ToDec<Dec>(Y.c_str());
-									return std::make_unique<command::Print>(Name, WorldVector{ xv, yv });
-								} else
-									return std::make_unique<command::Print>(params);
-							},
-							.checkParamState = [params]() -> KeywordInfo::ParamResult {
-								switch (params.size()) {
-									case 0:
-									case 1:
-									case 2:
-										return KeywordInfo::ParamResult::Lack;
-									case 3:
-										return KeywordInfo::ParamResult::Maximum;
-									default:
-										return KeywordInfo::ParamResult::Excess;
-								}
-							},
-							.is_static = false,
-							.is_dynamic = true
-						};
+		constexpr Builtin Builtins[] = {
+			{
+				{ L"text", L"文章" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo
+				{
+					return {
+						.Result = [&]() noexcept -> CommandPtr {
+							const auto [Name, Name_Type] = Default_ProgramInterface.GetParamInfo(params[0]);
+							const auto [X, X_Type] = Default_ProgramInterface.GetParamInfo(params[1]);
+							const auto [Y, Y_Type] = Default_ProgramInterface.GetParamInfo(params[1]);
+							if (Default_ProgramInterface.IsStringType(Name_Type) &&
+								Default_ProgramInterface.IsStringType(X_Type) &&
+								Default_ProgramInterface.IsStringType(Y_Type))
+							{
+								auto [xv, xp] = ToDec<Dec>(X.c_str());
+								auto [yv, yp] = ToDec<Dec>(Y.c_str());
+								return std::make_unique<command::Print>(Name, WorldVector{ xv, yv });
+							} else
+								return std::make_unique<command::Print>(params);
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+								case 1:
+								case 2:
+									return KeywordInfo::ParamResult::Lack;
+								case 3:
+									return KeywordInfo::ParamResult::Maximum;
+								default:
+									return KeywordInfo::ParamResult::Excess;
+							}
+						},
+						.is_static = false,
+						.is_dynamic = true
 					};
-
-					words[L"music"] =
-						words[L"y"] =
-						words[L"BGM"] = [](const std::vector<std::wstring>& params) -> KeywordInfo
-					{
-						return {
-							.Result = [&]() noexcept -> CommandPtr {
-								const auto [Var, Type] = Default_ProgramInterface.GetParamInfo(params[0]);
-								if (Default_ProgramInterface.IsStringType(Type))
-									return std::make_unique<command::Music>(Var);
-								else
-									return std::make_unique<command::Music>(params);
-							},
-							.checkParamState = [params]() -> KeywordInfo::ParamResult {
-								switch (params.size()) {
-									case 1:
-										return KeywordInfo::ParamResult::Maximum;
-									default:
-										return KeywordInfo::ParamResult::Lack;
-								}
-							},
-							.is_static = false,
-							.is_dynamic = true
-						};
+				}
+			},
+			{
+				{ L"music", L"音楽", L"BGM" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo
+				{
+					return {
+						.Result = [&]() noexcept -> CommandPtr {
+							const auto [Var, Type] = Default_ProgramInterface.GetParamInfo(params[0]);
+							if (Default_ProgramInterface.IsStringType(Type))
+								return std::make_unique<command::Music>(Var);
+							else
+								return std::make_unique<command::Music>(params);
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 1:
+									return KeywordInfo::ParamResult::Maximum;
+								default:
+									return KeywordInfo::ParamResult::Lack;
+							}
+						},
+						.is_static = false,
+						.is_dynamic = true
 					};
-
-					words[L"sound"] =
-						words[L"ʉ"] =
-						words[L""] = [](const std::vector<std::wstring>& params) -> KeywordInfo
-					{
-						return {
-							.Result = [&]() noexcept -> CommandPtr {
-								const auto [File_Path, Path_Type] = Default_ProgramInterface.GetParamInfo(params[0]);
-								const auto [Vec_X, X_Type] = Default_ProgramInterface.GetParamInfo(params[1]);
-								const auto [Vec_Y, Y_Type] = Default_ProgramInterface.GetParamInfo(params[2]);
-								if (Default_ProgramInterface.IsStringType(Path_Type) && Default_ProgramInterface.IsNumberType(X_Type) && Default_ProgramInterface.IsNumberType(Y_Type)) {
-									return std::make_unique<command::Sound>(File_Path, WorldVector{ ToDec<Dec>(Vec_X.c_str(), nullptr), ToDec<Dec>(Vec_Y.c_str(), nullptr) });
-								} else {
-									return std::make_unique<command::Sound>(params);
+				}
+			},
+			{
+				{ L"sound", L"効果音", L"音" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo
+				{
+					return {
+						.Result = [&]() noexcept -> CommandPtr {
+							const auto [File_Path, Path_Type] = Default_ProgramInterface.GetParamInfo(params[0]);
+							const auto [Vec_X, X_Type] = Default_ProgramInterface.GetParamInfo(params[1]);
+							const auto [Vec_Y, Y_Type] = Default_ProgramInterface.GetParamInfo(params[2]);
+							if (Default_ProgramInterface.IsStringType(Path_Type) && Default_ProgramInterface.IsNumberType(X_Type) && Default_ProgramInterface.IsNumberType(Y_Type)) {
+								return std::make_unique<command::Sound>(File_Path, WorldVector{ ToDec<Dec>(Vec_X.c_str(), nullptr), ToDec<Dec>(Vec_Y.c_str(), nullptr) });
+							} else {
+								return std::make_unique<command::Sound>(params);
+							}
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+								case 1:
+								case 2:
+									return KeywordInfo::ParamResult::Lack;
+								case 3:
+									return KeywordInfo::ParamResult::Maximum;
+								default:
+									return KeywordInfo::ParamResult::Excess;
+							}
+						},
+						.is_static = false,
+						.is_dynamic = true
+					};
+				}
+			},
+			{
+				{ L"image", L"画像", L"絵" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo
+				{
+					return {
+						.Result = [&]() noexcept -> CommandPtr {
+							const auto [File_Path, Path_Type] = Default_ProgramInterface.GetParamInfo(params[0]);
+							const auto [Vec_X, VX_Type] = Default_ProgramInterface.GetParamInfo(params[1]);
+							const auto [Vec_Y, VY_Type] = Default_ProgramInterface.GetParamInfo(params[2]);
+							const auto [Len_X, LX_Type] = Default_ProgramInterface.GetParamInfo(params[3]);
+							const auto [Len_Y, LY_Type] = Default_ProgramInterface.GetParamInfo(params[4]);
+
+							if (Default_ProgramInterface.IsStringType(Path_Type) &&
+								Default_ProgramInterface.IsNumberType(VX_Type) &&
+								Default_ProgramInterface.IsNumberType(VY_Type) &&
+								Default_ProgramInterface.IsNumberType(LX_Type) &&
+								Default_ProgramInterface.IsNumberType(LY_Type))
+							{
+								return std::make_unique<command::Image>(File_Path,
+									WorldVector{ ToDec<Dec>(Vec_X.c_str(), nullptr), ToDec<Dec>(Vec_Y.c_str(), nullptr) },
+									WorldVector{ ToDec<Dec>(Len_X.c_str(), nullptr), ToDec<Dec>(Len_Y.c_str(), nullptr) });
+							} else {
+								return std::make_unique<command::Image>(params);
+							}
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+								case 1:
+								case 2:
+								case 3:
+								case 4:
+									return KeywordInfo::ParamResult::Lack;
+								case 5:
+									return KeywordInfo::ParamResult::Maximum;
+								default:
+									return KeywordInfo::ParamResult::Excess;
+							}
+						},
+						.is_static = false,
+						.is_dynamic = true
+					};
+				}
+			},
+			{
+				{ L"freeze", L"凍結" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo
+				{
+					return {
+						.Result = [&]() noexcept -> CommandPtr {
+							const auto [Name, Name_Type] = Default_ProgramInterface.GetParamInfo(params[0]);
+							if (Default_ProgramInterface.IsStringType(Name_Type)) {
+								return std::make_unique<command::entity::Freeze>(Name);
+							} else {
+								return std::make_unique<command::entity::Freeze>(params);
+							}
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+									return KeywordInfo::ParamResult::Lack;
+								case 1:
+									return KeywordInfo::ParamResult::Maximum;
+								default:
+									return KeywordInfo::ParamResult::Excess;
+							}
+						},
+						.is_static = false,
+						.is_dynamic = true
+					};
+				}
+			},
+			{
+				{ L"defrost", L"解凍" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo
+				{
+					return {
+						.Result = [&]() noexcept -> CommandPtr {
+							const auto [Name, Name_Type] = Default_ProgramInterface.GetParamInfo(params[0]);
+							if (Default_ProgramInterface.IsStringType(Name_Type)) {
+								return std::make_unique<command::entity::Defrost>(Name);
+							} else {
+								return std::make_unique<command::entity::Defrost>(params);
+							}
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+									return KeywordInfo::ParamResult::Lack;
+								case 1:
+									return KeywordInfo::ParamResult::Maximum;
+								default:
+									return KeywordInfo::ParamResult::Excess;
+							}
+						},
+						.is_static = false,
+						.is_dynamic = true
+					};
+				}
+			},
+			{
+				{ L"animation", L"アニメ" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo
+				{
+					return {
+						.Result = [&]() noexcept -> CommandPtr {
+							const auto [Var_Name, Var_Type] = Default_ProgramInterface.GetParamInfo(params[0]);
+							if (Default_ProgramInterface.IsNoType(Var_Type))
+								return std::make_unique<command::Animation>(Var_Name);
+							else
+								return nullptr;
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+									return KeywordInfo::ParamResult::Lack;
+								case 1:
+									return KeywordInfo::ParamResult::Maximum;
+								default:
+									return KeywordInfo::ParamResult::Excess;
+							}
+						},
+						.is_static = false,
+						.is_dynamic = true
+					};
+				}
+			},
+			{
+				{ L"addframe", L"フレーム追加" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo
+				{
+					return {
+						.Result = [&]() noexcept -> CommandPtr {
+							const auto [Var_Name, Var_Type] = Default_ProgramInterface.GetParamInfo(params[0]);
+							const auto [Path, Path_Type] = Default_ProgramInterface.GetParamInfo(params[1]);
+							if (Default_ProgramInterface.IsNoType(Var_Type) && Default_ProgramInterface.IsStringType(Path_Type))
+								return std::make_unique<command::AddFrame>(Var_Name, Path);
+							else
+								return std::make_unique<command::AddFrame>(params);
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+								case 1:
+									return KeywordInfo::ParamResult::Lack;
+								case 2:
+									return KeywordInfo::ParamResult::Maximum;
+								default:
+									return KeywordInfo::ParamResult::Excess;
+							}
+						},
+						.is_static = false,
+						.is_dynamic = true
+					};
+				}
+			},
+			{
+				{ L"nextframe", L"次フレーム" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo
+				{
+					return {
+						.Result = [&]() noexcept -> CommandPtr {
+							const auto [Var_Name, Var_Type] = Default_ProgramInterface.GetParamInfo(params[0]);
+							if (Default_ProgramInterface.IsNoType(Var_Type))
+								return std::make_unique<command::NextFrame>(Var_Name);
+							else
+								return nullptr;
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+									return KeywordInfo::ParamResult::Lack;
+								case 1:
+									return KeywordInfo::ParamResult::Maximum;
+								default:
+									return KeywordInfo::ParamResult::Excess;
+							}
+						},
+						.is_static = false,
+						.is_dynamic = true
+					};
+				}
+			},
+			{
+				{ L"backframe", L"前フレーム" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo
+				{
+					return {
+						.Result = [&]() noexcept -> CommandPtr {
+							const auto [Var_Name, Var_Type] = Default_ProgramInterface.GetParamInfo(params[0]);
+							if (Default_ProgramInterface.IsNoType(Var_Type))
+								return std::make_unique<command::BackFrame>(Var_Name);
+							else
+								return nullptr;
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+									return KeywordInfo::ParamResult::Lack;
+								case 1:
+									return KeywordInfo::ParamResult::Maximum;
+								default:
+									return KeywordInfo::ParamResult::Excess;
+							}
+						},
+						.is_static = false,
+						.is_dynamic = true
+					};
+				}
+			},
+			{
+				{ L"capture", L"画像切取" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo
+				{
+					return {
+						.Result = [&]() noexcept -> CommandPtr {
+							const auto [Var_Name, Var_Type] = Default_ProgramInterface.GetParamInfo(params[0]);
+							const auto [File_Path, Path_Type] = Default_ProgramInterface.GetParamInfo(params[1]);
+							const auto [Vec_X, VX_Type] = Default_ProgramInterface.GetParamInfo(params[2]);
+							const auto [Vec_Y, VY_Type] = Default_ProgramInterface.GetParamInfo(params[3]);
+							const auto [Len_X, LX_Type] = Default_ProgramInterface.GetParamInfo(params[4]);
+							const auto [Len_Y, LY_Type] = Default_ProgramInterface.GetParamInfo(params[5]);
+
+							if (Default_ProgramInterface.IsNoType(Var_Type) &&
+								Default_ProgramInterface.IsStringType(Path_Type) &&
+								Default_ProgramInterface.IsNumberType(VX_Type) &&
+								Default_ProgramInterface.IsNumberType(VY_Type) &&
+								Default_ProgramInterface.IsNumberType(LX_Type) &&
+								Default_ProgramInterface.IsNumberType(LY_Type))
+							{
+								return std::make_unique<command::Capture>(Var_Name,
+									File_Path,
+									ScreenVector{ ToInt(Vec_X.c_str(), nullptr), ToInt(Vec_Y.c_str(), nullptr) },
+									ScreenVector{ ToInt(Len_X.c_str(), nullptr), ToInt(Len_Y.c_str(), nullptr) });
+							} else {
+								return std::make_unique<command::Capture>(params);
+							}
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+								case 1:
+								case 2:
+								case 3:
+								case 4:
+								case 5:
+									return KeywordInfo::ParamResult::Lack;
+								case 6:
+									return KeywordInfo::ParamResult::Maximum;
+								default:
+									return KeywordInfo::ParamResult::Excess;
+							}
+						},
+						.is_static = false,
+						.is_dynamic = true
+					};
+				}
+			},
+			{
+				{ L"button", L"ボタン" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo {
+					return {
+						.Result = [&]() noexcept -> CommandPtr {
+							switch (params.size()) {
+								case 3:
+								{
+									const auto [Name, Name_Type] = Default_ProgramInterface.GetParamInfo(params[0]);
+									const auto [VX, VX_Type] = Default_ProgramInterface.GetParamInfo(params[1]);
+									const auto [VY, VY_Type] = Default_ProgramInterface.GetParamInfo(params[2]);
+									if (Default_ProgramInterface.IsStringType(Name_Type) &&
+										Default_ProgramInterface.IsNumberType(VX_Type) &&
+										Default_ProgramInterface.IsNumberType(VY_Type))
+									{
+										return std::make_unique<command::Button>(
+											Name,
+											WorldVector{ ToDec<Dec>(VX.c_str(), nullptr), ToDec<Dec>(VY.c_str(), nullptr) },
+											L"",
+											WorldVector{ 0.0, 0.0 }
+										);
+									} else {
+										return std::make_unique<command::Button>(params);
+									}
+									break;
 								}
-							},
-							.checkParamState = [params]() -> KeywordInfo::ParamResult {
-								switch (params.size()) {
-									case 0:
-									case 1:
-									case 2:
-										return KeywordInfo::ParamResult::Lack;
-									case 3:
-										return KeywordInfo::ParamResult::Maximum;
-									default:
-										return KeywordInfo::ParamResult::Excess;
+								case 6:
+								{
+									const auto [Name, Name_Type] = Default_ProgramInterface.GetParamInfo(params[0]);
+									const auto [VX, VX_Type] = Default_ProgramInterface.GetParamInfo(params[1]);
+									const auto [VY, VY_Type] = Default_ProgramInterface.GetParamInfo(params[2]);
+									const auto [SX, SX_Type] = Default_ProgramInterface.GetParamInfo(params[3]);
+									const auto [SY, SY_Type] = Default_ProgramInterface.GetParamInfo(params[4]);
+									const auto [Img, Img_Type] = Default_ProgramInterface.GetParamInfo(params[5]);
+									if (Default_ProgramInterface.IsStringType(Name_Type) &&
+										Default_ProgramInterface.IsNumberType(VX_Type) &&
+										Default_ProgramInterface.IsNumberType(VY_Type) &&
+										Default_ProgramInterface.IsStringType(Img_Type) &&
+										Default_ProgramInterface.IsNumberType(SX_Type) &&
+										Default_ProgramInterface.IsNumberType(SY_Type))
+									{
+										return std::make_unique<command::Button>(
+											Name,
+											WorldVector{ ToDec<Dec>(VX.c_str(), nullptr), ToDec<Dec>(VY.c_str(), nullptr) },
+											Img,
+											WorldVector{ ToDec<Dec>(SX.c_str(), nullptr), ToDec<Dec>(SY.c_str(), nullptr) }
+										);
+									} else {
+										return std::make_unique<command::Button>(params);
+									}
+									break;
 								}
-							},
-							.is_static = false,
-							.is_dynamic = true
-						};
+							}
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+								case 1:
+								case 2:
+									return KeywordInfo::ParamResult::Lack;
+								case 3:
+									return KeywordInfo::ParamResult::Medium;
+								case 4:
+								case 5:
+									return KeywordInfo::ParamResult::Lack;
+								case 6:
+									return KeywordInfo::ParamResult::Maximum;
+								default:
+									return KeywordInfo::ParamResult::Excess;
+							}
+						},
+						.is_static = false,
+						.is_dynamic = true
 					};
-
-					words[L"image"] =
-						words[L"摜"] =
-						words[L"G"] = [](const std::vector<std::wstring>& params) -> KeywordInfo
-					{
-						return {
+				}
+			},
+			{
+				{ L"input", L"入力" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo {
+					return {
 							.Result = [&]() noexcept -> CommandPtr {
-								const auto [File_Path, Path_Type] = Default_ProgramInterface.GetParamInfo(params[0]);
-								const auto [Vec_X, VX_Type] = Default_ProgramInterface.GetParamInfo(params[1]);
-								const auto [Vec_Y, VY_Type] = Default_ProgramInterface.GetParamInfo(params[2]);
-								const auto [Len_X, LX_Type] = Default_ProgramInterface.GetParamInfo(params[3]);
-								const auto [Len_Y, LY_Type] = Default_ProgramInterface.GetParamInfo(params[4]);
-
-								if (Default_ProgramInterface.IsStringType(Path_Type) &&
-									Default_ProgramInterface.IsNumberType(VX_Type) &&
-									Default_ProgramInterface.IsNumberType(VY_Type) &&
-									Default_ProgramInterface.IsNumberType(LX_Type) &&
-									Default_ProgramInterface.IsNumberType(LY_Type))
-								{
-									return std::make_unique<command::Image>(File_Path,
-										WorldVector{ ToDec<Dec>(Vec_X.c_str(), nullptr), ToDec<Dec>(Vec_Y.c_str(), nullptr) },
-										WorldVector{ ToDec<Dec>(Len_X.c_str(), nullptr), ToDec<Dec>(Len_Y.c_str(), nullptr) });
-								} else {
-									return std::make_unique<command::Image>(params);
-								}
+								return std::make_unique<command::Input>(params);
 							},
 							.checkParamState = [params]() -> KeywordInfo::ParamResult {
 								switch (params.size()) {
@@ -2688,9 +3740,8 @@ namespace karapo::event {
 									case 1:
 									case 2:
 									case 3:
-									case 4:
 										return KeywordInfo::ParamResult::Lack;
-									case 5:
+									case 4:
 										return KeywordInfo::ParamResult::Maximum;
 									default:
 										return KeywordInfo::ParamResult::Excess;
@@ -2698,1713 +3749,4564 @@ namespace karapo::event {
 							},
 							.is_static = false,
 							.is_dynamic = true
-						};
 					};
-
-					words[L"freeze"] =
-						words[L""] = [](const std::vector<std::wstring>& params) -> KeywordInfo
-					{
-						return {
-							.Result = [&]() noexcept -> CommandPtr {
-								const auto [Name, Name_Type] = Default_ProgramInterface.GetParamInfo(params[0]);
-								if (Default_ProgramInterface.IsStringType(Name_Type)) {
-									return std::make_unique<command::entity::Freeze>(Name);
-								} else {
-									return std::make_unique<command::entity::Freeze>(params);
-								}
-							},
-							.checkParamState = [params]() -> KeywordInfo::ParamResult {
-								switch (params.size()) {
-									case 0:
-										return KeywordInfo::ParamResult::Lack;
-									case 1:
-										return KeywordInfo::ParamResult::Maximum;
-									default:
-										return KeywordInfo::ParamResult::Excess;
-								}
-							},
-							.is_static = false,
-							.is_dynamic = true
-						};
+				}
+			},
+			{
+				{ L"teleport", L"瞬間移動" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo {
+					return {
+						.Result = [&]() noexcept -> CommandPtr {
+							const auto [Target, Target_Type] = Default_ProgramInterface.GetParamInfo(params[0]);
+							const auto [X, X_Type] = Default_ProgramInterface.GetParamInfo(params[1]);
+							const auto [Y, Y_Type] = Default_ProgramInterface.GetParamInfo(params[2]);
+							if (Default_ProgramInterface.IsStringType(Target_Type) && Default_ProgramInterface.IsNumberType(X_Type) && Default_ProgramInterface.IsNumberType(Y_Type)) {
+								return std::make_unique<command::entity::Teleport>(
+									Target,
+									WorldVector{ ToDec<Dec>(X.c_str(), nullptr), ToDec<Dec>(Y.c_str(), nullptr)
+								});
+							} else {
+								return std::make_unique<command::entity::Teleport>(params);
+							}
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+								case 1:
+								case 2:
+									return KeywordInfo::ParamResult::Lack;
+								case 3:
+									return KeywordInfo::ParamResult::Maximum;
+								default:
+									return KeywordInfo::ParamResult::Excess;
+							}
+						},
+						.is_static = false,
+						.is_dynamic = true
 					};
-
-					words[L"defrost"] =
-						words[L""] = [](const std::vector<std::wstring>& params) -> KeywordInfo
-					{
-						return {
-							.Result = [&]() noexcept -> CommandPtr {
-								const auto [Name, Name_Type] = Default_ProgramInterface.GetParamInfo(params[0]);
-								if (Default_ProgramInterface.IsStringType(Name_Type)) {
-									return std::make_unique<command::entity::Defrost>(Name);
+				}
+			},
+			{
+				{ L"kill", L"殺害" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo {
+					return {
+						.Result = [&]() noexcept -> CommandPtr {
+							const auto [Var, Type] = Default_ProgramInterface.GetParamInfo(params[0]);
+							if (Default_ProgramInterface.IsStringType(Type))
+								return std::make_unique<command::entity::Kill>(Var);
+							else
+								return std::make_unique<command::entity::Kill>(params);
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+									return KeywordInfo::ParamResult::Lack;
+								case 1:
+									return KeywordInfo::ParamResult::Maximum;
+								default:
+									return KeywordInfo::ParamResult::Excess;
+							}
+						},
+						.is_static = false,
+						.is_dynamic = true
+					};
+				}
+			},
+			{
+				{ L"makelayer", L"レイヤー生成" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo {
+					return {
+						.Result = [&]() noexcept -> CommandPtr {
+							const auto [Index, Index_Type] = Default_ProgramInterface.GetParamInfo(params[0]);
+							const auto [Kind, Kind_Type] = Default_ProgramInterface.GetParamInfo(params[1]);
+							const auto [Name, Name_Type] = Default_ProgramInterface.GetParamInfo(params[2]);
+							if (Default_ProgramInterface.IsNumberType(Index_Type) &&
+								Default_ProgramInterface.IsStringType(Kind_Type) &&
+								Default_ProgramInterface.IsStringType(Name_Type))
+							{
+								auto i = ToInt<int>(Index.c_str(), nullptr);
+								return std::make_unique<command::layer::Make>(i, Kind, Name);
+							} else
+								return std::make_unique<command::layer::Make>(params);
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+								case 1:
+								case 2:
+									return KeywordInfo::ParamResult::Lack;
+								case 3:
+									return KeywordInfo::ParamResult::Maximum;
+								default:
+									return KeywordInfo::ParamResult::Excess;
+							}
+						},
+						.is_static = false,
+						.is_dynamic = true
+					};
+				}
+			},
+			{
+				{ L"setbasis", L"レイヤー基準" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo {
+					return {
+						.Result = [&]() noexcept -> CommandPtr {
+							const auto [Entity_Name, Entity_Name_Type] = Default_ProgramInterface.GetParamInfo(params[0]);
+							const auto [Layer_Name, Layer_Name_Type] = Default_ProgramInterface.GetParamInfo(params[1]);
+							if (Default_ProgramInterface.IsStringType(Entity_Name_Type) && Default_ProgramInterface.IsStringType(Layer_Name_Type))
+								return std::make_unique<command::layer::SetBasis>(Entity_Name, Layer_Name);
+							else
+								return std::make_unique<command::layer::SetBasis>(params);
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+								case 1:
+									return KeywordInfo::ParamResult::Lack;
+								case 2:
+									return KeywordInfo::ParamResult::Maximum;
+								default:
+									return KeywordInfo::ParamResult::Excess;
+							}
+						},
+						.is_static = false,
+						.is_dynamic = true
+					};
+				}
+			},
+			{
+				{ L"selectlayer", L"レイヤー選択" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo {
+					return {
+						.Result = [&]() noexcept -> CommandPtr {
+							const auto [Name, Name_Type] = Default_ProgramInterface.GetParamInfo(params[0]);
+							if (Default_ProgramInterface.IsStringType(Name_Type))
+								return std::make_unique<command::layer::Select>(Name);
+							else
+								return std::make_unique<command::layer::Select>(params);
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+									return KeywordInfo::ParamResult::Lack;
+								case 1:
+									return KeywordInfo::ParamResult::Maximum;
+								default:
+									return KeywordInfo::ParamResult::Excess;
+							}
+						},
+						.is_static = false,
+						.is_dynamic = true
+					};
+				}
+			},
+			{
+				{ L"deletelayer", L"レイヤー削除" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo {
+					return {
+						.Result = [&]() noexcept -> CommandPtr {
+							const auto [Name, Name_Type] = Default_ProgramInterface.GetParamInfo(params[0]);
+							if (Default_ProgramInterface.IsStringType(Name_Type))
+								return std::make_unique<command::layer::Delete>(Name);
+							else
+								return std::make_unique<command::layer::Delete>(params);
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+									return KeywordInfo::ParamResult::Lack;
+								case 1:
+									return KeywordInfo::ParamResult::Maximum;
+								default:
+									return KeywordInfo::ParamResult::Excess;
+							}
+						},
+						.is_static = false,
+						.is_dynamic = true
+					};
+				}
+			},
+			{
+				{ L"showlayer", L"レイヤー表示" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo {
+					return {
+						.Result = [&]() noexcept -> CommandPtr {
+							const auto [Name, Name_Type] = Default_ProgramInterface.GetParamInfo(params[0]);
+							return (Default_ProgramInterface.IsStringType(Name_Type) ?
+								std::make_unique<command::layer::Show>(Name) : std::make_unique<command::layer::Show>(params));
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+									return KeywordInfo::ParamResult::Lack;
+								case 1:
+									return KeywordInfo::ParamResult::Maximum;
+								default:
+									return KeywordInfo::ParamResult::Excess;
+							}
+						},
+						.is_static = false,
+						.is_dynamic = true
+					};
+				}
+			},
+			{
+				{ L"hidelayer", L"レイヤー非表示" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo {
+					return {
+						.Result = [&]() noexcept -> CommandPtr {
+							const auto [Name, Name_Type] = Default_ProgramInterface.GetParamInfo(params[0]);
+							return (Default_ProgramInterface.IsStringType(Name_Type) ?
+								std::make_unique<command::layer::Hide>(Name) : std::make_unique<command::layer::Hide>(params));
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+									return KeywordInfo::ParamResult::Lack;
+								case 1:
+									return KeywordInfo::ParamResult::Maximum;
+								default:
+									return KeywordInfo::ParamResult::Excess;
+							}
+						},
+						.is_static = false,
+						.is_dynamic = true
+					};
+				}
+			},
+			{
+				{ L"bind", L"キー" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo {
+					return {
+					.Result = [&]() -> CommandPtr {
+						const auto [Base, Base_Type] = Default_ProgramInterface.GetParamInfo(params[0]);
+						const auto [Cmd, Cmd_Type] = Default_ProgramInterface.GetParamInfo(params[1]);
+						if (Default_ProgramInterface.IsStringType(Base_Type)) {
+							std::wstring sub_param = Cmd + L' ';
+							for (auto it = params.begin() + 2; it != params.end(); it++) {
+								auto [word, word_type] = Default_ProgramInterface.GetParamInfo(*it);
+								if (Default_ProgramInterface.IsStringType(word_type)) {
+									sub_param += L'\'' + word + L'\'' + std::wstring(L" ");
+								} else {
+									sub_param += word + std::wstring(L" ");
+								}
+							}
+							return std::make_unique<command::Bind>(Base, sub_param);
+						} else
+							return nullptr;
+					},
+					.checkParamState = [&]() -> KeywordInfo::ParamResult {
+						if (params.size() <= 1) {
+							return KeywordInfo::ParamResult::Lack;
+						}
+
+						const auto [Cmd, Cmd_Type] = Default_ProgramInterface.GetParamInfo(params[1]);
+						const auto Generate = Find(Cmd);
+						if (Generate == nullptr)
+							return KeywordInfo::ParamResult::Lack;
+
+						std::vector<std::wstring> exparams{};
+						for (auto it = params.begin() + 2; it < params.end(); it++) {
+							exparams.push_back(*it);
+						}
+						return Generate(exparams).checkParamState();
+					},
+					.is_static = false,
+					.is_dynamic = true
+					};
+				}
+			},
+			{
+				{ L"alias", L"別名" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo {
+					return {
+						.Result = [&]() -> CommandPtr {
+							const auto [Base, Base_Type] = Default_ProgramInterface.GetParamInfo(params[0]);
+							const auto [New_One, New_Type] = Default_ProgramInterface.GetParamInfo(params[1]);
+							if (Default_ProgramInterface.IsNoType(Base_Type) && Default_ProgramInterface.IsNoType(New_Type))
+								return std::make_unique<command::Alias>(Base, New_One);
+							else
+								return nullptr;
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+								case 1:
+									return KeywordInfo::ParamResult::Lack;
+								case 2:
+									return KeywordInfo::ParamResult::Maximum;
+								default:
+									return KeywordInfo::ParamResult::Excess;
+							}
+						},
+						.is_static = true,
+						.is_dynamic = false
+					};
+				}
+			},
+			// DLLアタッチ
+			{
+				{ L"attach", L"接続" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo {
+					return {
+						.Result = [&]() -> CommandPtr {
+							const auto [Var, Type] = Default_ProgramInterface.GetParamInfo(params[0]);
+							return (Default_ProgramInterface.IsStringType(Type) ?
+								std::make_unique<command::Attach>(Var) : nullptr);
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+									return KeywordInfo::ParamResult::Lack;
+								case 1:
+									return KeywordInfo::ParamResult::Maximum;
+								default:
+									return KeywordInfo::ParamResult::Excess;
+							}
+						},
+						.is_static = true,
+						.is_dynamic = false
+					};
+				}
+			},
+			// DLLデタッチ
+			{
+				{ L"detach", L"切断" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo {
+					return {
+						.Result = [&]() -> CommandPtr {
+							const auto [Var, Type] = Default_ProgramInterface.GetParamInfo(params[0]);
+							return (Default_ProgramInterface.IsStringType(Type) ?
+								std::make_unique<command::Detach>(Var) : nullptr);
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+									return KeywordInfo::ParamResult::Lack;
+								case 1:
+									return KeywordInfo::ParamResult::Maximum;
+								default:
+									return KeywordInfo::ParamResult::Excess;
+							}
+						},
+						.is_static = true,
+						.is_dynamic = false
+					};
+				}
+			},
+			// 外部イベントファイル読み込み
+			{
+				{ L"load", L"読込" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo {
+					return {
+						.Result = [&]() -> CommandPtr {
+							const auto [Path, Path_Type] = Default_ProgramInterface.GetParamInfo(params[0]);
+							return (Default_ProgramInterface.IsStringType(Path_Type) ?
+								std::make_unique<command::Load>(Path) : std::make_unique<command::Load>(params));
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+									return KeywordInfo::ParamResult::Lack;
+								case 1:
+									return KeywordInfo::ParamResult::Maximum;
+								default:
+									return KeywordInfo::ParamResult::Excess;
+							}
+						},
+						.is_static = false,
+						.is_dynamic = true
+					};
+				}
+			},
+			// 外部イベントファイル読み込み
+			{
+				{ L"import", L"取込" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo {
+					return {
+						.Result = [&]() -> CommandPtr {
+							// 全て文字列であれば、生成時に確定させる。
+							std::vector<std::wstring> paths{};
+							for (const auto& Param : params) {
+								const auto [Path, Path_Type] = Default_ProgramInterface.GetParamInfo(Param);
+								if (!Default_ProgramInterface.IsStringType(Path_Type))
+									return std::make_unique<command::Import>(params);
+								paths.push_back(Path);
+							}
+							return std::make_unique<command::Import>(paths, nullptr);
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+									return KeywordInfo::ParamResult::Lack;
+								default:
+									return KeywordInfo::ParamResult::Medium;
+							}
+						},
+						.is_static = false,
+						.is_dynamic = true
+					};
+				}
+			},
+			{
+				{ L"call", L"呼出" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo {
+					return {
+						.Result = [&]() -> CommandPtr {
+							return std::make_unique<command::Call>(params);
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+									return KeywordInfo::ParamResult::Lack;
+								default:
+									return KeywordInfo::ParamResult::Medium;
+							}
+						},
+						.is_static = false,
+						.is_dynamic = true
+					};
+				}
+			},
+			{
+				{ L"wait", L"待機" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo {
+					return {
+						.Result = [&]() -> CommandPtr {
+							return std::make_unique<command::Wait>(params);
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+									return KeywordInfo::ParamResult::Lack;
+								case 1:
+									return KeywordInfo::ParamResult::Medium;
+								case 2:
+									return KeywordInfo::ParamResult::Maximum;
+								default:
+									return KeywordInfo::ParamResult::Excess;
+							}
+						},
+						.is_static = false,
+						.is_dynamic = true
+					};
+				}
+			},
+			{
+				{ L"waituntil", L"条件待機" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo {
+					return {
+						.Result = [&]() -> CommandPtr {
+							return std::make_unique<command::WaitUntil>(params);
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+								case 1:
+									return KeywordInfo::ParamResult::Lack;
+								case 2:
+									return KeywordInfo::ParamResult::Medium;
+								case 3:
+									return KeywordInfo::ParamResult::Maximum;
+								default:
+									return KeywordInfo::ParamResult::Excess;
+							}
+						},
+						.is_static = false,
+						.is_dynamic = true
+					};
+				}
+			},
+			{
+				{ L"yield", L"中断" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo {
+					return {
+						.Result = [&]() -> CommandPtr {
+							return std::make_unique<command::Yield>();
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+									return KeywordInfo::ParamResult::Maximum;
+								default:
+									return KeywordInfo::ParamResult::Excess;
+							}
+						},
+						.is_static = false,
+						.is_dynamic = true
+					};
+				}
+			},
+			{
+				{ L"profile", L"計測" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo {
+					return {
+						.Result = [&]() -> CommandPtr {
+							return std::make_unique<command::Profile>(params);
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+									return KeywordInfo::ParamResult::Lack;
+								case 1:
+									return KeywordInfo::ParamResult::Medium;
+								case 2:
+									return KeywordInfo::ParamResult::Maximum;
+								default:
+									return KeywordInfo::ParamResult::Excess;
+							}
+						},
+						.is_static = false,
+						.is_dynamic = true
+					};
+				}
+			},
+			{
+				{ L"var", L"変数" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo {
+					return {
+						.Result = [&]() -> CommandPtr {
+							const auto [Var, Var_Type] = Default_ProgramInterface.GetParamInfo(params[0]);
+							const auto [Value, Value_Type] = Default_ProgramInterface.GetParamInfo(params[1]);
+							if (Var_Type == L"")
+								return std::make_unique<command::Variable>(Var, Value);
+							else
+								return std::make_unique<command::Variable>(params);
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+								case 1:
+									return KeywordInfo::ParamResult::Lack;
+								case 2:
+									return KeywordInfo::ParamResult::Maximum;
+								default:
+									return KeywordInfo::ParamResult::Excess;
+							}
+						},
+						.is_static = true,
+						.is_dynamic = false
+					};
+				}
+			},
+			{
+				{ L"global", L"大域" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo {
+					return {
+						.Result = [&]() -> CommandPtr {
+							const auto [Var, Var_Type] = Default_ProgramInterface.GetParamInfo(params[0]);
+							const auto [Value, Value_Type] = Default_ProgramInterface.GetParamInfo(params[1]);
+							if (Var_Type == L"")
+								return std::make_unique<command::Global>(Var, Value);
+							else
+								return std::make_unique<command::Global>(params);
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+								case 1:
+									return KeywordInfo::ParamResult::Lack;
+								case 2:
+									return KeywordInfo::ParamResult::Maximum;
+								default:
+									return KeywordInfo::ParamResult::Excess;
+							}
+						},
+						.is_static = true,
+						.is_dynamic = false
+					};
+				}
+			},
+			{
+				{ L"exist", L"存在確認" },
+				[](const std::vector<std::wstring>& params)->KeywordInfo {
+					return {
+						.Result = [&]() -> CommandPtr {
+							return std::make_unique<command::Exist>(params);
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+								case 1:
+									return KeywordInfo::ParamResult::Lack;
+								case 2:
+									return KeywordInfo::ParamResult::Maximum;
+								default:
+									return KeywordInfo::ParamResult::Excess;
+							}
+						},
+						.is_static = false,
+						.is_dynamic = true
+					};
+				}
+			},
+			{
+				{ L"filter", L"フィルター" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo {
+					return {
+						.Result = [&]() -> CommandPtr {
+							const auto [Layer_Name, Layer_Name_Type] = Default_ProgramInterface.GetParamInfo(params[0]);
+							const auto [Filter_Name, Filter_Name_Type] = Default_ProgramInterface.GetParamInfo(params[1]);
+							const auto [Potency_Value, Potency_Value_Type] = Default_ProgramInterface.GetParamInfo(params[2]);
+							if (Default_ProgramInterface.IsStringType(Layer_Name_Type) &&
+								Default_ProgramInterface.IsStringType(Filter_Name_Type) &&
+								Default_ProgramInterface.IsNumberType(Potency_Value_Type))
+							{
+								const auto Potency = std::stoi(Potency_Value);
+								return std::make_unique<command::Filter>(Layer_Name, Filter_Name, Potency);
+							} else {
+								return std::make_unique<command::Filter>(params);
+							}
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+								case 1:
+								case 2:
+									return KeywordInfo::ParamResult::Lack;
+								case 3:
+									return KeywordInfo::ParamResult::Maximum;
+								default:
+									return KeywordInfo::ParamResult::Excess;
+							}
+						},
+						.is_static = false,
+						.is_dynamic = true
+					};
+				}
+			},
+			{
+				{ L"case", L"条件" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo {
+					return {
+						.Result = [&]() -> CommandPtr {
+							const auto [Var, Var_Type] = Default_ProgramInterface.GetParamInfo(params[0]);
+							if (!Default_ProgramInterface.IsUndecidedType(Var_Type))
+								return std::make_unique<command::Case>(Var);
+							else
+								return std::make_unique<command::Case>(params);
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+									return KeywordInfo::ParamResult::Lack;
+								case 1:
+									return KeywordInfo::ParamResult::Maximum;
+								default:
+									return KeywordInfo::ParamResult::Excess;
+							}
+						},
+						.is_static = false,
+						.is_dynamic = true
+					};
+				}
+			},
+			{
+				{ L"of", L"分岐" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo {
+					return {
+						.Result = [&]() -> CommandPtr {
+							if (params.size() == 1) {
+								const auto [Var, Type] = Default_ProgramInterface.GetParamInfo(params[0]);
+								if (Default_ProgramInterface.IsNumberType(Type)) {
+									auto [iv, ip] = ToInt(Var.c_str());
+									auto [fv, fp] = ToDec<Dec>(Var.c_str());
+
+									if (wcslen(ip) <= 0)
+										return std::make_unique<command::Of>(L"==", iv);
+									else
+										return std::make_unique<command::Of>(L"==", fv);
+								} else if (Default_ProgramInterface.IsStringType(Type)) {
+									return std::make_unique<command::Of>(L"==", Var);
+								} else {
+									return std::make_unique<command::Of>(std::vector<std::wstring>{ L"==", params[0] });
+								}
+							} else {
+								auto [mode, mode_type] = Default_ProgramInterface.GetParamInfo(params[0]);
+								const auto [Var, Type] = Default_ProgramInterface.GetParamInfo(params[1]);
+
+								mode = mode.substr(mode.find(L'.') + 1);
+								if (Default_ProgramInterface.IsNumberType(Type)) {
+									auto [iv, ip] = ToInt(Var.c_str());
+									auto [fv, fp] = ToDec<Dec>(Var.c_str());
+									if (wcslen(ip) <= 0)
+										return std::make_unique<command::Of>(mode, iv);
+									else
+										return std::make_unique<command::Of>(mode, fv);
+								} else if (Default_ProgramInterface.IsStringType(Type)) {
+									return std::make_unique<command::Of>(mode, Var);
+								} else {
+									return std::make_unique<command::Of>(params);
+								}
+							}
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+									return KeywordInfo::ParamResult::Lack;
+								case 1:
+									return KeywordInfo::ParamResult::Medium;
+								case 2:
+									return KeywordInfo::ParamResult::Maximum;
+								default:
+									return KeywordInfo::ParamResult::Excess;
+							}
+						},
+						.is_static = false,
+						.is_dynamic = true
+					};
+				}
+			},
+			{
+				{ L"else", L"以外" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo {
+					return {
+						.Result = [&]() -> CommandPtr {
+							return std::make_unique<command::Else>();
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+									return KeywordInfo::ParamResult::Maximum;
+								default:
+									return KeywordInfo::ParamResult::Excess;
+							}
+						},
+						.is_static = false,
+						.is_dynamic = true
+					};
+				}
+			},
+			{
+				{ L"endcase", L"分岐終了" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo {
+					return {
+						.Result = [&]() -> CommandPtr {
+							return std::make_unique<command::EndCase>();
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+									return KeywordInfo::ParamResult::Maximum;
+								default:
+									return KeywordInfo::ParamResult::Excess;
+							}
+						},
+						.is_static = false,
+						.is_dynamic = true
+					};
+				}
+			},
+			{
+				{ L"__entity強制更新" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo {
+					return {
+						.Result = [&]() -> CommandPtr {
+							return std::make_unique<command::hidden::UpdateEntity>();
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+									return KeywordInfo::ParamResult::Maximum;
+								default:
+									return KeywordInfo::ParamResult::Excess;
+							}
+						},
+						.is_static = false,
+						.is_dynamic = true
+					};
+				}
+			},
+			{
+				{ L"assign", L"代入" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo {
+					return {
+						.Result = [&]() -> CommandPtr {
+							return std::make_unique<command::math::Assign>(params);
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+								case 1:
+									return KeywordInfo::ParamResult::Lack;
+								case 2:
+									return KeywordInfo::ParamResult::Maximum;
+								default:
+									return KeywordInfo::ParamResult::Excess;
+							}
+						},
+						.is_static = false,
+						.is_dynamic = true
+					};
+				}
+			},
+			{
+				{ L"sum", L"加算" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo {
+					return {
+						.Result = [&]() -> CommandPtr {
+							return std::make_unique<command::math::Sum>(params);
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+								case 1:
+								case 2:
+									return KeywordInfo::ParamResult::Lack;
+								case 3:
+									return KeywordInfo::ParamResult::Maximum;
+								default:
+									return KeywordInfo::ParamResult::Excess;
+							}
+						},
+						.is_static = false,
+						.is_dynamic = true
+					};
+				}
+			},
+			{
+				{ L"sub", L"減算" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo {
+					return {
+						.Result = [&]() -> CommandPtr {
+							return std::make_unique<command::math::Sub>(params);
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+								case 1:
+								case 2:
+									return KeywordInfo::ParamResult::Lack;
+								case 3:
+									return KeywordInfo::ParamResult::Maximum;
+								default:
+									return KeywordInfo::ParamResult::Excess;
+							}
+						},
+						.is_static = false,
+						.is_dynamic = true
+					};
+				}
+			},
+			{
+				{ L"mul", L"乗算" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo {
+					return {
+						.Result = [&]() -> CommandPtr {
+							return std::make_unique<command::math::Mul>(params);
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+								case 1:
+								case 2:
+									return KeywordInfo::ParamResult::Lack;
+								case 3:
+									return KeywordInfo::ParamResult::Maximum;
+								default:
+									return KeywordInfo::ParamResult::Excess;
+							}
+						},
+						.is_static = false,
+						.is_dynamic = true
+					};
+				}
+			},
+			{
+				{ L"div", L"徐算" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo {
+					return {
+						.Result = [&]() -> CommandPtr {
+							return std::make_unique<command::math::Div>(params);
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+								case 1:
+								case 2:
+									return KeywordInfo::ParamResult::Lack;
+								case 3:
+									return KeywordInfo::ParamResult::Maximum;
+								default:
+									return KeywordInfo::ParamResult::Excess;
+							}
+						},
+						.is_static = false,
+						.is_dynamic = true
+					};
+				}
+			},
+			{
+				{ L"mod", L"剰余" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo {
+					return {
+						.Result = [&]() -> CommandPtr {
+							return std::make_unique<command::math::Mod>(params);
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+								case 1:
+								case 2:
+									return KeywordInfo::ParamResult::Lack;
+								case 3:
+									return KeywordInfo::ParamResult::Maximum;
+								default:
+									return KeywordInfo::ParamResult::Excess;
+							}
+						},
+						.is_static = false,
+						.is_dynamic = true
+					};
+				}
+			},
+			{
+				{ L"or", L"論理和" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo {
+					return {
+						.Result = [&]() -> CommandPtr {
+							return std::make_unique<command::math::Or>(params);
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+								case 1:
+								case 2:
+									return KeywordInfo::ParamResult::Lack;
+								case 3:
+									return KeywordInfo::ParamResult::Maximum;
+								default:
+									return KeywordInfo::ParamResult::Excess;
+							}
+						},
+						.is_static = false,
+						.is_dynamic = true
+					};
+				}
+			},
+			{
+				{ L"and", L"論理積" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo {
+					return {
+						.Result = [&]() -> CommandPtr {
+							return std::make_unique<command::math::And>(params);
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+								case 1:
+								case 2:
+									return KeywordInfo::ParamResult::Lack;
+								case 3:
+									return KeywordInfo::ParamResult::Maximum;
+								default:
+									return KeywordInfo::ParamResult::Excess;
+							}
+						},
+						.is_static = false,
+						.is_dynamic = true
+					};
+				}
+			},
+			{
+				{ L"xor", L"排他的論理和" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo {
+					return {
+						.Result = [&]() -> CommandPtr {
+							return std::make_unique<command::math::Xor>(params);
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+								case 1:
+								case 2:
+									return KeywordInfo::ParamResult::Lack;
+								case 3:
+									return KeywordInfo::ParamResult::Maximum;
+								default:
+									return KeywordInfo::ParamResult::Excess;
+							}
+						},
+						.is_static = false,
+						.is_dynamic = true
+					};
+				}
+			},
+			{
+				{ L"not", L"論理否定" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo {
+					return {
+						.Result = [&]() -> CommandPtr {
+							return std::make_unique<command::math::Not>(params);
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+								case 1:
+									return KeywordInfo::ParamResult::Lack;
+								case 2:
+									return KeywordInfo::ParamResult::Maximum;
+								default:
+									return KeywordInfo::ParamResult::Excess;
+							}
+						},
+						.is_static = false,
+						.is_dynamic = true
+					};
+				}
+			},
+			{
+				{ L"push", L"末尾追加" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo {
+					return {
+						.Result = [&]() -> CommandPtr {
+							return std::make_unique<command::array::Push>(params);
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+								case 1:
+									return KeywordInfo::ParamResult::Lack;
+								case 2:
+									return KeywordInfo::ParamResult::Maximum;
+								default:
+									return KeywordInfo::ParamResult::Excess;
+							}
+						},
+						.is_static = false,
+						.is_dynamic = true
+					};
+				}
+			},
+			{
+				{ L"pop", L"末尾削除" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo {
+					return {
+						.Result = [&]() -> CommandPtr {
+							return std::make_unique<command::array::Pop>(params);
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+									return KeywordInfo::ParamResult::Lack;
+								case 1:
+									return KeywordInfo::ParamResult::Medium;
+								case 2:
+									return KeywordInfo::ParamResult::Maximum;
+								default:
+									return KeywordInfo::ParamResult::Excess;
+							}
+						},
+						.is_static = false,
+						.is_dynamic = true
+					};
+				}
+			},
+			{
+				{ L"get", L"要素取得" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo {
+					return {
+						.Result = [&]() -> CommandPtr {
+							return std::make_unique<command::array::GetElement>(params);
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+								case 1:
+								case 2:
+									return KeywordInfo::ParamResult::Lack;
+								case 3:
+									return KeywordInfo::ParamResult::Maximum;
+								default:
+									return KeywordInfo::ParamResult::Excess;
+							}
+						},
+						.is_static = false,
+						.is_dynamic = true
+					};
+				}
+			},
+			{
+				{ L"set", L"要素設定" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo {
+					return {
+						.Result = [&]() -> CommandPtr {
+							return std::make_unique<command::array::SetElement>(params);
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+								case 1:
+								case 2:
+									return KeywordInfo::ParamResult::Lack;
+								case 3:
+									return KeywordInfo::ParamResult::Maximum;
+								default:
+									return KeywordInfo::ParamResult::Excess;
+							}
+						},
+						.is_static = false,
+						.is_dynamic = true
+					};
+				}
+			},
+			{
+				{ L"len", L"要素数" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo {
+					return {
+						.Result = [&]() -> CommandPtr {
+							return std::make_unique<command::array::Length>(params);
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+								case 1:
+									return KeywordInfo::ParamResult::Lack;
+								case 2:
+									return KeywordInfo::ParamResult::Maximum;
+								default:
+									return KeywordInfo::ParamResult::Excess;
+							}
+						},
+						.is_static = false,
+						.is_dynamic = true
+					};
+				}
+			},
+			{
+				{ L"clear", L"全削除" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo {
+					return {
+						.Result = [&]() -> CommandPtr {
+							return std::make_unique<command::array::Clear>(params);
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+									return KeywordInfo::ParamResult::Lack;
+								case 1:
+									return KeywordInfo::ParamResult::Maximum;
+								default:
+									return KeywordInfo::ParamResult::Excess;
+							}
+						},
+						.is_static = false,
+						.is_dynamic = true
+					};
+				}
+			},
+			{
+				{ L"sort", L"並べ替え" },
+				[](const std::vector<std::wstring>& params) -> KeywordInfo {
+					return {
+						.Result = [&]() -> CommandPtr {
+							return std::make_unique<command::array::Sort>(params);
+						},
+						.checkParamState = [params]() -> KeywordInfo::ParamResult {
+							switch (params.size()) {
+								case 0:
+									return KeywordInfo::ParamResult::Lack;
+								case 1:
+									return KeywordInfo::ParamResult::Maximum;
+								default:
+									return KeywordInfo::ParamResult::Excess;
+							}
+						},
+						.is_static = false,
+						.is_dynamic = true
+					};
+				}
+			}
+		};
+
+		// 組み込みコマンド名の完全ハッシュ表
+		// 全てのコマンド名が異なる位置に収まる種を、コンパイル時に探す。
+		class BuiltinTable final {
+			static constexpr size_t Size = 4096;
+			static constexpr uint8 Empty = 0xFF;
+			static_assert(std::size(Builtins) < Empty);
+
+			uint64 seed = 0;
+			uint8 slots[Size]{};
+			uint64 keyword_hash = 0;
+
+			static constexpr size_t IndexOf(const std::wstring_view Name, const uint64 Seed) noexcept {
+				const uint64 H = Hash(Name, Hash_Offset ^ Seed);
+				return static_cast<size_t>((H ^ (H >> 32)) & (Size - 1));
+			}
+
+			constexpr bool Place(const uint64 Seed) noexcept {
+				for (auto& slot : slots)
+					slot = Empty;
+
+				for (size_t i = 0; i < std::size(Builtins); i++) {
+					for (const auto& Name : Builtins[i].names) {
+						if (Name.empty())
+							continue;
+						auto& slot = slots[IndexOf(Name, Seed)];
+						if (slot != Empty)
+							return false;
+						slot = static_cast<uint8>(i);
+					}
+				}
+				return true;
+			}
+		public:
+			constexpr BuiltinTable() {
+				while (!Place(seed))
+					seed++;
+
+				for (const auto& B : Builtins) {
+					for (const auto& Name : B.names) {
+						if (!Name.empty())
+							keyword_hash += Hash(Name);
+					}
+				}
+			}
+
+			constexpr Generator Find(const std::wstring_view Name) const noexcept {
+				const uint8 Index = slots[IndexOf(Name, seed)];
+				if (Index == Empty)
+					return nullptr;
+
+				for (const auto& Candidate : Builtins[Index].names) {
+					if (Candidate == Name)
+						return Builtins[Index].generate;
+				}
+				return nullptr;
+			}
+
+			// コマンド名に対応する英語名を返す。組み込みコマンドでなければ空を返す。
+			constexpr std::wstring_view EnglishName(const std::wstring_view Name) const noexcept {
+				const uint8 Index = slots[IndexOf(Name, seed)];
+				if (Index == Empty)
+					return {};
+
+				for (const auto& Candidate : Builtins[Index].names) {
+					if (Candidate == Name)
+						return Builtins[Index].names[0];
+				}
+				return {};
+			}
+
+			// 全ての組み込みコマンド名のハッシュ値の和
+			constexpr uint64 KeywordHash() const noexcept {
+				return keyword_hash;
+			}
+		};
+
+		constexpr BuiltinTable Builtin_Table{};
+		static_assert(Builtin_Table.Find(L"case") != nullptr && Builtin_Table.Find(L"条件") == Builtin_Table.Find(L"case"));
+		static_assert(Builtin_Table.Find(L"存在しないコマンド") == nullptr);
+		static_assert(Builtin_Table.EnglishName(L"条件") == L"case");
+
+		// DLLが登録したコマンド
+		// DLLの接続状態が変わった時のみ、登録し直させる。
+		class External final : private Singleton {
+			std::unordered_map<std::wstring, GenerateFunc> words{};
+			uint64 generation = ~uint64{ 0 };
+			uint64 keyword_hash = 0;
+
+			External() = default;
+
+			void Update() {
+				auto& dll_manager = Program::Instance().dll_manager;
+				if (generation == dll_manager.Generation()) [[likely]]
+					return;
+
+				words.clear();
+				dll_manager.RegisterExternalCommand(&words);
+				generation = dll_manager.Generation();
+
+				// 組み込みコマンドと同名のものは組み込みコマンドを上書きする為、同じく数える。
+				keyword_hash = 0;
+				for (const auto& Word : words)
+					keyword_hash += Hash(Word.first);
+			}
+		public:
+			GenerateFunc Find(const std::wstring& Name) {
+				Update();
+				auto it = words.find(Name);
+				return (it != words.end() ? it->second : GenerateFunc{});
+			}
+
+			uint64 KeywordHash() {
+				Update();
+				return keyword_hash;
+			}
+
+			static External& Instance() noexcept {
+				static External external;
+				return external;
+			}
+		};
+
+		// DLLが登録したコマンドは、同名の組み込みコマンドより優先される。
+		GenerateFunc Find(const std::wstring& Name) {
+			if (auto generate = External::Instance().Find(Name); generate != nullptr)
+				return generate;
+			if (const auto Generate = Builtin_Table.Find(Name); Generate != nullptr)
+				return Generate;
+			return GenerateFunc{};
+		}
+
+		// 組み込みコマンドとして生成されるコマンド名であれば、その英語名を返す。
+		// DLLが登録したコマンドで上書きされている場合や、組み込みコマンドでない場合は空を返す。
+		std::wstring_view BuiltinName(const std::wstring& Name) {
+			if (External::Instance().Find(Name) != nullptr)
+				return {};
+			return Builtin_Table.EnglishName(Name);
+		}
+
+		// 登録されている全てのコマンド名の組み合わせを表す値を返す。
+		// 登録順に依存しないよう、各コマンド名のハッシュ値の和を用いる。
+		uint64 KeywordHash() {
+			return Builtin_Table.KeywordHash() + External::Instance().KeywordHash();
+		}
+	}
+
+	namespace {
+		// 原文の中の、イベント1つ分の範囲
+		struct EventSource final {
+			std::wstring name;
+			std::wstring_view text;
+		};
+
+		// 原文をイベント毎の範囲に分割する。
+		// 構文解析は行わず、名前は最初の[]の中身から取る。
+		std::vector<EventSource> SplitEvents(const std::wstring_view Source) {
+			constexpr auto npos = std::wstring_view::npos;
+			std::vector<EventSource> sources{};
+			std::wstring name{};
+			size_t begin = 0, name_begin = npos;
+			int depth = 0;
+			for (size_t i = 0; i < Source.size(); i++) {
+				switch (Source[i]) {
+					case L'/':
+						// 注釈は改行まで読み飛ばす。
+						if (i + 1 < Source.size() && Source[i + 1] == L'/')
+							i = std::min(Source.find(L'\n', i), Source.size());
+						break;
+					case L'\'':
+						// 文字列の中の括弧は無視する。
+						i = std::min(Source.find(L'\'', i + 1), Source.size());
+						break;
+					case L'[':
+						if (depth == 0 && name_begin == npos)
+							name_begin = i + 1;
+						break;
+					case L']':
+						if (depth == 0 && name_begin != npos && name.empty()) {
+							auto text = Source.substr(name_begin, i - name_begin);
+							while (!text.empty() && IsSpace(text.front()))
+								text.remove_prefix(1);
+							while (!text.empty() && IsSpace(text.back()))
+								text.remove_suffix(1);
+							name = text;
+						}
+						break;
+					case L'{':
+						depth++;
+						break;
+					case L'}':
+						if (depth > 0 && --depth == 0) {
+							sources.push_back({ std::move(name), Source.substr(begin, i + 1 - begin) });
+							name.clear();
+							name_begin = npos;
+							begin = i + 1;
+						}
+						break;
+				}
+			}
+			return sources;
+		}
+
+		// ファイルの最終更新時刻を返す。取得できない場合は0を返す。
+		int64 LastWriteTime(const std::wstring& Path) noexcept {
+			std::error_code error{};
+			const auto Time = std::filesystem::last_write_time(Path, error);
+			return (error ? 0 : static_cast<int64>(Time.time_since_epoch().count()));
+		}
+	}
+
+	// イベント生成クラス
+	// イベントファイルの解析、コマンドの生成、イベントの設定・生成を行う。
+	class EventGenerator final : private Singleton {
+	public:
+		// 解析クラス
+		class Parser final {
+			// 構文木
+			// 原文を、括弧で始まる文(イベント名[]・発生タイプ<>・引数()・コマンド文{})の並びとして表す。
+			struct Syntax final {
+				// 文
+				// 括弧を含む行の改行で終わり、括弧を含まない行は次の行と同じ文として続く。
+				// ただし、{のみを持つ行からは、}を含む行までを一つの文とする。
+				struct Sentence final {
+					std::wstring brackets{};			// 文頭の括弧(括弧で始まらない文では空)
+					std::vector<std::wstring> words{};	// 括弧に続く単語
+					std::vector<std::vector<std::wstring>> lines{};	// {}内の行毎の単語(単語の無い行は含まない)
+				};
+				std::vector<Sentence> sentences{};
+			};
+
+			// 一文字ずつの解析器。
+			// 原文を一度だけ走査し、原文上の範囲を指す字句をcontextとして排出。
+			class LexicalParser final {
+				Context context;
+
+				// 単語の区切りとなる文字か否か。
+				static constexpr bool IsDelimiter(const wchar_t C) noexcept {
+					switch (C) {
+						case L'\0':
+						case L'\n':
+						case L'\r':
+						case L',':
+						case L'/':
+						case L'~':
+						case L'[':
+						case L']':
+						case L'<':
+						case L'>':
+						case L'(':
+						case L')':
+						case L'{':
+						case L'}':
+							return true;
+						default:
+							return IsSpace(C);
+					}
+				}
+
+				void Push(const Token::Kind Kind, const size_t Begin, const size_t Length) {
+					context.tokens.push_back(Token{ .kind = Kind, .begin = static_cast<uint32>(Begin), .length = static_cast<uint32>(Length) });
+				}
+			public:
+				LexicalParser(std::wstring sentence) noexcept {
+					context.source = std::move(sentence);
+					const std::wstring& Source = context.source;
+					const size_t Length = Source.size();
+					context.tokens.reserve(Length / 4);
+
+					size_t i = 0;
+					while (i < Length) {
+						const wchar_t C = Source[i];
+						switch (C) {
+							case L'\n':
+								// 連続する改行は一つにまとめる。
+								if (!context.tokens.empty() && context.tokens.back().kind != Token::Kind::NewLine)
+									Push(Token::Kind::NewLine, i, 1);
+								i++;
+								continue;
+							case L'\0':
+							case L'\r':
+							case L',':
+								// 復帰コードとカンマは無視。
+								i++;
+								continue;
+							case L'/':
+								if (i + 1 < Length && Source[i + 1] == L'/') {
+									// 注釈は改行まで読み飛ばす。
+									while (i < Length && Source[i] != L'\n')
+										i++;
 								} else {
-									return std::make_unique<command::entity::Defrost>(params);
+									Push(Token::Kind::Word, i++, 1);
 								}
-							},
-							.checkParamState = [params]() -> KeywordInfo::ParamResult {
-								switch (params.size()) {
-									case 0:
-										return KeywordInfo::ParamResult::Lack;
-									case 1:
-										return KeywordInfo::ParamResult::Maximum;
-									default:
-										return KeywordInfo::ParamResult::Excess;
+								continue;
+							case L'<':
+							case L'>':
+								if (i + 1 < Length && Source[i + 1] == L'=') {
+									// 比較演算子(<=、>=)
+									Push(Token::Kind::Word, i, 2);
+									i += 2;
+								} else {
+									Push(Token::Kind::Bracket, i++, 1);
 								}
-							},
-							.is_static = false,
-							.is_dynamic = true
-						};
-					};
+								continue;
+							case L'[':
+							case L']':
+							case L'(':
+							case L')':
+							case L'{':
+							case L'}':
+								Push(Token::Kind::Bracket, i++, 1);
+								continue;
+							case L'~':
+								Push(Token::Kind::Word, i++, 1);
+								continue;
+						}
 
-					words[L"animation"] =
-						words[L"Aj"] = [](const std::vector<std::wstring>& params) -> KeywordInfo 
-					{
-						return {
-							.Result = [&]() noexcept -> CommandPtr {
-								const auto [Var_Name, Var_Type] = Default_ProgramInterface.GetParamInfo(params[0]);
-								if (Default_ProgramInterface.IsNoType(Var_Type))
-									return std::make_unique<command::Animation>(Var_Name);
-								else
-									return nullptr;
-							},
-							.checkParamState = [params]() -> KeywordInfo::ParamResult {
-								switch (params.size()) {
-									case 0:
-										return KeywordInfo::ParamResult::Lack;
-									case 1:
-										return KeywordInfo::ParamResult::Maximum;
-									default:
-										return KeywordInfo::ParamResult::Excess;
-								}
-							},
-							.is_static = false,
-							.is_dynamic = true
-						};
-					};
+						if (IsSpace(C)) {
+							i++;
+							continue;
+						}
 
-					words[L"addframe"] =
-						words[L"t[ǉ"] = [](const std::vector<std::wstring>& params) -> KeywordInfo
-					{
-						return {
-							.Result = [&]() noexcept -> CommandPtr {
-								const auto [Var_Name, Var_Type] = Default_ProgramInterface.GetParamInfo(params[0]);
-								const auto [Path, Path_Type] = Default_ProgramInterface.GetParamInfo(params[1]);
-								if (Default_ProgramInterface.IsNoType(Var_Type) && Default_ProgramInterface.IsStringType(Path_Type))
-									return std::make_unique<command::AddFrame>(Var_Name, Path);
-								else
-									return std::make_unique<command::AddFrame>(params);
-							},
-							.checkParamState = [params]() -> KeywordInfo::ParamResult {
-								switch (params.size()) {
-									case 0:
-									case 1:
-										return KeywordInfo::ParamResult::Lack;
-									case 2:
-										return KeywordInfo::ParamResult::Maximum;
-									default:
-										return KeywordInfo::ParamResult::Excess;
-								}
-							},
-							.is_static = false,
-							.is_dynamic = true
-						};
-					};
+						// 単語
+						// 文字列(')の間は、区切り文字を単語の一部として扱う。
+						const size_t Begin = i;
+						while (i < Length) {
+							if (Source[i] == L'\'') {
+								const auto End = Source.find(L'\'', i + 1);
+								i = (End == std::wstring::npos ? Length : End + 1);
+								break;
+							} else if (Source[i] == L'[' && i > Begin) {
+								// 名前に続く添字(配列[添字])は、単語の一部として扱う。
+								const auto End = Source.find_first_of(L"]\n", i + 1);
+								if (End != std::wstring::npos && Source[End] == L']')
+									i = End + 1;
+								break;
+							} else if (IsDelimiter(Source[i])) {
+								break;
+							}
+							i++;
+						}
+						Push(Token::Kind::Word, Begin, i - Begin);
+					}
+				}
 
-					words[L"nextframe"] =
-						words[L"t["] = [](const std::vector<std::wstring>& params) -> KeywordInfo
-					{
-						return {
-							.Result = [&]() noexcept -> CommandPtr {
-								const auto [Var_Name, Var_Type] = Default_ProgramInterface.GetParamInfo(params[0]);
-								if (Default_ProgramInterface.IsNoType(Var_Type))
-									return std::make_unique<command::NextFrame>(Var_Name);
-								else
-									return nullptr;
-							},
-							.checkParamState = [params]() -> KeywordInfo::ParamResult {
-								switch (params.size()) {
-									case 0:
-										return KeywordInfo::ParamResult::Lack;
-									case 1:
-										return KeywordInfo::ParamResult::Maximum;
-									default:
-										return KeywordInfo::ParamResult::Excess;
-								}
-							},
-							.is_static = false,
-							.is_dynamic = true
-						};
-					};
+				auto Result() noexcept {
+					return std::move(context);
+				}
+			};
+
+			// 字句の型(数値・文字列)を決定する。
+			class TypeDeterminer final {
+				Context compiled{};
+			public:
+				TypeDeterminer(Context& context) noexcept {
+					for (auto& token : context.tokens) {
+						if (token.kind != Token::Kind::Word)
+							continue;
+
+						const wchar_t Head = context.source[token.begin];
+						if (iswdigit(Head) || Head == L'-') {
+							token.kind = Token::Kind::Number;
+						} else if (Head == L'\'') {
+							// 引用符を範囲から外す。
+							token.kind = Token::Kind::String;
+							token.begin++;
+							token.length = (token.length >= 2 && context.source[token.begin + token.length - 2] == L'\'' ? token.length - 2 : token.length - 1);
+						}
+					}
+					compiled = std::move(context);
+				}
+
+				auto Result() noexcept {
+					return std::move(compiled);
+				}
+			};
 
-					words[L"backframe"] =
-						words[L"Ot["] = [](const std::vector<std::wstring>& params) -> KeywordInfo
-					{
-						return {
-							.Result = [&]() noexcept -> CommandPtr {
-								const auto [Var_Name, Var_Type] = Default_ProgramInterface.GetParamInfo(params[0]);
-								if (Default_ProgramInterface.IsNoType(Var_Type))
-									return std::make_unique<command::BackFrame>(Var_Name);
-								else
-									return nullptr;
-							},
-							.checkParamState = [params]() -> KeywordInfo::ParamResult {
-								switch (params.size()) {
-									case 0:
-										return KeywordInfo::ParamResult::Lack;
-									case 1:
-										return KeywordInfo::ParamResult::Maximum;
-									default:
-										return KeywordInfo::ParamResult::Excess;
+			// 構文木解析
+			// 他のファイルの解析と並行して実行できる様に、エラーは送らずに保持する。
+			class SyntaxParser final {
+				Syntax tree{};
+				error::ErrorContent *error_occurred{};
+				std::wstring error_sentence{};
+				inline static error::ErrorContent *invalid_operator_error{};
+
+				// 括弧を書き足す字句を返す。(0は文頭、それ以外は位置 - 1番目の単語)
+				static std::wstring& BracketText(Syntax::Sentence& sentence, const size_t Position) noexcept {
+					return (Position == 0 ? sentence.brackets : sentence.words[Position - 1]);
+				}
+			public:
+				// エラーを作成する。解析を並行して行う前に、一度だけ呼ぶ。
+				static void MakeErrors() {
+					if (invalid_operator_error == nullptr)
+						invalid_operator_error = error::UserErrorHandler::MakeError(event::Manager::Instance().error_class, L"構文に誤りがあります。", MB_OK | MB_ICONERROR, 1);
+				}
+
+				SyntaxParser(const Context& Lexical_Context) noexcept {
+					constexpr size_t No_Bracket = std::wstring::npos;
+					// 括弧を書き足す字句の位置
+					size_t bracket_position = No_Bracket;
+					// {}内の行を読んでいるか否か。
+					bool in_block = false;
+
+					tree.sentences.emplace_back();
+					for (auto token = Lexical_Context.tokens.begin(); token != Lexical_Context.tokens.end() && error_occurred == nullptr; token++) {
+						auto& sentence = tree.sentences.back();
+						switch (token->kind) {
+							case Token::Kind::Bracket:
+							{
+								// 文の全ての括弧は、最初の括弧の直前の字句(単語が無ければ文頭)に書き足す。
+								if (bracket_position == No_Bracket)
+									bracket_position = sentence.words.size();
+
+								auto& text = BracketText(sentence, bracket_position);
+								text += Lexical_Context.source[token->begin];
+								if (text.size() == 2 && text != L"()" && text != L"<>" && text != L"[]" && text != L"{}") {
+									error_occurred = invalid_operator_error;
+									error_sentence = L"文: " + text;
 								}
-							},
-							.is_static = false,
-							.is_dynamic = true
-						};
-					};
+								break;
+							}
+							case Token::Kind::NewLine:
+							{
+								// 括弧を含まない行は、次の行と同じ文として続ける。
+								if (bracket_position == No_Bracket)
+									break;
 
-					words[L"capture"] =
-						words[L"摜؎"] = [](const std::vector<std::wstring>& params) -> KeywordInfo
-					{
-						return {
-							.Result = [&]() noexcept -> CommandPtr {
-								const auto [Var_Name, Var_Type] = Default_ProgramInterface.GetParamInfo(params[0]);
-								const auto [File_Path, Path_Type] = Default_ProgramInterface.GetParamInfo(params[1]);
-								const auto [Vec_X, VX_Type] = Default_ProgramInterface.GetParamInfo(params[2]);
-								const auto [Vec_Y, VY_Type] = Default_ProgramInterface.GetParamInfo(params[3]);
-								const auto [Len_X, LX_Type] = Default_ProgramInterface.GetParamInfo(params[4]);
-								const auto [Len_Y, LY_Type] = Default_ProgramInterface.GetParamInfo(params[5]);
-
-								if (Default_ProgramInterface.IsNoType(Var_Type) &&
-									Default_ProgramInterface.IsStringType(Path_Type) &&
-									Default_ProgramInterface.IsNumberType(VX_Type) &&
-									Default_ProgramInterface.IsNumberType(VY_Type) &&
-									Default_ProgramInterface.IsNumberType(LX_Type) &&
-									Default_ProgramInterface.IsNumberType(LY_Type))
-								{
-									return std::make_unique<command::Capture>(Var_Name,
-										File_Path,
-										ScreenVector{ ToInt(Vec_X.c_str(), nullptr), ToInt(Vec_Y.c_str(), nullptr) },
-										ScreenVector{ ToInt(Len_X.c_str(), nullptr), ToInt(Len_Y.c_str(), nullptr) });
-								} else {
-									return std::make_unique<command::Capture>(params);
+								const bool Is_Block_Open = (BracketText(sentence, bracket_position) == L"{");
+								// コマンド文は複数行で構成される為、単語を行毎に分ける。
+								if ((in_block || Is_Block_Open) && !sentence.words.empty()) {
+									sentence.lines.push_back(std::move(sentence.words));
+									sentence.words.clear();
 								}
-							},
-							.checkParamState = [params]() -> KeywordInfo::ParamResult {
-								switch (params.size()) {
-									case 0:
-									case 1:
-									case 2:
-									case 3:
-									case 4:
-									case 5:
-										return KeywordInfo::ParamResult::Lack;
-									case 6:
-										return KeywordInfo::ParamResult::Maximum;
-									default:
-										return KeywordInfo::ParamResult::Excess;
+								in_block = Is_Block_Open;
+								if (!Is_Block_Open) {
+									tree.sentences.emplace_back();
+									bracket_position = No_Bracket;
 								}
-							},
-							.is_static = false,
-							.is_dynamic = true
-						};
-					};
+								break;
+							}
+							default:
+								sentence.words.push_back(Lexical_Context.Word(*token));
+								break;
+						}
+					}
 
-					words[L"button"] =
-						words[L"{^"] = [](const std::vector<std::wstring>& params) -> KeywordInfo {
-						return {
-							.Result = [&]() noexcept -> CommandPtr {
-								switch (params.size()) {
-									case 3:
-									{
-										const auto [Name, Name_Type] = Default_ProgramInterface.GetParamInfo(params[0]);
-										const auto [VX, VX_Type] = Default_ProgramInterface.GetParamInfo(params[1]);
-										const auto [VY, VY_Type] = Default_ProgramInterface.GetParamInfo(params[2]);
-										if (Default_ProgramInterface.IsStringType(Name_Type) &&
-											Default_ProgramInterface.IsNumberType(VX_Type) &&
-											Default_ProgramInterface.IsNumberType(VY_Type))
-										{
-											return std::make_unique<command::Button>(
-												Name,
-												WorldVector{ ToDec<Dec>(VX.c_str(), nullptr), ToDec<Dec>(VY.c_str(), nullptr) },
-												L"",
-												WorldVector{ 0.0, 0.0 }
-											);
-										} else {
-											return std::make_unique<command::Button>(params);
-										}
-										break;
-									}
-									case 6:
-									{
-										const auto [Name, Name_Type] = Default_ProgramInterface.GetParamInfo(params[0]);
-										const auto [VX, VX_Type] = Default_ProgramInterface.GetParamInfo(params[1]);
-										const auto [VY, VY_Type] = Default_ProgramInterface.GetParamInfo(params[2]);
-										const auto [SX, SX_Type] = Default_ProgramInterface.GetParamInfo(params[3]);
-										const auto [SY, SY_Type] = Default_ProgramInterface.GetParamInfo(params[4]);
-										const auto [Img, Img_Type] = Default_ProgramInterface.GetParamInfo(params[5]);
-										if (Default_ProgramInterface.IsStringType(Name_Type) &&
-											Default_ProgramInterface.IsNumberType(VX_Type) &&
-											Default_ProgramInterface.IsNumberType(VY_Type) &&
-											Default_ProgramInterface.IsStringType(Img_Type) &&
-											Default_ProgramInterface.IsNumberType(SX_Type) &&
-											Default_ProgramInterface.IsNumberType(SY_Type))
-										{
-											return std::make_unique<command::Button>(
-												Name,
-												WorldVector{ ToDec<Dec>(VX.c_str(), nullptr), ToDec<Dec>(VY.c_str(), nullptr) },
-												Img,
-												WorldVector{ ToDec<Dec>(SX.c_str(), nullptr), ToDec<Dec>(SY.c_str(), nullptr) }
-											);
-										} else {
-											return std::make_unique<command::Button>(params);
+					// 閉じられていないコマンド文の最後の行
+					if (auto& sentence = tree.sentences.back(); in_block && !sentence.words.empty()) {
+						sentence.lines.push_back(std::move(sentence.words));
+						sentence.words.clear();
+					}
+				}
+
+				auto& Result() noexcept {
+					return tree;
+				}
+
+				// 解析中に発生したエラーをイベントマネージャへ送る。
+				void SendError() const noexcept {
+					if (error_occurred != nullptr)
+						event::Manager::Instance().error_handler.SendLocalError(error_occurred, error_sentence);
+				}
+
+				// 解析中にエラーが発生したか否か。
+				bool Failed() const noexcept {
+					return error_occurred != nullptr;
+				}
+			};
+
+			// 意味解析
+			class SemanticParser final {
+				std::unordered_map<std::wstring, Event> parsing_events{};
+
+				CommandTree* parent = nullptr;
+				WorldVector origin[2]{ { -1, -1 }, { -1, -1 } };
+				TriggerType trigger_type = TriggerType::Invalid;
+				std::wstring event_name;
+				std::vector<std::wstring> params{};
+				std::list<CommandTree> commands{};
+				std::vector<std::wstring> command_parameters{};
+
+				// 左: 現在のcaseのイテレータ
+				// 右: elseが存在するか否か。
+				std::list<std::pair<decltype(commands)::iterator, bool>> case_stack{};
+				// コマンド文を発見したか否か。
+				bool found_command_sentence = false;
+
+				error::ErrorContent *error_occurred{};
+				inline static error::ErrorContent 
+					*empty_name_error{}, 
+					*invalid_trigger_type_warning{},
+					*command_not_found_error{},
+					*lack_of_parameters_error{},
+					*too_many_parameters_warning{},
+					*already_new_event_name_defined_error{},
+					*already_new_trigger_type_defined_error{};
+
+				// 一つの文(コマンド文の場合は一行)を解析する。
+				// 解析を打ち切る場合はfalseを返す。
+				bool Parse(const std::wstring& Brackets, const std::vector<std::wstring>& Words) noexcept {
+					if (error_occurred != nullptr)
+						goto check_error;
+
+					if (Brackets == L"[]") {
+						if (event_name.empty()) {
+							switch (Words.size()) {
+								case 0:
+									error_occurred = empty_name_error;
+									event::Manager::Instance().error_handler.SendLocalError(error_occurred);
+									break;
+								case 1:
+									event_name = Words.front();
+									break;
+								default:
+									for (const auto& Word : Words)
+										event_name += Word + L' ';
+									event_name.pop_back();
+									break;
+							}
+						} else {
+							error_occurred = already_new_event_name_defined_error;
+							event::Manager::Instance().error_handler.SendLocalError(error_occurred, (L"多重定義として判定されたイベント名: " + (Words.empty() ? std::wstring() : Words.front())));
+						}
+					} else if (Brackets == L"<>") {
+						if (trigger_type == TriggerType::Invalid) {
+							const std::wstring Word = (Words.empty() ? std::wstring() : Words.front());
+							if (Word == L"a") {
+								trigger_type = TriggerType::Auto;
+							} else if (Word == L"t") {
+								trigger_type = TriggerType::Trigger;
+							} else if (Word == L"n") {
+								trigger_type = TriggerType::None;
+							} else if (Word == L"l") {
+								trigger_type = TriggerType::Load;
+							} else {
+								trigger_type = TriggerType::None;
+								event::Manager::Instance().error_handler.SendLocalError(invalid_trigger_type_warning);
+							}
+
+							for (size_t w = 1, i = 0; w < Words.size(); w++) {
+								if (Words[w] == L"~")
+									i = 1;
+								else {
+									origin[(origin[0][1] > -1)][i] = ToDec<Dec>(Words[w].c_str(), nullptr);
+									i = 0;
+								}
+							}
+						} else {
+							error_occurred = already_new_trigger_type_defined_error;
+							event::Manager::Instance().error_handler.SendLocalError(error_occurred, (L"多重定義として判定された発生タイプ名: " + (Words.empty() ? std::wstring() : Words.front())));
+						}
+					} else if (Brackets == L"()") {
+						params.insert(params.end(), Words.begin(), Words.end());
+					} else if (Brackets == L"{}") {
+						found_command_sentence = true;
+						std::wstring command_name{};
+						GenerateFunc generator_candidate{};
+						for (const auto& Word : Words) {
+							if (auto generate = keyword::Find(Word); generate != nullptr) {
+								command_name = Word;
+								generator_candidate = std::move(generate);
+							} else {
+								command_parameters.push_back(Word);
+							}
+						}
+
+						if (generator_candidate != nullptr) {
+							auto generator = generator_candidate(command_parameters);
+							switch (generator.checkParamState()) {
+								case KeywordInfo::ParamResult::Lack:
+									error_occurred = lack_of_parameters_error;
+									event::Manager::Instance().error_handler.SendLocalError(
+										error_occurred,
+										(L"コマンド名: " + command_name).c_str()
+									);
+									break;
+								case KeywordInfo::ParamResult::Medium:
+								case KeywordInfo::ParamResult::Maximum:
+									if (command_name == L"case") {
+										if (!case_stack.front().second) {
+											// elseが無い為、暗黙的に空のelseを挿入。
+											commands.push_front(CommandTree{
+												.command = keyword::Find(L"else")({}).Result(),
+												.word = L"else",
+												.parent = parent
+											});
+											parent = &commands.front();
 										}
-										break;
+										case_stack.pop_front();
+									} else if (command_name == L"endcase") {
+										// else検査開始。
+										case_stack.push_front({ commands.begin(), false });
+									} else if (command_name == L"else") {
+										// elseが存在するのでtrue。
+										case_stack.front().second = true;
 									}
+
+									commands.push_front(CommandTree{
+										.command = generator.Result(),
+										.word = command_name,
+										.parent = parent,
+										.params = command_parameters
+									});
+									parent = &commands.front();
+									break;
+								case KeywordInfo::ParamResult::Excess:
+									event::Manager::Instance().error_handler.SendLocalError(
+										too_many_parameters_warning,
+										(L"コマンド名: " + command_name).c_str()
+									);
+									break;
+							}
+						} else {
+							if (!command_name.empty()) {
+								error_occurred = command_not_found_error;
+								event::Manager::Instance().error_handler.SendLocalError(error_occurred, L"コマンド名: " + command_name);
+							}
+						}
+						command_parameters.clear();
+					}
+
+				check_error:
+					if (event::Manager::Instance().error_handler.ShowLocalError(4))
+						return false;
+
+					if (!event_name.empty() && found_command_sentence) {
+						parsing_events[event_name].trigger_type = trigger_type;
+						parsing_events[event_name].param_names = std::move(params);
+						for (int i = 0; i < 2; i++)
+							parsing_events[event_name].origin[i] = origin[i];
+
+						parsing_events[event_name].commands = std::move(commands);
+						trigger_type = TriggerType::Invalid;
+						commands.clear();
+						params.clear();
+						event_name.clear();
+						parent = nullptr;
+						found_command_sentence = false;
+					}
+					return true;
+				}
+			public:
+				SemanticParser() noexcept {
+					if (empty_name_error == nullptr)
+						empty_name_error = error::UserErrorHandler::MakeError(event::Manager::Instance().error_class, L"イベント名を空にすることはできません。", MB_OK | MB_ICONERROR, 1);
+					if (invalid_trigger_type_warning == nullptr)
+						invalid_trigger_type_warning = error::UserErrorHandler::MakeError(event::Manager::Instance().error_class, L"不明なイベント発生タイプが指定されたため、発生無しを設定しました。", MB_OK | MB_ICONWARNING, 4);
+					if (command_not_found_error == nullptr)
+						command_not_found_error = error::UserErrorHandler::MakeError(event::Manager::Instance().error_class, L"指定されたコマンドが見つかりません。", MB_OK | MB_ICONERROR, 2);
+					if (lack_of_parameters_error == nullptr)
+						lack_of_parameters_error = error::UserErrorHandler::MakeError(event::Manager::Instance().error_class, L"コマンドの引数が足りない為、生成できません。", MB_OK | MB_ICONERROR, 2);
+					if (too_many_parameters_warning == nullptr)
+						too_many_parameters_warning = error::UserErrorHandler::MakeError(event::Manager::Instance().error_class, L"コマンドの引数が多すぎる為、余分なものは廃棄しました。", MB_OK | MB_ICONWARNING, 3);
+					if (already_new_event_name_defined_error == nullptr)
+						already_new_event_name_defined_error = error::UserErrorHandler::MakeError(event::Manager::Instance().error_class, L"既にイベント名が設定されています。", MB_OK | MB_ICONERROR, 1);
+					if (already_new_trigger_type_defined_error == nullptr)
+						already_new_trigger_type_defined_error = error::UserErrorHandler::MakeError(event::Manager::Instance().error_class, L"既に発生タイプが指定されています。", MB_OK | MB_ICONERROR, 1);
+				}
+
+				// 構文木を一度だけ辿って解析する。
+				// コマンドを先頭へ積んでいく為、末尾の文(コマンド文では末尾の行)から順に解析する。
+				SemanticParser(const Syntax& Tree) noexcept : SemanticParser() {
+					for (auto sentence = Tree.sentences.rbegin(); sentence != Tree.sentences.rend(); sentence++) {
+						if (sentence->lines.empty()) {
+							if (!Parse(sentence->brackets, sentence->words))
+								return;
+							continue;
+						}
+
+						for (auto line = sentence->lines.rbegin(); line != sentence->lines.rend(); line++) {
+							if (!Parse(sentence->brackets, *line))
+								return;
+						}
+					}
+				}
+
+				auto& Result() {
+					return parsing_events;
+				}
+
+				// 解析中にエラーが発生したか否か。
+				bool Failed() const noexcept {
+					return error_occurred != nullptr;
+				}
+
+				// 登録されているコマンド名の組み合わせを表す値を返す。
+				uint64 KeywordHash() const noexcept {
+					return keyword::KeywordHash();
+				}
+
+				// コマンド名と引数からコマンドを生成する。
+				CommandPtr Generate(const std::wstring& Command_Name, const std::vector<std::wstring>& Params) const {
+					const auto Generate = keyword::Find(Command_Name);
+					if (Generate == nullptr)
+						return nullptr;
+					return Generate(Params).Result();
+				}
+			};
+
+#if defined(KARAPO_BENCHMARK)
+			// 従来の解析器(計測用の実行ファイルのみ)
+			// 構文解析で字句毎に親を持つ節の一覧を作り、意味解析で各節から親を辿る。
+			// 新しい解析器が同じイベントを生成するかを、CompareWithLegacyで確かめる為に残している。
+			struct LegacySyntax final {
+				std::wstring text{};
+				LegacySyntax* parent{};
+			};
+
+			class LegacySyntaxParser final {
+				std::list<LegacySyntax> tree{};
+				error::ErrorContent *error_occurred{};
+				std::wstring error_sentence{};
+				inline static error::ErrorContent *invalid_operator_error{};
+			public:
+				LegacySyntaxParser(const Context& Lexical_Context) noexcept {
+					if (invalid_operator_error == nullptr)
+						invalid_operator_error = error::UserErrorHandler::MakeError(event::Manager::Instance().error_class, L"構文に誤りがあります。", MB_OK | MB_ICONERROR, 1);
+
+					tree.push_front({});
+					tree.push_front(LegacySyntax{ .parent = &tree.front() });
+					auto operator_iterator = tree.end();
+					auto tree_iterator = tree.begin();
+
+					for (auto token = Lexical_Context.tokens.begin(); token != Lexical_Context.tokens.end() && error_occurred == nullptr; token++) {
+						switch (token->kind) {
+							case Token::Kind::Bracket:
+							{
+								const wchar_t Bracket = Lexical_Context.source[token->begin];
+								auto old = tree_iterator;
+								if (operator_iterator == tree.end()) {
+									tree_iterator++;
+									operator_iterator = tree_iterator;
+								} else
+									tree_iterator = operator_iterator;
+								
+								tree_iterator->text += Bracket;
+								// 
+								if (tree_iterator->text.size() == 2 && tree_iterator->text != L"()" && tree_iterator->text != L"<>" && tree_iterator->text != L"[]" && tree_iterator->text != L"{}") {
+									error_occurred = invalid_operator_error;
+									error_sentence = L"文: " + tree_iterator->text;
 								}
-							},
-							.checkParamState = [params]() -> KeywordInfo::ParamResult {
-								switch (params.size()) {
-									case 0:
-									case 1:
-									case 2:
-										return KeywordInfo::ParamResult::Lack;
-									case 3:
-										return KeywordInfo::ParamResult::Medium;
-									case 4:
-									case 5:
-										return KeywordInfo::ParamResult::Lack;
-									case 6:
-										return KeywordInfo::ParamResult::Maximum;
-									default:
-										return KeywordInfo::ParamResult::Excess;
+								tree_iterator = old;
+								break;
+							}
+							case Token::Kind::NewLine:
+							{
+								if (operator_iterator != tree.end()) {
+									if (operator_iterator->text != L"{") {
+										operator_iterator = tree.end();
+										tree_iterator->parent = nullptr;
+										tree.push_front(LegacySyntax{ .parent = &(*tree_iterator) });
+									} else {
+										// コマンド文は複数行の文で構成される。
+										// ({}を親とする構文木が複数存在する。)
+										// 
+										// その為、常に{}を親として設定。
+										tree_iterator->parent = &(*operator_iterator);
+									}
+									tree_iterator = tree.begin();
 								}
-							},
-							.is_static = false,
-							.is_dynamic = true
-						};
-					};
+								break;
+							}
+							default:
+								tree_iterator->text = Lexical_Context.Word(*token);
+								tree.push_front(LegacySyntax{ .parent = &(*tree_iterator) });
+								tree_iterator = tree.begin();
+								break;
+						}
+					}
+					tree.pop_front();
+				}
+
+				auto& Result() noexcept {
+					return tree;
+				}
+
+			};
+
+			class LegacySemanticParser final {
+				std::list<LegacySyntax*> visited{}, queue{};
+				std::list<std::wstring> stack{};
+
+				std::unordered_map<std::wstring, Event> parsing_events{};
+
+				CommandTree* parent = nullptr;
+				WorldVector origin[2]{ { -1, -1 }, { -1, -1 } };
+				TriggerType trigger_type = TriggerType::Invalid;
+				std::wstring event_name;
+				std::vector<std::wstring> params{};
+				std::list<CommandTree> commands{};
+				std::vector<std::wstring> command_parameters{};
+
+				error::ErrorContent *error_occurred{};
+				inline static error::ErrorContent 
+					*empty_name_error{}, 
+					*invalid_trigger_type_warning{},
+					*command_not_found_error{},
+					*lack_of_parameters_error{},
+					*too_many_parameters_warning{},
+					*already_new_event_name_defined_error{},
+					*already_new_trigger_type_defined_error{};
+			public:
+				LegacySemanticParser() noexcept {
+					if (empty_name_error == nullptr)
+						empty_name_error = error::UserErrorHandler::MakeError(event::Manager::Instance().error_class, L"イベント名を空にすることはできません。", MB_OK | MB_ICONERROR, 1);
+					if (invalid_trigger_type_warning == nullptr)
+						invalid_trigger_type_warning = error::UserErrorHandler::MakeError(event::Manager::Instance().error_class, L"不明なイベント発生タイプが指定されたため、発生無しを設定しました。", MB_OK | MB_ICONWARNING, 4);
+					if (command_not_found_error == nullptr)
+						command_not_found_error = error::UserErrorHandler::MakeError(event::Manager::Instance().error_class, L"指定されたコマンドが見つかりません。", MB_OK | MB_ICONERROR, 2);
+					if (lack_of_parameters_error == nullptr)
+						lack_of_parameters_error = error::UserErrorHandler::MakeError(event::Manager::Instance().error_class, L"コマンドの引数が足りない為、生成できません。", MB_OK | MB_ICONERROR, 2);
+					if (too_many_parameters_warning == nullptr)
+						too_many_parameters_warning = error::UserErrorHandler::MakeError(event::Manager::Instance().error_class, L"コマンドの引数が多すぎる為、余分なものは廃棄しました。", MB_OK | MB_ICONWARNING, 3);
+					if (already_new_event_name_defined_error == nullptr)
+						already_new_event_name_defined_error = error::UserErrorHandler::MakeError(event::Manager::Instance().error_class, L"既にイベント名が設定されています。", MB_OK | MB_ICONERROR, 1);
+					if (already_new_trigger_type_defined_error == nullptr)
+						already_new_trigger_type_defined_error = error::UserErrorHandler::MakeError(event::Manager::Instance().error_class, L"既に発生タイプが指定されています。", MB_OK | MB_ICONERROR, 1);
+				}
+
+				LegacySemanticParser(std::list<LegacySyntax> *syntax) noexcept : LegacySemanticParser() {
+					// 左: 現在のcaseのイテレータ
+					// 右: elseが存在するか否か。
+					std::list<std::pair<decltype(commands)::iterator, bool>> case_stack{};
+					// コマンド文を発見したか否か。
+					bool found_command_sentence = false;
+
+					for (auto it = syntax->begin(); it != syntax->end(); it++) {
+						if (std::find(visited.begin(), visited.end(), &(*it)) != visited.end()) {
+							continue;
+						}
+						auto route = &(*it);
+						while (route != nullptr) {
+							visited.push_back(route);
+							queue.push_back(route);
+							route = route->parent;
+						}
 
-					words[L"input"] =
-						words[L""] = [](const std::vector<std::wstring>& params) -> KeywordInfo {
-						return {
-								.Result = [&]() noexcept -> CommandPtr {
-									return std::make_unique<command::Input>(params);
-								},
-								.checkParamState = [params]() -> KeywordInfo::ParamResult {
-									switch (params.size()) {
+						while (!queue.empty() && error_occurred == nullptr) {
+							stack.push_front(queue.front()->text);
+							auto& op = stack.front();
+							if (op == L"[]") {
+								stack.pop_front();
+								if (event_name.empty()) {
+									switch (stack.size()) {
 										case 0:
+											error_occurred = empty_name_error;
+											event::Manager::Instance().error_handler.SendLocalError(error_occurred);
+											break;
 										case 1:
-										case 2:
-										case 3:
-											return KeywordInfo::ParamResult::Lack;
-										case 4:
-											return KeywordInfo::ParamResult::Maximum;
+											event_name = stack.front();
+											stack.pop_front();
+											break;
 										default:
-											return KeywordInfo::ParamResult::Excess;
+											std::wstring candidate_name{};
+											while (!stack.empty()) {
+												candidate_name += stack.front() + L' ';
+												stack.pop_front();
+											}
+											candidate_name.pop_back();
+											event_name = candidate_name;
+											break;
 									}
-								},
-								.is_static = false,
-								.is_dynamic = true
-						};
-					};
-
-					words[L"teleport"] =
-						words[L"uԈړ"] = [](const std::vector<std::wstring>& params) -> KeywordInfo {
-						return {
-							.Result = [&]() noexcept -> CommandPtr {
-								const auto [Target, Target_Type] = Default_ProgramInterface.GetParamInfo(params[0]);
-								const auto [X, X_Type] = Default_ProgramInterface.GetParamInfo(params[1]);
-								const auto [Y, Y_Type] = Default_ProgramInterface.GetParamInfo(params[2]);
-								if (Default_ProgramInterface.IsStringType(Target_Type) && Default_ProgramInterface.IsNumberType(X_Type) && Default_ProgramInterface.IsNumberType(Y_Type)) {
-									return std::make_unique<command::entity::Teleport>(
-										Target,
-										WorldVector{ ToDec<Dec>(X.c_str(), nullptr), ToDec<Dec>(Y.c_str(), nullptr)
-									});
 								} else {
-									return std::make_unique<command::entity::Teleport>(params);
-								}
-							},
-							.checkParamState = [params]() -> KeywordInfo::ParamResult {
-								switch (params.size()) {
-									case 0:
-									case 1:
-									case 2:
-										return KeywordInfo::ParamResult::Lack;
-									case 3:
-										return KeywordInfo::ParamResult::Maximum;
-									default:
-										return KeywordInfo::ParamResult::Excess;
-								}
-							},
-							.is_static = false,
-							.is_dynamic = true
-						};
-					};
-
-					words[L"kill"] =
-						words[L"EQ"] = [](const std::vector<std::wstring>& params) -> KeywordInfo {
-						return {
-							.Result = [&]() noexcept -> CommandPtr {
-								const auto [Var, Type] = Default_ProgramInterface.GetParamInfo(params[0]);
-								if (Default_ProgramInterface.IsStringType(Type))
-									return std::make_unique<command::entity::Kill>(Var);
-								else
-									return std::make_unique<command::entity::Kill>(params);
-							},
-							.checkParamState = [params]() -> KeywordInfo::ParamResult {
-								switch (params.size()) {
-									case 0:
-										return KeywordInfo::ParamResult::Lack;
-									case 1:
-										return KeywordInfo::ParamResult::Maximum;
-									default:
-										return KeywordInfo::ParamResult::Excess;
-								}
-							},
-							.is_static = false,
-							.is_dynamic = true
-						};
-					};
-
-					words[L"makelayer"] =
-						words[L"C["] = [](const std::vector<std::wstring>& params) -> KeywordInfo {
-						return {
-							.Result = [&]() noexcept -> CommandPtr {
-								const auto [Index, Index_Type] = Default_ProgramInterface.GetParamInfo(params[0]);
-								const auto [Kind, Kind_Type] = Default_ProgramInterface.GetParamInfo(params[1]);
-								const auto [Name, Name_Type] = Default_ProgramInterface.GetParamInfo(params[2]);
-								if (Default_ProgramInterface.IsNumberType(Index_Type) &&
-									Default_ProgramInterface.IsStringType(Kind_Type) &&
-									Default_ProgramInterface.IsStringType(Name_Type))
-								{
-									auto i = ToInt<int>(Index.c_str(), nullptr);
-									return std::make_unique<command::layer::Make>(i, Kind, Name);
-								} else
-									return std::make_unique<command::layer::Make>(params);
-							},
-							.checkParamState = [params]() -> KeywordInfo::ParamResult {
-								switch (params.size()) {
-									case 0:
-									case 1:
-									case 2:
-										return KeywordInfo::ParamResult::Lack;
-									case 3:
-										return KeywordInfo::ParamResult::Maximum;
-									default:
-										return KeywordInfo::ParamResult::Excess;
-								}
-							},
-							.is_static = false,
-							.is_dynamic = true
-						};
-					};
-
-					words[L"setbasis"] =
-						words[L"C["] = [](const std::vector<std::wstring>& params) -> KeywordInfo {
-						return {
-							.Result = [&]() noexcept -> CommandPtr {
-								const auto [Entity_Name, Entity_Name_Type] = Default_ProgramInterface.GetParamInfo(params[0]);
-								const auto [Layer_Name, Layer_Name_Type] = Default_ProgramInterface.GetParamInfo(params[1]);
-								if (Default_ProgramInterface.IsStringType(Entity_Name_Type) && Default_ProgramInterface.IsStringType(Layer_Name_Type))
-									return std::make_unique<command::layer::SetBasis>(Entity_Name, Layer_Name);
-								else
-									return std::make_unique<command::layer::SetBasis>(params);
-							},
-							.checkParamState = [params]() -> KeywordInfo::ParamResult {
-								switch (params.size()) {
-									case 0:
-									case 1:
-										return KeywordInfo::ParamResult::Lack;
-									case 2:
-										return KeywordInfo::ParamResult::Maximum;
-									default:
-										return KeywordInfo::ParamResult::Excess;
+									error_occurred = already_new_event_name_defined_error;
+									event::Manager::Instance().error_handler.SendLocalError(error_occurred, (L"多重定義として判定されたイベント名: " + stack.front()));
 								}
-							},
-							.is_static = false,
-							.is_dynamic = true
-						};
-					};
+							} else if (op == L"<>") {
+								stack.pop_front();
+								if (trigger_type == TriggerType::Invalid) {
+									auto word = stack.front();
+									if (word == L"a") {
+										trigger_type = TriggerType::Auto;
+									} else if (word == L"t") {
+										trigger_type = TriggerType::Trigger;
+									} else if (word == L"n") {
+										trigger_type = TriggerType::None;
+									} else if (word == L"l") {
+										trigger_type = TriggerType::Load;
+									} else {
+										trigger_type = TriggerType::None;
+										event::Manager::Instance().error_handler.SendLocalError(invalid_trigger_type_warning);
+									}
+									stack.pop_front();
 
-					words[L"selectlayer"] =
-						words[L"C[I"] = [](const std::vector<std::wstring>& params) -> KeywordInfo {
-						return {
-							.Result = [&]() noexcept -> CommandPtr {
-								const auto [Name, Name_Type] = Default_ProgramInterface.GetParamInfo(params[0]);
-								if (Default_ProgramInterface.IsStringType(Name_Type))
-									return std::make_unique<command::layer::Select>(Name);
-								else
-									return std::make_unique<command::layer::Select>(params);
-							},
-							.checkParamState = [params]() -> KeywordInfo::ParamResult {
-								switch (params.size()) {
-									case 0:
-										return KeywordInfo::ParamResult::Lack;
-									case 1:
-										return KeywordInfo::ParamResult::Maximum;
-									default:
-										return KeywordInfo::ParamResult::Excess;
+									for (int i = 0; !stack.empty(); ) {
+										if (stack.front() == L"~")
+											i = 1;
+										else {
+											origin[(origin[0][1] > -1)][i] = ToDec<Dec>(stack.front().c_str(), nullptr);
+											i = 0;
+										}
+										stack.pop_front();
+									}
+								} else {
+									error_occurred = already_new_trigger_type_defined_error;
+									event::Manager::Instance().error_handler.SendLocalError(error_occurred, (L"多重定義として判定された発生タイプ名: " + stack.front()));
 								}
-							},
-							.is_static = false,
-							.is_dynamic = true
-						};
-					};
-
-					words[L"deletelayer"] =
-						words[L"C[폜"] = [](const std::vector<std::wstring>& params) -> KeywordInfo {
-						return {
-							.Result = [&]() noexcept -> CommandPtr {
-								const auto [Name, Name_Type] = Default_ProgramInterface.GetParamInfo(params[0]);
-								if (Default_ProgramInterface.IsStringType(Name_Type))
-									return std::make_unique<command::layer::Delete>(Name);
-								else
-									return std::make_unique<command::layer::Delete>(params);
-							},
-							.checkParamState = [params]() -> KeywordInfo::ParamResult {
-								switch (params.size()) {
-									case 0:
-										return KeywordInfo::ParamResult::Lack;
-									case 1:
-										return KeywordInfo::ParamResult::Maximum;
-									default:
-										return KeywordInfo::ParamResult::Excess;
+							} else if (op == L"()") {
+								stack.pop_front();
+								while (!stack.empty()) {
+									params.push_back(stack.front());
+									stack.pop_front();
 								}
-							},
-							.is_static = false,
-							.is_dynamic = true
-						};
-					};
-
-					words[L"showlayer"] =
-						words[L"C[\"] = [](const std::vector<std::wstring>& params) -> KeywordInfo {
-						return {
-							.Result = [&]() noexcept -> CommandPtr {
-								const auto [Name, Name_Type] = Default_ProgramInterface.GetParamInfo(params[0]);
-								return (Default_ProgramInterface.IsStringType(Name_Type) ?
-									std::make_unique<command::layer::Show>(Name) : std::make_unique<command::layer::Show>(params));
-							},
-							.checkParamState = [params]() -> KeywordInfo::ParamResult {
-								switch (params.size()) {
-									case 0:
-										return KeywordInfo::ParamResult::Lack;
-									case 1:
-										return KeywordInfo::ParamResult::Maximum;
-									default:
-										return KeywordInfo::ParamResult::Excess;
+							} else if (op == L"{}") {
+								found_command_sentence = true;
+								stack.pop_front();
+								std::wstring command_name{};
+								GenerateFunc generator_candidate{};
+								while (!stack.empty()) {
+									if (auto generate = keyword::Find(stack.front()); generate != nullptr) {
+										command_name = stack.front();
+										generator_candidate = std::move(generate);
+									} else {
+										command_parameters.push_back(stack.front());
+									}
+									stack.pop_front();
 								}
-							},
-							.is_static = false,
-							.is_dynamic = true
-						};
-					};
 
-					words[L"hidelayer"] =
-						words[L"C[\"] = [](const std::vector<std::wstring>& params) -> KeywordInfo {
-						return {
-							.Result = [&]() noexcept -> CommandPtr {
-								const auto [Name, Name_Type] = Default_ProgramInterface.GetParamInfo(params[0]);
-								return (Default_ProgramInterface.IsStringType(Name_Type) ?
-									std::make_unique<command::layer::Hide>(Name) : std::make_unique<command::layer::Hide>(params));
-							},
-							.checkParamState = [params]() -> KeywordInfo::ParamResult {
-								switch (params.size()) {
-									case 0:
-										return KeywordInfo::ParamResult::Lack;
-									case 1:
-										return KeywordInfo::ParamResult::Maximum;
-									default:
-										return KeywordInfo::ParamResult::Excess;
-								}
-							},
-							.is_static = false,
-							.is_dynamic = true
-						};
-					};
+								if (generator_candidate != nullptr) {
+									auto generator = generator_candidate(command_parameters);
+									switch (generator.checkParamState()) {
+										case KeywordInfo::ParamResult::Lack:
+											error_occurred = lack_of_parameters_error;
+											event::Manager::Instance().error_handler.SendLocalError(
+												error_occurred,
+												(L"コマンド名: " + command_name).c_str()
+											);
+											break;
+										case KeywordInfo::ParamResult::Medium:
+										case KeywordInfo::ParamResult::Maximum:
+											if (command_name == L"case") {
+												if (!case_stack.front().second) {
+													// elseが無い為、暗黙的に空のelseを挿入。
+													commands.push_front(CommandTree{
+														.command = keyword::Find(L"else")({}).Result(),
+														.word = L"else",
+														.parent = parent
+													});
+													parent = &commands.front();
+												}
+												case_stack.pop_front();
+											} else if (command_name == L"endcase") {
+												// else検査開始。
+												case_stack.push_front({ commands.begin(), false });
+											} else if (command_name == L"else") {
+												// elseが存在するのでtrue。
+												case_stack.front().second = true;
+											}
 
-					words[L"bind"] =
-						words[L"L["] = [this](const std::vector<std::wstring>& params) -> KeywordInfo {
-						return {
-						.Result = [&]() -> CommandPtr {
-							const auto [Base, Base_Type] = Default_ProgramInterface.GetParamInfo(params[0]);
-							const auto [Cmd, Cmd_Type] = Default_ProgramInterface.GetParamInfo(params[1]);
-							if (Default_ProgramInterface.IsStringType(Base_Type)) {
-								std::wstring sub_param = Cmd + L' ';
-								for (auto it = params.begin() + 2; it != params.end(); it++) {
-									auto [word, word_type] = Default_ProgramInterface.GetParamInfo(*it);
-									if (Default_ProgramInterface.IsStringType(word_type)) {
-										sub_param += L'\'' + word + L'\'' + std::wstring(L" ");
-									} else {
-										sub_param += word + std::wstring(L" ");
+											commands.push_front(CommandTree{
+												.command = generator.Result(),
+												.word = command_name,
+												.parent = parent,
+												.params = command_parameters
+											});
+											parent = &commands.front();
+											break;
+										case KeywordInfo::ParamResult::Excess:
+											event::Manager::Instance().error_handler.SendLocalError(
+												too_many_parameters_warning,
+												(L"コマンド名: " + command_name).c_str()
+											);
+											break;
+									}
+								} else {
+									if (!command_name.empty()) {
+										error_occurred = command_not_found_error;
+										event::Manager::Instance().error_handler.SendLocalError(error_occurred, L"コマンド名: " + command_name);
 									}
 								}
-								return std::make_unique<command::Bind>(Base, sub_param);
-							} else
-								return nullptr;
-						},
-						.checkParamState = [&]() -> KeywordInfo::ParamResult {
-							if (params.size() <= 1) {
-								return KeywordInfo::ParamResult::Lack;
+								command_parameters.clear();
 							}
+							queue.pop_front();
+						}
+						stack.clear();
 
-							const auto [Cmd, Cmd_Type] = Default_ProgramInterface.GetParamInfo(params[1]);
-							auto it = words.find(Cmd);
-							if (it == words.end())
-								return KeywordInfo::ParamResult::Lack;
-
-							std::vector<std::wstring> exparams{};
-							for (auto it = params.begin() + 2; it < params.end(); it++) {
-								exparams.push_back(*it);
-							}
-							return it->second(exparams).checkParamState();
-						},
-						.is_static = false,
-						.is_dynamic = true
-						};
-					};
+						if (event::Manager::Instance().error_handler.ShowLocalError(4)) {
+							break;
+						}
 
-					words[L"alias"] =
-						words[L"ʖ"] = [](const std::vector<std::wstring>& params) -> KeywordInfo {
-						return {
-							.Result = [&]() -> CommandPtr {
-								const auto [Base, Base_Type] = Default_ProgramInterface.GetParamInfo(params[0]);
-								const auto [New_One, New_Type] = Default_ProgramInterface.GetParamInfo(params[1]);
-								if (Default_ProgramInterface.IsNoType(Base_Type) && Default_ProgramInterface.IsNoType(New_Type))
-									return std::make_unique<command::Alias>(Base, New_One);
-								else
-									return nullptr;
-							},
-							.checkParamState = [params]() -> KeywordInfo::ParamResult {
-								switch (params.size()) {
-									case 0:
-									case 1:
-										return KeywordInfo::ParamResult::Lack;
-									case 2:
-										return KeywordInfo::ParamResult::Maximum;
-									default:
-										return KeywordInfo::ParamResult::Excess;
-								}
-							},
-							.is_static = true,
-							.is_dynamic = false
-						};
-					};
+						if (!event_name.empty() && found_command_sentence) {
+							parsing_events[event_name].trigger_type = trigger_type;
+							parsing_events[event_name].param_names = std::move(params);
+							for (int i = 0; i < 2; i++)
+								parsing_events[event_name].origin[i] = origin[i];
 
-					// DLLA^b`
-					words[L"attach"] =
-						words[L"ڑ"] = [](const std::vector<std::wstring>& params) -> KeywordInfo {
-						return {
-							.Result = [&]() -> CommandPtr {
-								const auto [Var, Type] = Default_ProgramInterface.GetParamInfo(params[0]);
-								return (Default_ProgramInterface.IsStringType(Type) ?
-									std::make_unique<command::Attach>(Var) : nullptr);
-							},
-							.checkParamState = [params]() -> KeywordInfo::ParamResult {
-								switch (params.size()) {
-									case 0:
-										return KeywordInfo::ParamResult::Lack;
-									case 1:
-										return KeywordInfo::ParamResult::Maximum;
-									default:
-										return KeywordInfo::ParamResult::Excess;
-								}
-							},
-							.is_static = true,
-							.is_dynamic = false
-						};
-					};
+							parsing_events[event_name].commands = std::move(commands);
+							trigger_type = TriggerType::Invalid;
+							commands.clear();
+							params.clear();
+							event_name.clear();
+							parent = nullptr;
+							found_command_sentence = false;
+						}
+					}
+				}
 
-					// DLLf^b`
-					words[L"detach"] =
-						words[L"ؒf"] = [](const std::vector<std::wstring>& params) -> KeywordInfo {
-						return {
-							.Result = [&]() -> CommandPtr {
-								const auto [Var, Type] = Default_ProgramInterface.GetParamInfo(params[0]);
-								return (Default_ProgramInterface.IsStringType(Type) ?
-									std::make_unique<command::Detach>(Var) : nullptr);
-							},
-							.checkParamState = [params]() -> KeywordInfo::ParamResult {
-								switch (params.size()) {
-									case 0:
-										return KeywordInfo::ParamResult::Lack;
-									case 1:
-										return KeywordInfo::ParamResult::Maximum;
-									default:
-										return KeywordInfo::ParamResult::Excess;
-								}
-							},
-							.is_static = true,
-							.is_dynamic = false
-						};
-					};
+				auto& Result() {
+					return parsing_events;
+				}
+			};
+#endif
 
-					// OCxgt@Cǂݍ
-					words[L"load"] =
-						words[L"Ǎ"] = [](const std::vector<std::wstring>& params) -> KeywordInfo {
-						return {
-							.Result = [&]() -> CommandPtr {
-								const auto [Path, Path_Type] = Default_ProgramInterface.GetParamInfo(params[0]);
-								return (Default_ProgramInterface.IsStringType(Path_Type) ?
-									std::make_unique<command::Load>(Path) : std::make_unique<command::Load>(params));
-							},
-							.checkParamState = [params]() -> KeywordInfo::ParamResult {
-								switch (params.size()) {
-									case 0:
-										return KeywordInfo::ParamResult::Lack;
-									case 1:
-										return KeywordInfo::ParamResult::Maximum;
-									default:
-										return KeywordInfo::ParamResult::Excess;
-								}
-							},
-							.is_static = false,
-							.is_dynamic = true
-						};
-					};
+			// 最適化機構
+			// 意味解析直後のコマンド列(先頭から順に、次のコマンドを親に持つ一本の列)に対して各処理を行い、
+			// 最後に親を付け直してから分岐を並べ直す。
+			class Optimizer final {
+				using Iterator = std::list<CommandTree>::iterator;
 
-					// OCxgt@Cǂݍ
-					words[L"import"] =
-						words[L"捞"] = [](const std::vector<std::wstring>& params) -> KeywordInfo {
-						return {
-							.Result = [&]() -> CommandPtr {
-								const auto [Path, Path_Type] = Default_ProgramInterface.GetParamInfo(params[0]);
-								return (Default_ProgramInterface.IsStringType(Path_Type) ?
-									std::make_unique<command::Import>(Path) : std::make_unique<command::Import>(params));
-							},
-							.checkParamState = [params]() -> KeywordInfo::ParamResult {
-								switch (params.size()) {
-									case 0:
-										return KeywordInfo::ParamResult::Lack;
-									case 1:
-										return KeywordInfo::ParamResult::Maximum;
-									default:
-										return KeywordInfo::ParamResult::Excess;
-								}
-							},
-							.is_static = false,
-							.is_dynamic = true
-						};
-					};
+				// 引数
+				struct Operand final {
+					std::wstring name{};	// 定数の場合は型を除いた値、変数の場合は引数そのもの
+					bool is_number = false, is_string = false;
 
-					words[L"call"] =
-						words[L"ďo"] = [](const std::vector<std::wstring>& params) -> KeywordInfo {
-						return {
-							.Result = [&]() -> CommandPtr {
-								return std::make_unique<command::Call>(params);
-							},
-							.checkParamState = [params]() -> KeywordInfo::ParamResult {
-								switch (params.size()) {
-									case 0:
-										return KeywordInfo::ParamResult::Lack;
-									default:
-										return KeywordInfo::ParamResult::Medium;
-								}
-							},
-							.is_static = false,
-							.is_dynamic = true
-						};
-					};
+					bool IsLiteral() const noexcept {
+						return is_number || is_string;
+					}
 
-					words[L"var"] =
-						words[L"ϐ"] = [](const std::vector<std::wstring>& params) -> KeywordInfo {
-						return {
-							.Result = [&]() -> CommandPtr {
-								const auto [Var, Var_Type] = Default_ProgramInterface.GetParamInfo(params[0]);
-								const auto [Value, Value_Type] = Default_ProgramInterface.GetParamInfo(params[1]);
-								if (Var_Type == L"")
-									return std::make_unique<command::Variable>(Var, Value);
-								else
-									return std::make_unique<command::Variable>(params);
-							},
-							.checkParamState = [params]() -> KeywordInfo::ParamResult {
-								switch (params.size()) {
-									case 0:
-									case 1:
-										return KeywordInfo::ParamResult::Lack;
-									case 2:
-										return KeywordInfo::ParamResult::Maximum;
-									default:
-										return KeywordInfo::ParamResult::Excess;
-								}
-							},
-							.is_static = true,
-							.is_dynamic = false
-						};
-					};
+					// 文字列中の{}で変数の値を読むか否か。
+					bool IsFormat() const noexcept {
+						return is_string && name.find(L'{') != name.npos;
+					}
+				};
 
-					words[L"global"] =
-						words[L""] = [](const std::vector<std::wstring>& params) -> KeywordInfo {
-						return {
-							.Result = [&]() -> CommandPtr {
-								const auto [Var, Var_Type] = Default_ProgramInterface.GetParamInfo(params[0]);
-								const auto [Value, Value_Type] = Default_ProgramInterface.GetParamInfo(params[1]);
-								if (Var_Type == L"")
-									return std::make_unique<command::Global>(Var, Value);
-								else
-									return std::make_unique<command::Global>(params);
-							},
-							.checkParamState = [params]() -> KeywordInfo::ParamResult {
-								switch (params.size()) {
-									case 0:
-									case 1:
-										return KeywordInfo::ParamResult::Lack;
-									case 2:
-										return KeywordInfo::ParamResult::Maximum;
-									default:
-										return KeywordInfo::ParamResult::Excess;
-								}
-							},
-							.is_static = true,
-							.is_dynamic = false
-						};
-					};
+				// case内の分岐の評価結果
+				enum class ArmState : uint8 {
+					True,		// 必ず成り立つ
+					False,		// 必ず成り立たない
+					Unknown		// 実行時まで分からない
+				};
 
-					words[L"exist"] =
-						words[L"݊mF"] = [](const std::vector<std::wstring>& params)->KeywordInfo {
-						return {
-							.Result = [&]() -> CommandPtr {
-								return std::make_unique<command::Exist>(params);
-							},
-							.checkParamState = [params]() -> KeywordInfo::ParamResult {
-								switch (params.size()) {
-									case 0:
-									case 1:
-										return KeywordInfo::ParamResult::Lack;
-									case 2:
-										return KeywordInfo::ParamResult::Maximum;
-									default:
-										return KeywordInfo::ParamResult::Excess;
-								}
-							},
-							.is_static = false,
-							.is_dynamic = true
-						};
-					};
+				static Operand ToOperand(const std::wstring& Param) {
+					const auto [Name, Type] = Default_ProgramInterface.GetParamInfo(Param);
+					Operand operand{};
+					operand.is_number = Default_ProgramInterface.IsNumberType(Type);
+					operand.is_string = Default_ProgramInterface.IsStringType(Type);
+					operand.name = (operand.IsLiteral() ? Name : Param);
+					return operand;
+				}
 
-					words[L"filter"] =
-						words[L"tB^["] = [](const std::vector<std::wstring>& params) -> KeywordInfo {
-						return {
-							.Result = [&]() -> CommandPtr {
-								const auto [Layer_Name, Layer_Name_Type] = Default_ProgramInterface.GetParamInfo(params[0]);
-								const auto [Filter_Name, Filter_Name_Type] = Default_ProgramInterface.GetParamInfo(params[1]);
-								const auto [Potency_Value, Potency_Value_Type] = Default_ProgramInterface.GetParamInfo(params[2]);
-								if (Default_ProgramInterface.IsStringType(Layer_Name_Type) &&
-									Default_ProgramInterface.IsStringType(Filter_Name_Type) &&
-									Default_ProgramInterface.IsNumberType(Potency_Value_Type))
-								{
-									const auto Potency = std::stoi(Potency_Value);
-									return std::make_unique<command::Filter>(Layer_Name, Filter_Name, Potency);
-								} else {
-									return std::make_unique<command::Filter>(params);
-								}
-							},
-							.checkParamState = [params]() -> KeywordInfo::ParamResult {
-								switch (params.size()) {
-									case 0:
-									case 1:
-									case 2:
-										return KeywordInfo::ParamResult::Lack;
-									case 3:
-										return KeywordInfo::ParamResult::Maximum;
-									default:
-										return KeywordInfo::ParamResult::Excess;
-								}
-							},
-							.is_static = false,
-							.is_dynamic = true
-						};
-					};
+				// 数値定数の値
+				// DynamicCommandと同じ規則で、整数か浮動小数点数かを決める。
+				static Value NumberOf(const std::wstring& Text) noexcept {
+					auto [iv, ip] = ToInt(Text.c_str());
+					auto [fv, fp] = ToDec<Dec>(Text.c_str());
+					if (wcslen(ip) <= 0)
+						return iv;
+					else
+						return fv;
+				}
 
-					words[L"case"] =
-						words[L""] = [&](const std::vector<std::wstring>& params) -> KeywordInfo {
-						return {
-							.Result = [&]() -> CommandPtr {
-								const auto [Var, Var_Type] = Default_ProgramInterface.GetParamInfo(params[0]);
-								if (!Default_ProgramInterface.IsUndecidedType(Var_Type))
-									return std::make_unique<command::Case>(Var);
-								else
-									return std::make_unique<command::Case>(params);
-							},
-							.checkParamState = [params]() -> KeywordInfo::ParamResult {
-								switch (params.size()) {
-									case 0:
-										return KeywordInfo::ParamResult::Lack;
-									case 1:
-										return KeywordInfo::ParamResult::Maximum;
-									default:
-										return KeywordInfo::ParamResult::Excess;
-								}
-							},
-							.is_static = false,
-							.is_dynamic = true
-						};
-					};
+				// 別名を含め、英語名がNameのコマンドであるか否か。
+				static bool Is(const CommandTree& Tree, const std::wstring_view Name) noexcept {
+					const auto English = keyword::BuiltinName(Tree.word);
+					return !English.empty() && English == keyword::Builtin_Table.EnglishName(Name);
+				}
 
-					words[L"of"] =
-						words[L""] = [](const std::vector<std::wstring>& params) -> KeywordInfo {
-						return {
-							.Result = [&]() -> CommandPtr {
-								if (params.size() == 1) {
-									const auto [Var, Type] = Default_ProgramInterface.GetParamInfo(params[0]);
-									if (Default_ProgramInterface.IsNumberType(Type)) {
-										auto [iv, ip] = ToInt(Var.c_str());
-										auto [fv, fp] = ToDec<Dec>(Var.c_str());
-
-										if (wcslen(ip) <= 0)
-											return std::make_unique<command::Of>(L"==", iv);
-										else
-											return std::make_unique<command::Of>(L"==", fv);
-									} else if (Default_ProgramInterface.IsStringType(Type)) {
-										return std::make_unique<command::Of>(L"==", Var);
-									} else {
-										return std::make_unique<command::Of>(std::vector<std::wstring>{ L"==", params[0] });
-									}
-								} else {
-									auto [mode, mode_type] = Default_ProgramInterface.GetParamInfo(params[0]);
-									const auto [Var, Type] = Default_ProgramInterface.GetParamInfo(params[1]);
-
-									mode = mode.substr(mode.find(L'.') + 1);
-									if (Default_ProgramInterface.IsNumberType(Type)) {
-										auto [iv, ip] = ToInt(Var.c_str());
-										auto [fv, fp] = ToDec<Dec>(Var.c_str());
-										if (wcslen(ip) <= 0)
-											return std::make_unique<command::Of>(mode, iv);
-										else
-											return std::make_unique<command::Of>(mode, fv);
-									} else if (Default_ProgramInterface.IsStringType(Type)) {
-										return std::make_unique<command::Of>(mode, Var);
-									} else {
-										return std::make_unique<command::Of>(params);
-									}
-								}
-							},
-							.checkParamState = [params]() -> KeywordInfo::ParamResult {
-								switch (params.size()) {
-									case 0:
-										return KeywordInfo::ParamResult::Lack;
-									case 1:
-										return KeywordInfo::ParamResult::Medium;
-									case 2:
-										return KeywordInfo::ParamResult::Maximum;
-									default:
-										return KeywordInfo::ParamResult::Excess;
-								}
-							},
-							.is_static = false,
-							.is_dynamic = true
-						};
-					};
+				// 第1引数の変数へ代入する演算コマンドであるか否か。
+				static bool IsMath(const CommandTree& Tree) noexcept {
+					for (const auto Name : { L"assign", L"sum", L"sub", L"mul", L"div", L"mod", L"or", L"and", L"xor", L"not" }) {
+						if (Is(Tree, Name))
+							return true;
+					}
+					return false;
+				}
 
-					words[L"else"] =
-						words[L"ȊO"] = [](const std::vector<std::wstring>& params) -> KeywordInfo {
-						return {
-							.Result = [&]() -> CommandPtr {
-								return std::make_unique<command::Else>();
-							},
-							.checkParamState = [params]() -> KeywordInfo::ParamResult {
-								switch (params.size()) {
-									case 0:
-										return KeywordInfo::ParamResult::Maximum;
-									default:
-										return KeywordInfo::ParamResult::Excess;
-								}
-							},
-							.is_static = false,
-							.is_dynamic = true
-						};
-					};
+				static CommandTree MakeCommand(const std::wstring& Word, std::vector<std::wstring> params) {
+					auto command = keyword::Find(Word)(params).Result();
+					return CommandTree{ .command = std::move(command), .word = Word, .params = std::move(params) };
+				}
 
-					words[L"endcase"] =
-						words[L"I"] = [](const std::vector<std::wstring>& params) -> KeywordInfo {
-						return {
-							.Result = [&]() -> CommandPtr {
-								return std::make_unique<command::EndCase>();
-							},
-							.checkParamState = [params]() -> KeywordInfo::ParamResult {
-								switch (params.size()) {
-									case 0:
-										return KeywordInfo::ParamResult::Maximum;
-									default:
-										return KeywordInfo::ParamResult::Excess;
-								}
-							},
-							.is_static = false,
-							.is_dynamic = true
-						};
-					};
+				// コマンド列が一本の列であるか否か。
+				static bool IsLinear(const std::list<CommandTree>& Commands) noexcept {
+					for (auto it = Commands.begin(); it != Commands.end(); it++) {
+						const auto Next = std::next(it);
+						if (it->parent != (Next != Commands.end() ? &(*Next) : nullptr))
+							return false;
+					}
+					return true;
+				}
 
-					words[L"__entityXV"] = [](const std::vector<std::wstring>& params) -> KeywordInfo {
-						return {
-							.Result = [&]() -> CommandPtr {
-								return std::make_unique<command::hidden::UpdateEntity>();
-							},
-							.checkParamState = [params]() -> KeywordInfo::ParamResult {
-								switch (params.size()) {
-									case 0:
-										return KeywordInfo::ParamResult::Maximum;
-									default:
-										return KeywordInfo::ParamResult::Excess;
-								}
-							},
-							.is_static = false,
-							.is_dynamic = true
-						};
-					};
+				// 並び順の通りに親を付け直す。
+				static void Relink(std::list<CommandTree>* commands) noexcept {
+					CommandTree *parent{};
+					for (auto it = commands->rbegin(); it != commands->rend(); it++) {
+						it->parent = parent;
+						parent = &(*it);
+					}
+				}
 
-					words[L"assign"] = words[L""] = [](const std::vector<std::wstring>& params) -> KeywordInfo {
-						return {
-							.Result = [&]() -> CommandPtr {
-								return std::make_unique<command::math::Assign>(params);
-							},
-							.checkParamState = [params]() -> KeywordInfo::ParamResult {
-								switch (params.size()) {
-									case 0:
-									case 1:
-										return KeywordInfo::ParamResult::Lack;
-									case 2:
-										return KeywordInfo::ParamResult::Maximum;
-									default:
-										return KeywordInfo::ParamResult::Excess;
-								}
-							},
-							.is_static = false,
-							.is_dynamic = true
-						};
+				// 定数同士の演算結果を、代入する値(値:型)として返す。
+				// 畳み込めない場合は空文字列を返す。
+				// 整数の桁あふれ・0除算・有限でない結果等、実行時と結果が変わりうる場合は畳み込まない。
+				static std::wstring Fold(const CommandTree& Tree) {
+					enum class Operation : uint8 { Sum, Sub, Mul, Div, Mod, Or, And, Xor, Not };
+					constexpr std::pair<const wchar_t*, Operation> Operations[] = {
+						{ L"sum", Operation::Sum }, { L"sub", Operation::Sub }, { L"mul", Operation::Mul },
+						{ L"div", Operation::Div }, { L"mod", Operation::Mod }, { L"or", Operation::Or },
+						{ L"and", Operation::And }, { L"xor", Operation::Xor }, { L"not", Operation::Not }
 					};
 
-					words[L"sum"] = words[L"Z"] = [](const std::vector<std::wstring>& params) -> KeywordInfo {
-						return {
-							.Result = [&]() -> CommandPtr {
-								return std::make_unique<command::math::Sum>(params);
-							},
-							.checkParamState = [params]() -> KeywordInfo::ParamResult {
-								switch (params.size()) {
-									case 0:
-									case 1:
-									case 2:
-										return KeywordInfo::ParamResult::Lack;
-									case 3:
-										return KeywordInfo::ParamResult::Maximum;
-									default:
-										return KeywordInfo::ParamResult::Excess;
-								}
-							},
-							.is_static = false,
-							.is_dynamic = true
-						};
-					};
+					const auto Found = std::find_if(std::begin(Operations), std::end(Operations), [&Tree](const auto& O) {
+						return Is(Tree, O.first);
+					});
+					if (Found == std::end(Operations))
+						return {};
+
+					const auto Op = Found->second;
+					const size_t Operand_Count = (Op == Operation::Not ? 1 : 2);
+					if (Tree.params.size() != Operand_Count + 1)
+						return {};
+
+					Value value[2]{};
+					for (size_t i = 0; i < Operand_Count; i++) {
+						const auto Operand = ToOperand(Tree.params[i + 1]);
+						if (!Operand.is_number)
+							return {};
+						value[i] = NumberOf(Operand.name);
+					}
 
-					words[L"sub"] = words[L"Z"] = [](const std::vector<std::wstring>& params) -> KeywordInfo {
-						return {
-							.Result = [&]() -> CommandPtr {
-								return std::make_unique<command::math::Sub>(params);
-							},
-							.checkParamState = [params]() -> KeywordInfo::ParamResult {
-								switch (params.size()) {
-									case 0:
-									case 1:
-									case 2:
-										return KeywordInfo::ParamResult::Lack;
-									case 3:
-										return KeywordInfo::ParamResult::Maximum;
-									default:
-										return KeywordInfo::ParamResult::Excess;
-								}
-							},
-							.is_static = false,
-							.is_dynamic = true
-						};
-					};
+					const bool Is_Only_Int = (value[0].Is<int>() && (Operand_Count == 1 || value[1].Is<int>()));
+					const std::wstring Number_Type = std::wstring(L":") + innertype::Number;
+					if (Is_Only_Int) {
+						const int64 Left = value[0].Get<int>();
+						const int64 Right = (Operand_Count == 2 ? value[1].Get<int>() : 0);
+						int64 result{};
+						switch (Op) {
+							case Operation::Sum: result = Left + Right; break;
+							case Operation::Sub: result = Left - Right; break;
+							case Operation::Mul: result = Left * Right; break;
+							case Operation::Div:
+							case Operation::Mod:
+								if (Right == 0 || (Left == INT_MIN && Right == -1))
+									return {};
+								result = (Op == Operation::Div ? Left / Right : Left % Right);
+								break;
+							case Operation::Or: result = Left | Right; break;
+							case Operation::And: result = Left & Right; break;
+							case Operation::Xor: result = Left ^ Right; break;
+							case Operation::Not: result = ~Left; break;
+						}
+						if (result < INT_MIN || result > INT_MAX)
+							return {};
+						return std::to_wstring(result) + Number_Type;
+					}
 
-					words[L"mul"] = words[L"Z"] = [](const std::vector<std::wstring>& params) -> KeywordInfo {
-						return {
-							.Result = [&]() -> CommandPtr {
-								return std::make_unique<command::math::Mul>(params);
-							},
-							.checkParamState = [params]() -> KeywordInfo::ParamResult {
-								switch (params.size()) {
-									case 0:
-									case 1:
-									case 2:
-										return KeywordInfo::ParamResult::Lack;
-									case 3:
-										return KeywordInfo::ParamResult::Maximum;
-									default:
-										return KeywordInfo::ParamResult::Excess;
-								}
-							},
-							.is_static = false,
-							.is_dynamic = true
-						};
-					};
+					// ビット演算は整数のみ。
+					Dec result{};
+					switch (Op) {
+						case Operation::Sum: result = value[0].ToDec() + value[1].ToDec(); break;
+						case Operation::Sub: result = value[0].ToDec() - value[1].ToDec(); break;
+						case Operation::Mul: result = value[0].ToDec() * value[1].ToDec(); break;
+						case Operation::Div: result = value[0].ToDec() / value[1].ToDec(); break;
+						case Operation::Mod: result = fmod(value[0].ToDec(), value[1].ToDec()); break;
+						default:
+							return {};
+					}
+					if (!std::isfinite(result))
+						return {};
+
+					// 読み直した時に同じ値・同じ型(浮動小数点数)になるよう書き出す。
+					wchar_t text[40]{};
+					swprintf(text, std::size(text), L"%.17g", result);
+					std::wstring folded = text;
+					if (folded.find_first_of(L".e") == folded.npos)
+						folded += L".0";
+					return folded + Number_Type;
+				}
 
-					words[L"div"] = words[L"Z"] = [](const std::vector<std::wstring>& params) -> KeywordInfo {
-						return {
-							.Result = [&]() -> CommandPtr {
-								return std::make_unique<command::math::Div>(params);
-							},
-							.checkParamState = [params]() -> KeywordInfo::ParamResult {
-								switch (params.size()) {
-									case 0:
-									case 1:
-									case 2:
-										return KeywordInfo::ParamResult::Lack;
-									case 3:
-										return KeywordInfo::ParamResult::Maximum;
-									default:
-										return KeywordInfo::ParamResult::Excess;
-								}
-							},
-							.is_static = false,
-							.is_dynamic = true
-						};
-					};
+				// 定数同士の演算を、結果の代入へ置き換える。
+				static uint64 FoldConstants(std::list<CommandTree>* commands) {
+					uint64 count = 0;
+					for (auto& tree : *commands) {
+						auto folded = Fold(tree);
+						if (folded.empty())
+							continue;
+						tree = MakeCommand(L"assign", { tree.params[0], std::move(folded) });
+						count++;
+					}
+					return count;
+				}
 
-					words[L"mod"] = words[L"]"] = [](const std::vector<std::wstring>& params) -> KeywordInfo {
-						return {
-							.Result = [&]() -> CommandPtr {
-								return std::make_unique<command::math::Mod>(params);
-							},
-							.checkParamState = [params]() -> KeywordInfo::ParamResult {
-								switch (params.size()) {
-									case 0:
-									case 1:
-									case 2:
-										return KeywordInfo::ParamResult::Lack;
-									case 3:
-										return KeywordInfo::ParamResult::Maximum;
-									default:
-										return KeywordInfo::ParamResult::Excess;
-								}
-							},
-							.is_static = false,
-							.is_dynamic = true
-						};
-					};
+				// caseの範囲
+				struct CaseBlock final {
+					Iterator begin{};				// case
+					std::vector<Iterator> arms{};	// このcaseに属するof/else
+					Iterator end{};					// endcase
+				};
 
-					words[L"or"] =
-						words[L"_a"] = [](const std::vector<std::wstring>& params) -> KeywordInfo {
-						return {
-							.Result = [&]() -> CommandPtr {
-								return std::make_unique<command::math::Or>(params);
-							},
-							.checkParamState = [params]() -> KeywordInfo::ParamResult {
-								switch (params.size()) {
-									case 0:
-									case 1:
-									case 2:
-										return KeywordInfo::ParamResult::Lack;
-									case 3:
-										return KeywordInfo::ParamResult::Maximum;
-									default:
-										return KeywordInfo::ParamResult::Excess;
-								}
-							},
-							.is_static = false,
-							.is_dynamic = true
-						};
-					};
+				// 全てのcaseの範囲を、endcaseが現れる順(内側から外側)に返す。
+				static std::vector<CaseBlock> FindCaseBlocks(std::list<CommandTree>* commands) {
+					std::vector<CaseBlock> blocks{}, opened{};
+					for (auto it = commands->begin(); it != commands->end(); it++) {
+						if (it->word == L"case") {
+							opened.push_back(CaseBlock{ .begin = it });
+						} else if ((it->word == L"of" || it->word == L"else") && !opened.empty()) {
+							opened.back().arms.push_back(it);
+						} else if (it->word == L"endcase" && !opened.empty()) {
+							opened.back().end = it;
+							blocks.push_back(std::move(opened.back()));
+							opened.pop_back();
+						}
+					}
+					return blocks;
+				}
 
-					words[L"and"] =
-						words[L"_"] = [](const std::vector<std::wstring>& params) -> KeywordInfo {
-						return {
-							.Result = [&]() -> CommandPtr {
-								return std::make_unique<command::math::And>(params);
-							},
-							.checkParamState = [params]() -> KeywordInfo::ParamResult {
-								switch (params.size()) {
-									case 0:
-									case 1:
-									case 2:
-										return KeywordInfo::ParamResult::Lack;
-									case 3:
-										return KeywordInfo::ParamResult::Maximum;
-									default:
-										return KeywordInfo::ParamResult::Excess;
-								}
-							},
-							.is_static = false,
-							.is_dynamic = true
-						};
-					};
+				// 分岐を評価する。
+				// 先頭のelseは直前のof_stateにより決まる為、実行時まで分からない。
+				// 2番目以降のelseは、直前の分岐が成り立たなかった場合にのみ評価されるので必ず成り立つ。
+				static ArmState Evalute(const CaseBlock& Block, const size_t Index) noexcept {
+					const auto& Arm = *Block.arms[Index];
+					if (Arm.word != L"of")
+						return (Index == 0 ? ArmState::Unknown : ArmState::True);
+
+					const auto *const Of = static_cast<const command::Of*>(Arm.command.get());
+					if (Of->GetComparison() == Comparison::Unknown)
+						return ArmState::True;
+
+					const auto *const Target = static_cast<const command::Case*>(Block.begin->command.get())->Literal();
+					const auto *const Literal = Of->Literal();
+					if (Target == nullptr || Literal == nullptr)
+						return ArmState::Unknown;
+					return (EvaluteCondition(Of->GetComparison(), *Target, *Literal) ? ArmState::True : ArmState::False);
+				}
 
-					words[L"xor"] =
-						words[L"rI_a"] = [](const std::vector<std::wstring>& params) -> KeywordInfo {
-						return {
-							.Result = [&]() -> CommandPtr {
-								return std::make_unique<command::math::Xor>(params);
-							},
-							.checkParamState = [params]() -> KeywordInfo::ParamResult {
-								switch (params.size()) {
-									case 0:
-									case 1:
-									case 2:
-										return KeywordInfo::ParamResult::Lack;
-									case 3:
-										return KeywordInfo::ParamResult::Maximum;
-									default:
-										return KeywordInfo::ParamResult::Excess;
-								}
-							},
-							.is_static = false,
-							.is_dynamic = true
-						};
-					};
+				// 静的に結果が決まる分岐を削除する。
+				// 必ず成り立つ分岐より後の分岐、必ず成り立たない分岐を削除し、
+				// 先頭の分岐が必ず成り立つ場合はcase全体をその分岐の中身へ置き換える。
+				static void RemoveStaticArms(std::list<CommandTree>* commands, Manager::OptimizationStats* stats) {
+					for (auto& block : FindCaseBlocks(commands)) {
+						if (block.arms.empty())
+							continue;
 
-					words[L"not"] =
-						words[L"_ے"] = [](const std::vector<std::wstring>& params) -> KeywordInfo {
-						return {
-							.Result = [&]() -> CommandPtr {
-								return std::make_unique<command::math::Not>(params);
-							},
-							.checkParamState = [params]() -> KeywordInfo::ParamResult {
-								switch (params.size()) {
-									case 0:
-									case 1:
-										return KeywordInfo::ParamResult::Lack;
-									case 2:
-										return KeywordInfo::ParamResult::Maximum;
-									default:
-										return KeywordInfo::ParamResult::Excess;
-								}
-							},
-							.is_static = false,
-							.is_dynamic = true
+						// caseと最初の分岐の間のコマンドは実行されない。
+						for (auto it = std::next(block.begin); it != block.arms.front(); ) {
+							it = commands->erase(it);
+							stats->removed_unreachable++;
+						}
+
+						std::vector<ArmState> states(block.arms.size());
+						size_t arm_count = block.arms.size();
+						for (size_t i = 0; i < arm_count; i++) {
+							states[i] = Evalute(block, i);
+							if (states[i] == ArmState::True)
+								arm_count = i + 1;
+						}
+						// 分岐の終わり(次の分岐またはendcase)
+						auto arm_end = [&block, &arm_count](const size_t Index) {
+							return (Index + 1 < arm_count ? block.arms[Index + 1] : block.end);
 						};
+
+						if (arm_count < block.arms.size()) {
+							stats->removed_arms += block.arms.size() - arm_count;
+							commands->erase(block.arms[arm_count], block.end);
+						}
+
+						// elseが先頭の分岐にならないよう、また分岐が無くならないように残す。
+						std::vector<size_t> kept{};
+						for (size_t i = 0; i < arm_count; i++) {
+							const bool Is_Last = (i + 1 == arm_count);
+							const bool Else_Follows = (!Is_Last && block.arms[i + 1]->word != L"of");
+							if (states[i] == ArmState::False && !(kept.empty() && (Is_Last || Else_Follows))) {
+								commands->erase(block.arms[i], arm_end(i));
+								stats->removed_arms++;
+							} else {
+								kept.push_back(i);
+							}
+						}
+
+						const size_t First = kept.front();
+						if (states[First] != ArmState::True)
+							continue;
+
+						// 分岐を評価した後と同じく、of_stateを真にしておく。
+						commands->insert(block.begin, MakeCommand(L"assign", { L"of_state", std::wstring(L"1:") + innertype::Number }));
+						commands->erase(block.begin, std::next(block.arms[First]));
+						commands->erase(block.end);
+						stats->removed_arms++;
+						stats->expanded_cases++;
+					}
+				}
+
+				// 代入先の変数が、引数から読まれる変数と同じになりうるか否か。
+				// イベント内の変数(イベント名.変数名)が無い場合は同名の変数が使われる為、どちらの向きも同じとみなす。
+				static bool MayAlias(const std::wstring& Read, const std::wstring& Written) noexcept {
+					auto is_qualified = [](const std::wstring& Qualified, const std::wstring& Name) {
+						return Qualified.size() > Name.size() && Qualified.ends_with(Name) && Qualified[Qualified.size() - Name.size() - 1] == L'.';
 					};
+					return Read == Written || is_qualified(Written, Read) || is_qualified(Read, Written);
 				}
 
-				SemanticParser(std::list<Syntax> *syntax) noexcept : SemanticParser() {
-					// : ݂casẽCe[^
-					// E: else݂邩ۂB
-					std::list<std::pair<decltype(commands)::iterator, bool>> case_stack{};
-					// R}h𔭌ۂB
-					bool found_command_sentence = false;
+				// 演算コマンドが変数を読むか否か。
+				static bool Reads(const CommandTree& Tree, const std::wstring& Var) {
+					for (size_t i = 1; i < Tree.params.size(); i++) {
+						const auto Operand = ToOperand(Tree.params[i]);
+						if (Operand.IsFormat() || (!Operand.IsLiteral() && MayAlias(Operand.name, Var)))
+							return true;
+						// 添字付きの引数(配列[添字])は、添字の変数も読む。
+						if (!Operand.IsLiteral() && Operand.name.find(L'[') != Operand.name.npos)
+							return true;
+					}
+					return false;
+				}
 
-					for (auto it = syntax->begin(); it != syntax->end(); it++) {
-						if (std::find(visited.begin(), visited.end(), &(*it)) != visited.end()) {
+				// 読まれる前に上書きされる代入を削除する。
+				// 演算コマンドが連続する範囲のみを対象とし、それ以外のコマンドを挟む場合は削除しない。
+				// 実行時にエラーを出しうる代入は残す為、後の定数の代入で上書きされる定数の代入のみを削除する。
+				static uint64 RemoveDeadStores(std::list<CommandTree>* commands) {
+					// 定数の代入であるか否か。
+					// 他の演算は実行時に失敗すると代入先を変えない為、上書きとして扱えるのはこれのみとする。
+					auto is_literal_store = [](const CommandTree& Tree) {
+						if (!Is(Tree, L"assign") || Tree.params.size() != 2)
+							return false;
+						const auto Value = ToOperand(Tree.params[1]);
+						return Value.IsLiteral() && !Value.IsFormat();
+					};
+
+					uint64 count = 0;
+					auto it = commands->begin();
+					while (it != commands->end()) {
+						if (!IsMath(*it)) {
+							it++;
 							continue;
 						}
-						auto route = &(*it);
-						while (route != nullptr) {
-							visited.push_back(route);
-							queue.push_back(route);
-							route = route->parent;
-						}
 
-						while (!queue.empty() && error_occurred == nullptr) {
-							stack.push_front(queue.front()->text);
-							auto& op = stack.front();
-							if (op == L"[]") {
-								stack.pop_front();
-								if (event_name.empty()) {
-									switch (stack.size()) {
-										case 0:
-											error_occurred = empty_name_error;
-											event::Manager::Instance().error_handler.SendLocalError(error_occurred);
-											break;
-										case 1:
-											event_name = stack.front();
-											stack.pop_front();
-											break;
-										default:
-											std::wstring candidate_name{};
-											while (!stack.empty()) {
-												candidate_name += stack.front() + L' ';
-												stack.pop_front();
-											}
-											candidate_name.pop_back();
-											event_name = candidate_name;
-											break;
-									}
-								} else {
-									error_occurred = already_new_event_name_defined_error;
-									event::Manager::Instance().error_handler.SendLocalError(error_occurred, (L"d`ƂĔ肳ꂽCxg: " + stack.front()));
-								}
-							} else if (op == L"<>") {
-								stack.pop_front();
-								if (trigger_type == TriggerType::Invalid) {
-									auto word = stack.front();
-									if (word == L"a") {
-										trigger_type = TriggerType::Auto;
-									} else if (word == L"t") {
-										trigger_type = TriggerType::Trigger;
-									} else if (word == L"n") {
-										trigger_type = TriggerType::None;
-									} else if (word == L"l") {
-										trigger_type = TriggerType::Load;
-									} else {
-										trigger_type = TriggerType::None;
-										event::Manager::Instance().error_handler.SendLocalError(invalid_trigger_type_warning);
-									}
-									stack.pop_front();
+						auto run_end = it;
+						while (run_end != commands->end() && IsMath(*run_end))
+							run_end++;
 
-									for (int i = 0; !stack.empty(); ) {
-										if (stack.front() == L"~")
-											i = 1;
-										else {
-											origin[(origin[0][1] > -1)][i] = ToDec<Dec>(stack.front().c_str(), nullptr);
-											i = 0;
-										}
-										stack.pop_front();
-									}
-								} else {
-									error_occurred = already_new_trigger_type_defined_error;
-									event::Manager::Instance().error_handler.SendLocalError(error_occurred, (L"d`ƂĔ肳ꂽ^Cv: " + stack.front()));
-								}
-							} else if (op == L"()") {
-								stack.pop_front();
-								while (!stack.empty()) {
-									params.push_back(stack.front());
-									stack.pop_front();
-								}
-							} else if (op == L"{}") {
-								found_command_sentence = true;
-								stack.pop_front();
-								std::wstring command_name{};
-								GenerateFunc generator_candidate{};
-								while (!stack.empty()) {
-									auto it = words.find(stack.front());
-									if (it != words.end()) {
-										command_name = stack.front();
-										generator_candidate = it->second;
-									} else {
-										command_parameters.push_back(stack.front());
+						for (auto store = it; store != run_end; ) {
+							bool is_dead = false;
+							if (is_literal_store(*store)) {
+								const auto Var = ToOperand(store->params[0]).name;
+								for (auto next = std::next(store); next != run_end; next++) {
+									if (Reads(*next, Var))
+										break;
+									if (is_literal_store(*next) && ToOperand(next->params[0]).name == Var) {
+										is_dead = true;
+										break;
 									}
-									stack.pop_front();
 								}
+							}
 
-								if (generator_candidate != nullptr) {
-									auto generator = generator_candidate(command_parameters);
-									switch (generator.checkParamState()) {
-										case KeywordInfo::ParamResult::Lack:
-											error_occurred = lack_of_parameters_error;
-											event::Manager::Instance().error_handler.SendLocalError(
-												error_occurred,
-												(L"R}h: " + command_name).c_str()
-											);
-											break;
-										case KeywordInfo::ParamResult::Medium:
-										case KeywordInfo::ParamResult::Maximum:
-											if (command_name == L"case") {
-												if (!case_stack.front().second) {
-													// elseׁAÖٓIɋelse}B
-													commands.push_front(CommandTree{
-														.command = words[L"else"]({}).Result(),
-														.word = L"else",
-														.parent = parent
-													});
-													parent = &commands.front();
-												}
-												case_stack.pop_front();
-											} else if (command_name == L"endcase") {
-												// elseJnB
-												case_stack.push_front({ commands.begin(), false });
-											} else if (command_name == L"else") {
-												// elsê݂trueB
-												case_stack.front().second = true;
-											}
+							if (is_dead) {
+								store = commands->erase(store);
+								count++;
+							} else {
+								store++;
+							}
+						}
+						it = run_end;
+					}
+					return count;
+				}
 
-											commands.push_front(CommandTree{
-												.command = generator.Result(),
-												.word = command_name,
-												.parent = parent
-											});
-											parent = &commands.front();
-											break;
-										case KeywordInfo::ParamResult::Excess:
-											event::Manager::Instance().error_handler.SendLocalError(
-												too_many_parameters_warning,
-												(L"R}h: " + command_name).c_str()
-											);
+				// イベントの実行をフレームを跨いで中断しうるコマンドであるか否か。
+				// 呼び出したイベントが中断する場合もある為、callも含める。
+				static bool MaySuspend(const CommandTree& Tree) noexcept {
+					for (const auto Name : { L"wait", L"waituntil", L"yield", L"call" }) {
+						if (Is(Tree, Name))
+							return true;
+					}
+					return false;
+				}
+
+				// 後に必ず実行される読込によって上書きされる読込を削除する。
+				// 読込は要求のみを行い、実際の読込はフレームの終わりに最後の要求に対して行われる為、
+				// 後に定数のファイル名の読込がcaseの外で行われれば、それより前の定数の読込は意味を持たない。
+				// 分岐が一つも成り立たない場合はイベントの実行が終わる為、caseを挟む場合は削除しない。
+				// 中断を挟む場合も、中断前のフレームの終わりに読込が行われる為、削除しない。
+				static uint64 RemoveOverwrittenLoads(std::list<CommandTree>* commands) {
+					uint64 count = 0;
+					std::vector<Iterator> pending{};
+					int depth = 0;
+					for (auto it = commands->begin(); it != commands->end(); it++) {
+						if (it->word == L"case") {
+							depth++;
+							pending.clear();
+						} else if (it->word == L"endcase") {
+							depth--;
+						} else if (MaySuspend(*it)) {
+							pending.clear();
+						} else if (Is(*it, L"load") && it->params.size() == 1) {
+							const auto Path = ToOperand(it->params[0]);
+							if (!Path.is_string || Path.name.empty())
+								continue;
+
+							if (depth == 0) {
+								for (auto& overwritten : pending)
+									commands->erase(overwritten);
+								count += pending.size();
+								pending.clear();
+							}
+							pending.push_back(it);
+						}
+					}
+					return count;
+				}
+			public:
+				Optimizer() = default;
+
+				// 出来る限りの最適化。
+				// config.iniの[event] optimizeが0の場合は分岐の並べ直しのみを行う。
+				Optimizer(std::list<CommandTree> *commands) noexcept {
+					auto& manager = Manager::Instance();
+					if (manager.optimization_enabled && IsLinear(*commands)) {
+						auto& stats = manager.optimization_stats;
+						stats.folded_calculations += FoldConstants(commands);
+						RemoveStaticArms(commands, &stats);
+						stats.removed_stores += RemoveDeadStores(commands);
+						// 予算を設定した場合は、どの読込の間でも中断しうる為、読込を削除しない。
+						if (!manager.IsBudgeted())
+							stats.removed_loads += RemoveOverwrittenLoads(commands);
+						Relink(commands);
+						stats.optimized_events++;
+					}
+					// 適切な道の形成
+					SortOfElse(commands);
+				}
+
+				// of/elseコマンドをstd::list内のcaseの直後に並べ直す。
+				void SortOfElse(std::list<CommandTree> *commands) noexcept {
+					auto it = commands->begin();
+					std::list<decltype(it)> case_pos{};
+					// 各caseに対して、ofコマンドを挿入しなおした回数を保存するリスト。
+					std::list<int> inserted_counts{};
+					while (it != commands->end()) {
+						if (it->word == L"case") {
+							case_pos.push_front(it);
+							case_pos.front()->parent = nullptr;
+							inserted_counts.push_front(0);
+						} else if (it->word == L"of" || it->word == L"else") {
+							// 親の修正
+							{
+								// 多重分岐避け
+								std::list<CommandTree*> ignore_case{};
+								CommandTree *of_parent{};
+								auto parent = &(*it);
+								while (parent->parent != nullptr) {
+									if (parent->parent->word == L"case") {
+										ignore_case.push_back(parent->parent);
+									} else if ((parent->parent->word == L"of" || parent->parent->word == L"else") && of_parent == nullptr && ignore_case.empty()) {
+										// 次のコマンドがofコマンドまたはelseコマンド:
+										// 分岐終了なので変更対象に設定。
+										of_parent = parent;
+									} else if (parent->parent->word == L"endcase" && of_parent != nullptr) {
+										if (ignore_case.empty()) {
+											// 変更対象をendcaseコマンドに繋げる。
+											of_parent->parent = parent->parent;
 											break;
+										} else {
+											ignore_case.pop_back();
+										}
 									}
-								} else {
-									if (!command_name.empty()) {
-										error_occurred = command_not_found_error;
-										event::Manager::Instance().error_handler.SendLocalError(error_occurred, L"R}h: " + command_name);
-									}
+									parent = parent->parent;
 								}
-								command_parameters.clear();
 							}
-							queue.pop_front();
+							inserted_counts.front()++;
+							// ofコマンドの位置をcaseの直後に設定。
+							commands->insert(std::next(case_pos.front(), inserted_counts.front()), std::move(*it));
+							it = commands->erase(it);
+							continue;
+						} else if (it->word == L"endcase") {
+							case_pos.pop_front();
+							inserted_counts.pop_front();
 						}
-						stack.clear();
+						it++;
+					}
+				}
+			};
+
+			std::unordered_map<std::wstring, Event> events;
+			std::wstring ename;
+			bool failed = false;
+
+			error::ErrorContent *parser_abortion_error{};
+		public:
+			// 他のファイルと並行して行える段階(構文解析)までの解析結果
+			using SyntaxResult = SyntaxParser;
+
+			// 解析を行わずに、コマンド名と引数からコマンドを生成するクラス。
+			class CommandGenerator final {
+				SemanticParser semantic_parser{};
+			public:
+				// 登録されているコマンド名の組み合わせを表す値を返す。
+				uint64 KeywordHash() const noexcept {
+					return semantic_parser.KeywordHash();
+				}
+
+				CommandPtr Generate(const std::wstring& Command_Name, const std::vector<std::wstring>& Params) const {
+					return semantic_parser.Generate(Command_Name, Params);
+				}
+			};
+
+			// 字句解析し、その結果を返す。
+			static Context ParseLexical(std::wstring sentence) noexcept {
+				LexicalParser lexparser(std::move(sentence));
+				return lexparser.Result();
+			}
+
+			// 型を決定し、その結果を返す。
+			static Context DetermineType(Context context) noexcept {
+				TypeDeterminer type_determiner(context);
+				return type_determiner.Result();
+			}
+
+			// 字句解析と型決定を行い、その結果を返す。
+			static Context ParseBasic(std::wstring sentence) noexcept {
+				return DetermineType(ParseLexical(std::move(sentence)));
+			}
+
+			// 構文解析を行い、その結果を返す。
+			// イベントマネージャや変数に触れない為、複数のファイルを並行して解析できる。
+			// ただし、事前にSyntaxResult::MakeErrorsを呼んでおく必要がある。
+			static SyntaxParser ParseSyntax(std::wstring sentence) noexcept {
+				return SyntaxParser(ParseBasic(std::move(sentence)));
+			}
+
+			// ファイルから段階毎にイベントを生成し、各段階の処理をmeasureへ渡す。(計測用)
+			static size_t ParseInPhases(const std::wstring& Path, const PhaseMeasurer& Measure) noexcept {
+				Parser parser{};
+				std::wstring sentence{};
+				Context context{};
+				std::optional<SyntaxParser> syntax_parser{};
+				Syntax tree{};
+
+				Measure("decode", [&]() { DecodeTextFile(Path.c_str(), &sentence); });
+				Measure("lexical", [&]() { context = ParseLexical(std::move(sentence)); });
+				Measure("type", [&]() { context = DetermineType(std::move(context)); });
+				Measure("syntax", [&]() {
+					syntax_parser.emplace(context);
+					tree = std::move(syntax_parser->Result());
+				});
+				syntax_parser->SendError();
+				Measure("semantic", [&]() {
+					SemanticParser semantic_parser(tree);
+					parser.events = std::move(semantic_parser.Result());
+				});
+				Measure("optimize", [&]() {
+					for (auto& e : parser.events)
+						Optimizer(&e.second.commands);
+				});
+				Measure("compile", [&]() {
+					for (auto& e : parser.events)
+						Manager::CommandExecuter::Compile(&e.second);
+				});
+				return parser.events.size();
+			}
+
+#if defined(KARAPO_BENCHMARK)
+			// 原文を従来の解析器と新しい解析器で意味解析まで行い、生成したイベントの内、一致しないものの数を返す。
+			// 片方の結果にのみ存在するイベントも、一致しないものとして数える。
+			static size_t CompareWithLegacy(std::wstring sentence) noexcept {
+				const Context Basic = ParseBasic(std::move(sentence));
+				SyntaxParser syntax_parser(Basic);
+				SemanticParser semantic_parser(syntax_parser.Result());
+				LegacySyntaxParser legacy_syntax_parser(Basic);
+				LegacySemanticParser legacy_semantic_parser(&legacy_syntax_parser.Result());
+
+				// コマンド列は、各コマンドの名前・引数・親の位置が同じであれば一致とする。
+				auto same_commands = [](const Event::Commands& A, const Event::Commands& B) {
+					if (A.size() != B.size())
+						return false;
+					std::unordered_map<const CommandTree*, size_t> indices_a{}, indices_b{};
+					size_t index = 0;
+					for (auto a = A.begin(), b = B.begin(); a != A.end(); a++, b++, index++) {
+						indices_a[&(*a)] = index;
+						indices_b[&(*b)] = index;
+					}
+					for (auto a = A.begin(), b = B.begin(); a != A.end(); a++, b++) {
+						if (a->word != b->word || a->params != b->params || (a->parent == nullptr) != (b->parent == nullptr))
+							return false;
+						if (a->parent != nullptr && indices_a.at(a->parent) != indices_b.at(b->parent))
+							return false;
+					}
+					return true;
+				};
+				auto same_origin = [](const WorldVector& A, const WorldVector& B) {
+					if (A.size() != B.size())
+						return false;
+					for (size_t i = 0; i < A.size(); i++) {
+						if (A[i] != B[i])
+							return false;
+					}
+					return true;
+				};
+
+				const auto& Events = semantic_parser.Result();
+				const auto& Legacy_Events = legacy_semantic_parser.Result();
+				size_t mismatches = 0;
+				for (const auto& [Name, E] : Events) {
+					const auto Legacy = Legacy_Events.find(Name);
+					if (Legacy == Legacy_Events.end() ||
+						E.trigger_type != Legacy->second.trigger_type ||
+						E.param_names != Legacy->second.param_names ||
+						!same_origin(E.origin[0], Legacy->second.origin[0]) ||
+						!same_origin(E.origin[1], Legacy->second.origin[1]) ||
+						!same_commands(E.commands, Legacy->second.commands))
+					{
+						mismatches++;
+					}
+				}
+				for (const auto& Legacy : Legacy_Events) {
+					if (!Events.contains(Legacy.first))
+						mismatches++;
+				}
+				return mismatches;
+			}
+#endif
+
+			Parser() {
+				if (parser_abortion_error == nullptr)
+					parser_abortion_error = error::UserErrorHandler::MakeError(event::Manager::Instance().error_class, L"イベント解析を強制終了しました。", MB_OK | MB_ICONERROR, 1);
+				SyntaxParser::MakeErrors();
+			}
+
+			Parser(std::wstring sentence) noexcept : Parser(ParseSyntax(std::move(sentence))) {}
+
+			// 構文解析の結果から、意味解析以降を行う。
+			Parser(SyntaxParser syntax_parser) noexcept : Parser() {
+				syntax_parser.SendError();
+				auto tree = std::move(syntax_parser.Result());
+				SemanticParser semantic_parser(tree);
+				events = std::move(semantic_parser.Result());
+				// 構文解析と意味解析のどちらかでエラーが発生していれば、解析に失敗したものとする。
+				failed = syntax_parser.Failed() || semantic_parser.Failed();
+				for (auto& e : events) {
+					Optimizer(&e.second.commands);
+					Manager::CommandExecuter::Compile(&e.second);
+				}
+			}
+
+			[[nodiscard]] auto Result() noexcept {
+				return std::move(events);
+			}
+
+			// 解析中にエラーが発生したか否か。
+			bool Failed() const noexcept {
+				return failed;
+			}
+		};
+
+		// コンパイル済みイベントのキャッシュ
+		// 原文とコマンド名の組み合わせが前回と同じであれば、解析を省略してイベントを復元する。
+		class Cache final {
+			static constexpr uint32 Magic = 0x4356454B;	// "KEVC"
+			static constexpr uint32 Version = 3;
+
+			struct Header final {
+				uint32 magic;
+				uint32 version;
+				uint64 source_hash;		// 原文のハッシュ値
+				uint64 keyword_hash;	// コマンド名の組み合わせのハッシュ値
+				uint32 wchar_size;
+				uint32 event_count;
+				uint32 optimized;		// 最適化の設定(OptimizationModeの値)
+			};
+
+			class Writer final {
+				std::vector<char> buffer{};
+			public:
+				template<typename T>
+				void Write(const T& Value) {
+					static_assert(std::is_trivially_copyable_v<T>);
+					auto bytes = reinterpret_cast<const char*>(&Value);
+					buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+				}
+
+				void Write(const std::wstring& Text) {
+					Write(static_cast<uint32>(Text.size()));
+					auto bytes = reinterpret_cast<const char*>(Text.data());
+					buffer.insert(buffer.end(), bytes, bytes + Text.size() * sizeof(wchar_t));
+				}
+
+				const auto& Buffer() const noexcept {
+					return buffer;
+				}
+			};
+
+			// 割り当てられたメモリ上を読み進めるクラス。
+			// 範囲外を読もうとした場合はfalseを返す。
+			class Reader final {
+				const char *current, *end;
+			public:
+				Reader(const void* Data, const size_t Length) noexcept {
+					current = static_cast<const char*>(Data);
+					end = current + Length;
+				}
 
-						if (event::Manager::Instance().error_handler.ShowLocalError(4)) {
-							break;
-						}
+				template<typename T>
+				[[nodiscard]] bool Read(T* value) noexcept {
+					static_assert(std::is_trivially_copyable_v<T>);
+					if (static_cast<size_t>(end - current) < sizeof(T))
+						return false;
+					memcpy(value, current, sizeof(T));
+					current += sizeof(T);
+					return true;
+				}
 
-						if (!event_name.empty() && found_command_sentence) {
-							parsing_events[event_name].trigger_type = trigger_type;
-							parsing_events[event_name].param_names = std::move(params);
-							for (int i = 0; i < 2; i++)
-								parsing_events[event_name].origin[i] = origin[i];
+				[[nodiscard]] bool Read(std::wstring* text) {
+					uint32 length{};
+					if (!Read(&length) || static_cast<size_t>(end - current) / sizeof(wchar_t) < length)
+						return false;
+					text->resize(length);
+					memcpy(text->data(), current, length * sizeof(wchar_t));
+					current += length * sizeof(wchar_t);
+					return true;
+				}
 
-							parsing_events[event_name].commands = std::move(commands);
-							trigger_type = TriggerType::Invalid;
-							commands.clear();
-							params.clear();
-							event_name.clear();
-							parent = nullptr;
-							found_command_sentence = false;
+				// 残りのバイト数で、少なくともMin_Sizeバイトを占める要素をCount個読めるか否か。
+				// 壊れたキャッシュの個数で、大きな領域を確保しないよう確認する。
+				bool CanHold(const uint32 Count, const size_t Min_Size) const noexcept {
+					return static_cast<size_t>(end - current) / Min_Size >= Count;
+				}
+			};
+
+			// 最適化の結果を左右する設定(最適化の有無・予算の有無)を表す値
+			static uint32 OptimizationMode() noexcept {
+				const auto& Event_Manager = Manager::Instance();
+				return static_cast<uint32>(Event_Manager.optimization_enabled) | (static_cast<uint32>(Event_Manager.IsBudgeted()) << 1);
+			}
+
+			static std::wstring PathOf(const std::wstring& Source_Path) {
+				return Source_Path + L".cache";
+			}
+
+			static bool IsFresh(const Header& H, const uint64 Source_Hash, const uint64 Keyword_Hash) noexcept {
+				return H.magic == Magic && H.version == Version && H.wchar_size == sizeof(wchar_t) &&
+					H.source_hash == Source_Hash && H.keyword_hash == Keyword_Hash &&
+					H.optimized == OptimizationMode();
+			}
+
+			static bool Read(Reader* reader, const Parser::CommandGenerator& Generator, std::unordered_map<std::wstring, Event>* events) {
+				Header header{};
+				if (!reader->Read(&header) ||
+					header.magic != Magic ||
+					header.version != Version ||
+					header.wchar_size != sizeof(wchar_t))
+				{
+					return false;
+				}
+
+				for (uint32 i = 0; i < header.event_count; i++) {
+					std::wstring event_name{};
+					uint32 trigger_type{}, param_count{}, command_count{};
+					Dec origin[4]{};
+					if (!reader->Read(&event_name) || !reader->Read(&trigger_type) || !reader->Read(&origin))
+						return false;
+
+					if (trigger_type >= Trigger_Type_Count)
+						return false;
+
+					Event event{};
+					event.trigger_type = static_cast<TriggerType>(trigger_type);
+					event.origin[0] = WorldVector{ origin[0], origin[1] };
+					event.origin[1] = WorldVector{ origin[2], origin[3] };
+
+					// 文字列は少なくとも長さ(uint32)を持つ。
+					if (!reader->Read(&param_count) || !reader->CanHold(param_count, sizeof(uint32)))
+						return false;
+					event.param_names.resize(param_count);
+					for (auto& param_name : event.param_names) {
+						if (!reader->Read(&param_name))
+							return false;
+					}
+
+					// コマンドは少なくとも、コマンド名の長さ・引数の数・親の位置を持つ。
+					if (!reader->Read(&command_count) || !reader->CanHold(command_count, sizeof(uint32) * 2 + sizeof(int32)))
+						return false;
+					std::vector<CommandTree*> trees{};
+					std::vector<int32> parents{};
+					trees.reserve(command_count);
+					parents.reserve(command_count);
+					for (uint32 j = 0; j < command_count; j++) {
+						CommandTree tree{};
+						int32 parent{};
+						if (!reader->Read(&tree.word) || !reader->Read(&param_count) || !reader->CanHold(param_count, sizeof(uint32)))
+							return false;
+						tree.params.resize(param_count);
+						for (auto& param : tree.params) {
+							if (!reader->Read(&param))
+								return false;
 						}
+						if (!reader->Read(&parent))
+							return false;
+
+						tree.command = Generator.Generate(tree.word, tree.params);
+						event.commands.push_back(std::move(tree));
+						trees.push_back(&event.commands.back());
+						parents.push_back(parent);
+					}
+
+					// 親の付け直し
+					for (size_t j = 0; j < trees.size(); j++) {
+						if (parents[j] >= static_cast<int32>(trees.size()))
+							return false;
+						trees[j]->parent = (parents[j] < 0 ? nullptr : trees[parents[j]]);
 					}
+					Manager::CommandExecuter::Compile(&event);
+					(*events)[event_name] = std::move(event);
+				}
+				return true;
+			}
+		public:
+			// 最新のキャッシュが存在するか否か。
+			// ヘッダのみを読む為、解析と並行して呼び出せる。
+			static bool Exists(const std::wstring& Source_Path, const uint64 Source_Hash, const uint64 Keyword_Hash) noexcept {
+				size_t length = 0;
+				const void* mapped = MapFile(PathOf(Source_Path).c_str(), &length);
+				if (mapped == nullptr)
+					return false;
+
+				Header header{};
+				Reader reader(mapped, length);
+				const bool Fresh = reader.Read(&header) && IsFresh(header, Source_Hash, Keyword_Hash);
+				UnmapFile(mapped);
+				return Fresh;
+			}
 
+			// キャッシュからイベントを復元する。
+			// キャッシュが存在しない、または古い場合はfalseを返す。
+			static bool Load(const std::wstring& Source_Path, const uint64 Source_Hash, const Parser::CommandGenerator& Generator, std::unordered_map<std::wstring, Event>* events) {
+				size_t length = 0;
+				const void* mapped = MapFile(PathOf(Source_Path).c_str(), &length);
+				if (mapped == nullptr)
+					return false;
 
+				bool loaded = false;
+				Header header{};
+				Reader reader(mapped, length);
+				if (reader.Read(&header) && IsFresh(header, Source_Hash, Generator.KeywordHash())) {
+					Reader event_reader(mapped, length);
+					// 個数は読む前に確認しているが、それでも確保できなければ解析し直させる。
+					try {
+						loaded = Read(&event_reader, Generator, events);
+					} catch (std::bad_alloc&) {
+						loaded = false;
+					}
 				}
+				UnmapFile(mapped);
 
-				auto& Result() {
-					return parsing_events;
+				if (!loaded)
+					events->clear();
+				return loaded;
+			}
+
+			// イベントをキャッシュとして書き出す。
+			static void Save(const std::wstring& Source_Path, const uint64 Source_Hash, const uint64 Keyword_Hash, const std::unordered_map<std::wstring, Event>& Events) {
+				Writer writer{};
+				writer.Write(Header{
+					.magic = Magic,
+					.version = Version,
+					.source_hash = Source_Hash,
+					.keyword_hash = Keyword_Hash,
+					.wchar_size = sizeof(wchar_t),
+					.event_count = static_cast<uint32>(Events.size()),
+					.optimized = OptimizationMode()
+				});
+
+				for (const auto& [Event_Name, Event] : Events) {
+					Dec origin[4]{ -1, -1, -1, -1 };
+					for (int i = 0; i < 2; i++) {
+						if (Event.origin[i].size() >= 2) {
+							origin[i * 2] = Event.origin[i][0];
+							origin[i * 2 + 1] = Event.origin[i][1];
+						}
+					}
+					writer.Write(Event_Name);
+					writer.Write(static_cast<uint32>(Event.trigger_type));
+					writer.Write(origin);
+					writer.Write(static_cast<uint32>(Event.param_names.size()));
+					for (const auto& Param_Name : Event.param_names)
+						writer.Write(Param_Name);
+
+					std::unordered_map<const CommandTree*, int32> indices{};
+					int32 index = 0;
+					for (const auto& Tree : Event.commands)
+						indices[&Tree] = index++;
+
+					writer.Write(static_cast<uint32>(Event.commands.size()));
+					for (const auto& Tree : Event.commands) {
+						writer.Write(Tree.word);
+						writer.Write(static_cast<uint32>(Tree.params.size()));
+						for (const auto& Param : Tree.params)
+							writer.Write(Param);
+						writer.Write(Tree.parent != nullptr ? indices.at(Tree.parent) : int32{ -1 });
+					}
 				}
+				WriteBinaryFile(PathOf(Source_Path).c_str(), writer.Buffer().data(), writer.Buffer().size());
+			}
+		};
+
+		static EventGenerator& Instance() noexcept {
+			static EventGenerator evg;
+			return evg;
+		}
+
+		// 読み込んだファイルの状態(変更の監視に用いる)
+		struct Source final {
+			int64 last_write_time{};
+			std::unordered_map<std::wstring, uint64> event_hashes{};	// イベント名と、解析した原文のハッシュ値
+		};
+
+		void Generate(const std::wstring& Path, const bool Record_Sources = false) noexcept {
+			Generate(std::vector<std::wstring>{ Path }, Record_Sources);
+		}
+
+		// 複数のファイルからイベントを生成する。
+		// 原文の読込から構文解析までは並行して行い、意味解析以降はPathsの順に行う。
+		// 同名のイベントは、後に指定されたファイルのものが優先される。
+		// Record_Sourcesを指定した場合は、解析した原文からファイル毎の状態を記録する。(キャッシュから復元する場合も変換する)
+		void Generate(const std::vector<std::wstring>& Paths, const bool Record_Sources = false) noexcept {
+			// ファイル毎の並行処理の結果
+			struct Job final {
+				uint64 source_hash{};
+				bool cached = false;
+				std::optional<Parser::SyntaxResult> syntax{};
+				Source source{};
 			};
 
-			// œK@\
-			class Optimizer final {
-			public:
-				Optimizer() = default;
+			std::vector<Job> jobs(Paths.size());
+			// コマンド名の登録とエラーの作成は、並行処理の前に済ませる。
+			const uint64 Keyword_Hash = Parser::CommandGenerator().KeywordHash();
+			Parser::SyntaxResult::MakeErrors();
 
-				// o̍œKB
-				Optimizer(std::list<CommandTree> *commands) noexcept {
-					// K؂ȓ̌`
-					SortOfElse(commands);
+			auto record = [](Job* job, const std::wstring& Sentence) {
+				job->source.event_hashes.clear();
+				for (const auto& [Name, Text] : SplitEvents(Sentence))
+					job->source.event_hashes[Name] = Hash(Text);
+			};
+
+			auto prepare = [&](const size_t Index) {
+				auto& job = jobs[Index];
+				// 更新時刻は読込前に取る。読込中に書き換えられた場合は、次回の確認で読み直される。
+				if (Record_Sources)
+					job.source.last_write_time = LastWriteTime(Paths[Index]);
+				// ハッシュ値の計算と文字列の変換は、同じマッピングから行う。
+				size_t source_length = 0;
+				const void* source = MapFile(Paths[Index].c_str(), &source_length);
+				job.source_hash = Hash(source, source_length);
+				job.cached = Cache::Exists(Paths[Index], job.source_hash, Keyword_Hash);
+				if (!job.cached || Record_Sources) {
+					std::wstring sentence;
+					DecodeText(source, source_length, &sentence);
+					if (Record_Sources)
+						record(&job, sentence);
+					if (!job.cached)
+						job.syntax.emplace(Parser::ParseSyntax(std::move(sentence)));
 				}
+				UnmapFile(source);
+			};
 
-				// of/elseR}hstd::listcase̒ɕגB
-				void SortOfElse(std::list<CommandTree> *commands) noexcept {
-					auto it = commands->begin();
-					std::list<decltype(it)> case_pos{};
-					// ecaseɑ΂āAofR}h}Ȃ񐔂ۑ郊XgB
-					std::list<int> inserted_counts{};
-					while (it != commands->end()) {
-						if (it->word == L"case") {
-							case_pos.push_front(it);
-							case_pos.front()->parent = nullptr;
-							inserted_counts.push_front(0);
-						} else if (it->word == L"of" || it->word == L"else") {
-							// ȅC
-							{
-								// d
-								std::list<CommandTree*> ignore_case{};
-								CommandTree *of_parent{};
-								auto parent = &(*it);
-								while (parent->parent != nullptr) {
-									if (parent->parent->word == L"case") {
-										ignore_case.push_back(parent->parent);
-									} else if ((parent->parent->word == L"of" || parent->parent->word == L"else") && of_parent == nullptr && ignore_case.empty()) {
-										// ̃R}hofR}h܂elseR}h:
-										// IȂ̂ŕύXΏۂɐݒB
-										of_parent = parent;
-									} else if (parent->parent->word == L"endcase" && of_parent != nullptr) {
-										if (ignore_case.empty()) {
-											// ύXΏۂendcaseR}hɌqB
-											of_parent->parent = parent->parent;
-											break;
-										} else {
-											ignore_case.pop_back();
-										}
-									}
-									parent = parent->parent;
-								}
-							}
-							inserted_counts.front()++;
-							// ofR}ḧʒucase̒ɐݒB
-							commands->insert(std::next(case_pos.front(), inserted_counts.front()), std::move(*it));
-							it = commands->erase(it);
-							continue;
-						} else if (it->word == L"endcase") {
-							case_pos.pop_front();
-							inserted_counts.pop_front();
-						}
-						it++;
+			std::atomic<size_t> next = 0;
+			auto work = [&]() {
+				for (size_t i = next++; i < jobs.size(); i = next++)
+					prepare(i);
+			};
+			const size_t Worker_Count = std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1u), jobs.size());
+			std::vector<std::thread> workers{};
+			for (size_t i = 1; i < Worker_Count; i++)
+				workers.emplace_back(work);
+			work();
+			for (auto& worker : workers)
+				worker.join();
+
+			events.clear();
+			for (size_t i = 0; i < jobs.size(); i++) {
+				auto& job = jobs[i];
+				std::unordered_map<std::wstring, Event> generated{};
+				if (job.cached) {
+					Parser::CommandGenerator generator{};
+					if (!Cache::Load(Paths[i], job.source_hash, generator, &generated)) {
+						// ヘッダの確認後にキャッシュが壊れていた場合は、解析し直す。
+						std::wstring sentence;
+						DecodeTextFile(Paths[i].c_str(), &sentence);
+						if (Record_Sources)
+							record(&job, sentence);
+						job.syntax.emplace(Parser::ParseSyntax(std::move(sentence)));
+						job.cached = false;
 					}
 				}
-			};
 
-			std::unordered_map<std::wstring, Event> events;
-			std::wstring ename;
+				if (!job.cached) {
+					Parser parser(std::move(*job.syntax));
+					generated = std::move(parser.Result());
+					// エラーが発生した場合は、次回もエラーを出せる様にキャッシュを作らない。
+					if (!parser.Failed())
+						Cache::Save(Paths[i], job.source_hash, Keyword_Hash, generated);
+				}
+
+				for (auto& e : generated)
+					events[e.first] = std::move(e.second);
+			}
+
+			sources.clear();
+			if (Record_Sources) {
+				for (auto& job : jobs)
+					sources.push_back(std::move(job.source));
+			}
+		}
+
+		// ファイルを介さずに、原文からイベントを生成する。
+		void Parse(std::wstring sentence) noexcept {
+			Parser parser(std::move(sentence));
+			events = std::move(parser.Result());
+		}
+
+		[[nodiscard]] auto Result() noexcept {
+			return std::move(events);
+		}
+
+		// 最後のGenerateで記録した、Pathsの順のファイルの状態を返す。
+		[[nodiscard]] auto Sources() noexcept {
+			return std::move(sources);
+		}
+	private:
+		std::unordered_map<std::wstring, Event> events;
+		std::vector<Source> sources;
+	};
+
+	size_t ParseInPhases(const std::wstring& Path, const PhaseMeasurer& Measure) noexcept {
+		return EventGenerator::Parser::ParseInPhases(Path, Measure);
+	}
+
+#if defined(KARAPO_BENCHMARK)
+	size_t CompareWithLegacyParser(std::wstring sentence) noexcept {
+		return EventGenerator::Parser::CompareWithLegacy(std::move(sentence));
+	}
+#endif
+
+	// 
+	void Manager::ConditionManager::SetTarget(Value& tv) {
+		target_value = tv;
+		// 文字列は、定数との比較でハッシュ値を先に比べる為に求めておく。
+		target_hash = (target_value.Is<std::wstring>() ? std::hash<std::wstring>{}(target_value.Get<std::wstring>()) : 0);
+	}
+
+	// 条件式を評価する
+	bool Manager::ConditionManager::Evalute(const Predicate Condition, const Value& Right_Value, const size_t Right_Hash) noexcept {
+		can_execute = Condition(target_value, target_hash, Right_Value, Right_Hash);
+		return can_execute;
+	}
+
+	void Manager::ConditionManager::FreeCase() {
+		target_value = nullptr;
+	}
+
+	void Profiler::Enable(const bool Enable) noexcept {
+		enabled = Enable;
+	}
+
+	void Profiler::Reset() noexcept {
+		// 計測中の範囲が経路を参照している為、経路は消さずに時間のみを0へ戻す。
+		for (auto* entries : { &events, &commands }) {
+			for (auto& [Name, entry] : *entries) {
+				entry.calls = 0;
+				entry.inclusive_ns = entry.exclusive_ns = 0;
+			}
+		}
+		for (auto& node : nodes)
+			node.self_ns = 0;
+	}
+
+	Profiler::Entry* Profiler::EventEntry(const std::wstring& Name) {
+		auto [it, inserted] = events.try_emplace(Name);
+		if (inserted)
+			it->second.name = Name;
+		return &it->second;
+	}
+
+	Profiler::Entry* Profiler::CommandEntry(const std::wstring& Name) {
+		auto [it, inserted] = commands.try_emplace(Name);
+		if (inserted) {
+			it->second.name = Name;
+			it->second.is_command = true;
+		}
+		return &it->second;
+	}
+
+	namespace {
+		int64 SteadyNanoseconds() noexcept {
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		}
+	}
+
+	void Profiler::Begin(Entry* entry, const bool Count) {
+		const uint32 Parent = (scopes.empty() ? 0 : scopes.back().node);
+		const uint32 New_Node = static_cast<uint32>(nodes.size());
+		const uint32 Node = nodes[Parent].children.try_emplace(entry, New_Node).first->second;
+		if (Node == New_Node)
+			nodes.push_back(StackNode{ .entry = entry, .parent = Parent });
+
+		entry->active++;
+		if (Count)
+			entry->calls++;
+		// 計測の準備に掛かった時間を含めないよう、時刻は最後に取る。
+		scopes.push_back(Scope{ .entry = entry, .node = Node, .begin = SteadyNanoseconds() });
+	}
+
+	void Profiler::End() noexcept {
+		const int64 Now = SteadyNanoseconds();
+		const Scope Ended = scopes.back();
+		scopes.pop_back();
+
+		const int64 Elapsed = Now - Ended.begin;
+		auto *const entry = Ended.entry;
+		if (--entry->active == 0)
+			entry->inclusive_ns += Elapsed;
+		entry->exclusive_ns += Elapsed - Ended.nested_events_ns;
+		nodes[Ended.node].self_ns += Elapsed - Ended.nested_ns;
+
+		// コマンドの時間は呼出元のイベントの時間に含め、イベントの時間は呼出元から除く。
+		if (!scopes.empty()) {
+			auto& parent = scopes.back();
+			parent.nested_events_ns += (entry->is_command ? Ended.nested_events_ns : Elapsed);
+			parent.nested_ns += Elapsed;
+		}
+	}
+
+	void Profiler::Measure(Entry* entry, Command* command) {
+		Begin(entry);
+		command->Execute();
+		End();
+	}
+
+	namespace {
+		// UTF-8へ変換してファイルへ書き出す。
+		bool WriteUTF8File(const std::wstring& Path, const std::wstring& Text, const bool With_BOM) {
+			std::string bytes = (With_BOM ? "\xEF\xBB\xBF" : "");
+			const int Length = WideCharToMultiByte(CP_UTF8, 0, Text.data(), static_cast<int>(Text.size()), nullptr, 0, nullptr, nullptr);
+			const size_t Offset = bytes.size();
+			bytes.resize(Offset + static_cast<size_t>(std::max(Length, 0)));
+			if (Length > 0)
+				WideCharToMultiByte(CP_UTF8, 0, Text.data(), static_cast<int>(Text.size()), bytes.data() + Offset, Length, nullptr, nullptr);
+			return WriteBinaryFile(Path.c_str(), bytes.data(), bytes.size());
+		}
+
+		// CSVの1項目として出力できるよう、必要であれば引用符で囲む。
+		std::wstring QuoteCSV(const std::wstring& Text) {
+			if (Text.find_first_of(L",\"\n") == Text.npos)
+				return Text;
+			std::wstring quoted = L"\"";
+			for (const auto C : Text) {
+				if (C == L'"')
+					quoted += L'"';
+				quoted += C;
+			}
+			return quoted + L'"';
+		}
+	}
+
+	bool Profiler::Dump(const std::wstring& Base_Path) const {
+		auto name_of = [](const Entry& E) -> std::wstring {
+			if (!E.is_command)
+				return E.name;
+			const auto English = keyword::Builtin_Table.EnglishName(E.name);
+			return std::wstring(English.empty() ? std::wstring_view(E.name) : English);
+		};
+
+		// 名前順に並べ、版の異なるスクリプトの結果を比べやすくする。
+		std::map<std::wstring, Entry> merged_events{}, merged_commands{};
+		for (const auto& [Name, E] : events) {
+			if (E.calls > 0)
+				merged_events[Name] = E;
+		}
+		for (const auto& [Name, E] : commands) {
+			if (E.calls == 0)
+				continue;
+			auto& merged = merged_commands[name_of(E)];
+			merged.calls += E.calls;
+			merged.inclusive_ns += E.inclusive_ns;
+			merged.exclusive_ns += E.exclusive_ns;
+		}
+
+		std::wstring csv = L"kind,name,calls,inclusive_ns,exclusive_ns,exclusive_ns_per_call\n";
+		auto write_rows = [&csv](const wchar_t* Kind, const std::map<std::wstring, Entry>& Entries) {
+			for (const auto& [Name, E] : Entries) {
+				csv += std::wstring(Kind) + L',' + QuoteCSV(Name) + L',' + std::to_wstring(E.calls) + L',' +
+					std::to_wstring(E.inclusive_ns) + L',' + std::to_wstring(E.exclusive_ns) + L',' +
+					std::to_wstring(E.exclusive_ns / static_cast<int64>(E.calls)) + L'\n';
+			}
+		};
+		write_rows(L"event", merged_events);
+		write_rows(L"command", merged_commands);
+
+		// 折り畳んだスタック形式: 経路を;で繋ぎ、空白の後にその経路のみで掛かった時間(ナノ秒)を書く。
+		// コマンドは<>で囲み、イベントと区別する。
+		std::map<std::wstring, int64> stacks{};
+		for (size_t i = 1; i < nodes.size(); i++) {
+			if (nodes[i].self_ns <= 0)
+				continue;
+			std::vector<std::wstring> path{};
+			for (uint32 n = static_cast<uint32>(i); n != 0; n = nodes[n].parent) {
+				const auto& E = *nodes[n].entry;
+				auto frame = (E.is_command ? L'<' + name_of(E) + L'>' : name_of(E));
+				std::replace(frame.begin(), frame.end(), L';', L',');
+				path.push_back(std::move(frame));
+			}
+			std::wstring joined{};
+			for (auto it = path.rbegin(); it != path.rend(); it++)
+				joined += (joined.empty() ? L"" : L";") + *it;
+			stacks[joined] += nodes[i].self_ns;
+		}
+		std::wstring folded{};
+		for (const auto& [Path, Time] : stacks)
+			folded += Path + L' ' + std::to_wstring(Time) + L'\n';
+
+		return WriteUTF8File(Base_Path + L".csv", csv, true) && WriteUTF8File(Base_Path + L".folded", folded, false);
+	}
+
+	Manager::Manager() {
+		error_class = error_handler.MakeErrorClass(L"イベントエラー");
+		call_error = error_handler.MakeError(error_class, L"指定されたイベントが見つかりません。", MB_OK | MB_ICONERROR, 2);
+		parallel_mismatch_error = error_handler.MakeError(error_class, L"並行して実行した結果が、逐次実行した結果と異なります。", MB_OK | MB_ICONWARNING, 2);
+		watch_interval = GetPrivateProfileIntW(L"event", L"watch", 0, L"./config.ini");
+		optimization_enabled = (GetPrivateProfileIntW(L"event", L"optimize", 1, L"./config.ini") != 0);
+		range_grid.SetCellSize(static_cast<Dec>(GetPrivateProfileIntW(L"event", L"trigger_cell", 64, L"./config.ini")));
+		profiler.Enable(GetPrivateProfileIntW(L"event", L"profile", 0, L"./config.ini") != 0);
+		budget.instructions = static_cast<uint64>(std::max(0, static_cast<int>(GetPrivateProfileIntW(L"event", L"budget_instructions", 0, L"./config.ini"))));
+		budget.microseconds = std::max(0, static_cast<int>(GetPrivateProfileIntW(L"event", L"budget_us", 0, L"./config.ini")));
+		parallel.threads = static_cast<uint32>(std::max(0, static_cast<int>(GetPrivateProfileIntW(L"event", L"parallel", 0, L"./config.ini"))));
+		parallel.verify = (GetPrivateProfileIntW(L"event", L"parallel_verify", 0, L"./config.ini") != 0);
+	}
+
+	void Manager::Watch(const std::vector<std::wstring>& Paths) noexcept {
+		if (watch_interval <= 0)
+			return;
+
+		// ファイルを読み直さず、GenerateEventが解析した原文から求めた値を使う。
+		auto sources = EventGenerator::Instance().Sources();
+		for (size_t i = 0; i < Paths.size() && i < sources.size(); i++) {
+			auto it = watched_files.try_emplace(Paths[i]).first;
+			auto& file = it->second;
+			file.last_write_time = sources[i].last_write_time;
+			file.hashes = std::move(sources[i].event_hashes);
+			// 同名のイベントは後のファイルのものが残る為、後に記録したファイルを所有者とする。
+			for (const auto& Hash_Entry : file.hashes) {
+				if (auto event = events.find(Hash_Entry.first); event != events.end())
+					event->second.source_file = &it->first;
+			}
+		}
+	}
+
+	void Manager::ReloadChangedEvents() noexcept {
+		if (watch_interval <= 0)
+			return;
+
+		const int64 Now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		if (Now - last_watched < watch_interval)
+			return;
+		last_watched = Now;
+
+		std::vector<std::wstring> replaced{};
+		for (auto& [Path, file] : watched_files) {
+			const int64 Write_Time = LastWriteTime(Path);
+			if (Write_Time == file.last_write_time)
+				continue;
+			file.last_write_time = Write_Time;
+
+			std::wstring source{};
+			DecodeTextFile(Path.c_str(), &source);
+			std::unordered_map<std::wstring, uint64> hashes{};
+			for (const auto& [Name, Text] : SplitEvents(source)) {
+				const uint64 Text_Hash = Hash(Text);
+				hashes[Name] = Text_Hash;
+				if (auto old = file.hashes.find(Name); old != file.hashes.end() && old->second == Text_Hash)
+					continue;
+
+				// 変更されたイベントのみを解析し、差し替える。
+				EventGenerator::Instance().Parse(std::wstring(Text));
+				for (auto& e : EventGenerator::Instance().Result()) {
+					SetEvent(e.first, std::move(e.second));
+					events.at(e.first).source_file = &Path;
+					replaced.push_back(e.first);
+				}
+			}
+
+			// 原文から消えたイベントを削除する。
+			// 他のファイルやエディタで定義し直されたものは、このファイルの物ではない為残す。
+			for (const auto& Old : file.hashes) {
+				if (hashes.contains(Old.first))
+					continue;
+				if (auto event = events.find(Old.first); event != events.end() && event->second.source_file == &Path)
+					EraseEvent(Old.first);
+			}
+			file.hashes = std::move(hashes);
+		}
+
+		// 差し替えたイベントの内、発生タイプがLoadのもののみを実行する。
+		OnLoad(replaced);
+	}
+
+	std::unordered_map<std::wstring, Event> Manager::GenerateEvent(const std::wstring& Path) noexcept {
+		EventGenerator::Instance().Generate(Path, watch_interval > 0);
+		return EventGenerator::Instance().Result();
+	}
+
+	std::unordered_map<std::wstring, Event> Manager::GenerateEvent(const std::vector<std::wstring>& Paths) noexcept {
+		EventGenerator::Instance().Generate(Paths, watch_interval > 0);
+		return EventGenerator::Instance().Result();
+	}
+
+	void Manager::LoadEvent(const std::wstring path) noexcept {
+		// 全てのイベントが置き換わる為、中断中のイベントは再開しない。
+		continuations.clear();
+		frame_waits.clear();
+		time_waits.clear();
+		condition_waits.clear();
+		events = std::move(GenerateEvent(path));
+		RelinkAll();
+		watched_files.clear();
+		Watch({ path });
+		OnLoad();
+	}
+
+	void Manager::RequestEvent(const std::wstring& Path) noexcept {
+		requesting_path = Path;
+	}
+
+	void Manager::ImportEvent(const std::wstring& Path) noexcept {
+		auto additional = std::move(GenerateEvent(Path));
+		for (auto& e : additional) {
+			SetEvent(e.first, std::move(e.second));
+		}
+		Watch({ Path });
+		OnLoad();
+	}
+
+	void Manager::ImportEvent(const std::vector<std::wstring>& Paths) noexcept {
+		auto additional = std::move(GenerateEvent(Paths));
+		for (auto& e : additional) {
+			SetEvent(e.first, std::move(e.second));
+		}
+		Watch(Paths);
+		OnLoad();
+	}
+
+	void Manager::OnLoad() noexcept {
+		// 実行前に発生無しへ移す為、一覧の先頭は常に未実行のイベントとなる。
+		auto& loads = trigger_lists[static_cast<size_t>(TriggerType::Load)];
+		while (loads.front != nullptr) {
+			auto event = loads.front;
+			ChangeTriggerType(event, TriggerType::None);
+			Call(HandleOf(event));
+		}
+	}
+
+	void Manager::OnLoad(const std::vector<std::wstring>& Event_Names) noexcept {
+		for (const auto& Name : Event_Names) {
+			// 実行したイベントが一覧を変えても辿れるよう、その都度名前から探す。
+			auto it = events.find(Name);
+			if (it == events.end() || it->second.trigger_type != TriggerType::Load)
+				continue;
+			ChangeTriggerType(&it->second, TriggerType::None);
+			Call(HandleOf(&it->second));
+		}
+	}
+
+	void Manager::Update() noexcept {
+		frame_count++;
+		// 前のフレームで使った予算を記録し、新しいフレームの予算を用意する。
+		budget_stats.last_instructions = used_instructions;
+		budget_stats.last_microseconds = used_microseconds;
+		used_instructions = 0;
+		used_microseconds = 0;
+		exhausted = false;
+		ResumeSuspended();
+
+		// 実行中にイベントが追加・変更されても辿れるよう、実行前に一覧を写しておく。
+		// 中断中のイベントは、再開して実行を終えるまで自動実行しない。
+		auto_events.clear();
+		for (auto e = trigger_lists[static_cast<size_t>(TriggerType::Auto)].front; e != nullptr; e = e->trigger_link.next) {
+			if (e->suspended == 0)
+				auto_events.push_back(e);
+		}
+
+		// 予算を使い切った場合は、残りを次のフレームへ延ばし、延ばしたイベントから実行する。
+		// 予算が無制限であれば、並行して実行できるイベントは作業スレッドで実行する。
+		std::queue<std::wstring> dead;
+		current_priority = Priority::Low;
+		if (parallel.threads > 1 && !IsBudgeted() && !profiler.IsEnabled()) {
+			ExecuteAutoInParallel();
+			for (auto event : auto_events) {
+				if (event->commands.empty())
+					dead.push(*event->trigger_link.name);
+			}
+		} else {
+			const size_t Auto_Count = auto_events.size();
+			const size_t First = (Auto_Count > 0 ? auto_cursor % Auto_Count : 0);
+			auto_cursor = 0;
+			for (size_t i = 0; i < Auto_Count; i++) {
+				auto event = auto_events[(First + i) % Auto_Count];
+				if (exhausted) {
+					budget_stats.deferred_events += Auto_Count - i;
+					auto_cursor = (First + i) % Auto_Count;
+					break;
+				}
+				Call(HandleOf(event));
+				if (event->commands.empty()) {
+					dead.push(*event->trigger_link.name);
+				}
+			}
+		}
+		FireTriggers();
+		current_priority = Priority::High;
+
+		error_handler.ShowLocalError(4);
+
+		while (!dead.empty()) {
+			EraseEvent(dead.front());
+			dead.pop();
+		}
+
+		if (!requesting_path.empty()) {
+			LoadEvent(requesting_path);
+			requesting_path.clear();
+		}
 
-			error::ErrorContent *parser_abortion_error{};
-		public:
-			// ͂ǍʂԂB
-			Context ParseLexical(const std::wstring& Sentence) const noexcept {
-				LexicalParser lexparser(Sentence);
-				return lexparser.Result();
+		// フレームの合間に、変更されたイベントを差し替える。
+		ReloadChangedEvents();
+	}
+
+	void Manager::ExecuteEvent(const WorldVector origin) noexcept {
+		std::vector<Event*> found{};
+		range_grid.BeginQuery();
+		range_grid.Query(origin, origin, &found);
+		if (!found.empty() && found.front()->suspended == 0)
+			Call(HandleOf(found.front()));
+	}
+
+	void Manager::FireTriggers() noexcept {
+		if (trigger_lists[static_cast<size_t>(TriggerType::Trigger)].front == nullptr)
+			return;
+
+		// 複数のEntityに触れられていても、一度だけ実行する。
+		touched_events.clear();
+		range_grid.BeginQuery();
+		Program::Instance().entity_manager.ForEach([this](const std::shared_ptr<Entity>& Target) {
+			const WorldVector Origin = Target->Origin();
+			range_grid.Query(Origin, Origin + Target->Length(), &touched_events);
+		});
+
+		for (auto event : touched_events) {
+			if (event->trigger_type != TriggerType::Trigger || event->suspended != 0)
+				continue;
+			if (exhausted) {
+				budget_stats.deferred_events++;
+				continue;
 			}
+			Call(HandleOf(event));
+		}
+	}
 
-			// ^肵ǍʂԂB
-			Context DetermineType(Context context) const noexcept {
-				TypeDeterminer type_determiner(context);
-				return type_determiner.Result();
+	namespace {
+		// 自動実行イベントを並行して実行する作業スレッド
+		// 呼び出したスレッドも作業に加わり、全てのスレッドが作業を終えるまで待つ。
+		class WorkerPool final {
+			std::vector<std::thread> threads{};
+			std::mutex mutex{};
+			std::condition_variable wake{}, finished{};
+			const std::function<void()>* job{};
+			uint64 round = 0;		// 作業を頼んだ回数
+			size_t working = 0;		// 作業中の作業スレッドの数
+			bool stopping = false;
+
+			void Work(uint64 done_round) {
+				while (true) {
+					const std::function<void()>* current{};
+					{
+						std::unique_lock lock(mutex);
+						wake.wait(lock, [this, done_round] { return stopping || round != done_round; });
+						if (stopping)
+							return;
+						done_round = round;
+						current = job;
+					}
+					(*current)();
+					std::lock_guard lock(mutex);
+					if (--working == 0)
+						finished.notify_one();
+				}
 			}
 
-			// ͂ƌ^sǍʂԂB
-			Context ParseBasic(const std::wstring& Sentence) const noexcept {
-				return DetermineType(ParseLexical(Sentence));
+			void Stop() noexcept {
+				{
+					std::lock_guard lock(mutex);
+					stopping = true;
+				}
+				wake.notify_all();
+				for (auto& thread : threads)
+					thread.join();
+				threads.clear();
+				stopping = false;
+			}
+		public:
+			~WorkerPool() noexcept {
+				Stop();
 			}
 
-			Parser() {
-				if (parser_abortion_error == nullptr)
-					parser_abortion_error = error::UserErrorHandler::MakeError(event::Manager::Instance().error_class, L"Cxg͂I܂B", MB_OK | MB_ICONERROR, 1);
+			// 作業スレッドの数(呼び出したスレッドを除く)を変える。
+			void Resize(const size_t Count) {
+				if (Count == threads.size())
+					return;
+				Stop();
+				std::lock_guard lock(mutex);
+				for (size_t i = 0; i < Count; i++)
+					threads.emplace_back(&WorkerPool::Work, this, round);
 			}
 
-			Parser(const std::wstring& Sentence) noexcept : Parser() {
-				auto context = ParseBasic(Sentence);
-				bool aborted = false;
-				auto tree = std::move(SyntaxParser(&context).Result());
-				events = std::move(SemanticParser(&tree).Result());
-				for (auto& e : events) {
-					Optimizer(&e.second.commands);
+			// 全てのスレッドでJobを実行し、全て終わるまで待つ。
+			void Run(const std::function<void()>& Job) {
+				{
+					std::lock_guard lock(mutex);
+					job = &Job;
+					working = threads.size();
+					round++;
 				}
+				wake.notify_all();
+				Job();
+				std::unique_lock lock(mutex);
+				finished.wait(lock, [this] { return working == 0; });
 			}
 
-			[[nodiscard]] auto Result() noexcept {
-				return std::move(events);
+			static WorkerPool& Instance() noexcept {
+				static WorkerPool pool;
+				return pool;
 			}
 		};
 
-		static EventGenerator& Instance() noexcept {
-			static EventGenerator evg;
-			return evg;
+		// 作業スレッドで扱える値の型であるか否か。
+		// アニメーション・フレームは他の変数と中身を共有しうる為、扱わない。
+		bool IsPlainValue(const Value& V) noexcept {
+			switch (V.GetType()) {
+				case Value::Type::Null:
+				case Value::Type::Int:
+				case Value::Type::Dec:
+				case Value::Type::String:
+					return true;
+				default:
+					return false;
+			}
 		}
 
-		void Generate(const std::wstring& Path) noexcept {
-			CharCode cc;
-			char* plain_text;
-			ReadWTextFile(Path.c_str(), &plain_text, &cc);
-			std::wstring sentence;
-			switch (cc) {
-				case CharCode::CP932:
-				{
-					std::string str = plain_text;
-					wchar_t *converted = new wchar_t[str.size()];
-					CP932ToWide(converted, str.c_str(), str.size());
-					sentence = converted;
-					delete[] plain_text;
-					delete[] converted;
-					break;
-				}
-				case CharCode::UTF8:
-				{
-					std::u8string str = reinterpret_cast<char8_t*>(plain_text);
-					wchar_t *converted = new wchar_t[str.size()];
-					UTF8ToWide(converted, str.c_str(), str.size());
-					sentence = converted;
-					delete[] plain_text;
-					delete[] converted;
-					break;
-				}
-				case CharCode::UTF16BE:
-					Reverse16Endian(reinterpret_cast<char16_t*>(plain_text));
-					[[fallthrough]];
-				case CharCode::UTF16LE:
-				{
-					std::u16string str = reinterpret_cast<char16_t*>(plain_text);
-					wchar_t *converted = new wchar_t[str.size()];
-					UTF16ToWide(converted, str.c_str(), str.size());
-					sentence = converted;
-					delete[] plain_text;
-					delete[] converted;
+		// 逐次実行と並行実行の結果が同じであるか否か。
+		bool IsSameValue(const Value& A, const Value& B) noexcept {
+			if (A.GetType() != B.GetType())
+				return false;
+			switch (A.GetType()) {
+				case Value::Type::Null:
+					return true;
+				case Value::Type::Int:
+					return A.Get<int>() == B.Get<int>();
+				case Value::Type::Dec:
+					return A.Get<Dec>() == B.Get<Dec>();
+				case Value::Type::String:
+					return A.Get<std::wstring>() == B.Get<std::wstring>();
+				default:
+					return false;
+			}
+		}
+	}
+
+	void Manager::Analyze(Event* event) {
+		auto& access = event->access;
+		access = {};
+		access.analyzed = true;
+		access.isolated = true;
+
+		// 実行の仕組みが書き換える変数は、作業スレッドでは値が異なる為、参照するイベントは主スレッドで実行する。
+		const std::wstring_view Managed_Names[] = {
+			L"of_state", variable::Managing_Var_Name, variable::Managing_Entity_Name, variable::Managing_Entity_Kind_Name, variable::Executing_Event_Name
+		};
+		// 変数の引数であれば、その名前を加える。
+		auto add_variable = [&access, &Managed_Names](std::vector<std::wstring>* names, const std::wstring& Param) -> bool {
+			const auto [Name, Type] = Default_ProgramInterface.GetParamInfo(Param);
+			if (Default_ProgramInterface.IsNumberType(Type) || Default_ProgramInterface.IsStringType(Type))
+				return false;
+			if (std::find(std::begin(Managed_Names), std::end(Managed_Names), Param) != std::end(Managed_Names))
+				access.isolated = false;
+			// 添字付きの引数(配列[添字])は配列の要素を読む為、主スレッドで実行する。
+			if (Name.find(L'[') != Name.npos)
+				access.isolated = false;
+			names->push_back(Param);
+			return true;
+		};
+
+		for (const auto& Tree : event->commands) {
+			const auto English = keyword::BuiltinName(Tree.word);
+			const auto& Params = Tree.params;
+			if (English == L"case") {
+				if (!Params.empty())
+					add_variable(&access.reads, Params[0]);
+			} else if (English == L"of") {
+				// 比較する値の変数が無い場合は、名前を書式として展開する。
+				if (!Params.empty() && add_variable(&access.reads, Params.back()) && Params.back().find(L'{') != std::wstring::npos)
+					access.reads_any = true;
+			} else if (English == L"else" || English == L"endcase") {
+				continue;
+			} else if (English == L"assign" || English == L"sum" || English == L"sub" || English == L"mul" || English == L"div" ||
+				English == L"mod" || English == L"or" || English == L"and" || English == L"xor" || English == L"not")
+			{
+				const size_t Operand_Count = (English == L"assign" || English == L"not" ? 1 : 2);
+				if (Params.size() < Operand_Count + 1 || !add_variable(&access.writes, Params[0])) {
+					access.isolated = false;
 					break;
 				}
-				case CharCode::UTF32BE:
-					Reverse32Endian(reinterpret_cast<char32_t*>(plain_text));
-					[[fallthrough]];
-				case CharCode::UTF32LE:
-				{
-					std::u32string str = reinterpret_cast<char32_t*>(plain_text);
-					wchar_t *converted = new wchar_t[str.size()];
-					UTF32ToWide(converted, str.c_str(), str.size());
-					sentence = converted;
-					delete[] plain_text;
-					delete[] converted;
-					break;
+				for (size_t i = 1; i < Params.size(); i++) {
+					if (add_variable(&access.reads, Params[i])) {
+						// 代入する値が文字列であれば、書式として展開される。
+						if (English == L"assign")
+							access.formats.push_back(Params[i]);
+					} else if (English == L"assign" && Params[i].find(L'{') != std::wstring::npos) {
+						access.reads_any = true;
+					}
 				}
+			} else {
+				// 変数の読み書き以外の副作用(Entity・レイヤー・描画・エンジン・他のイベント等)を持ちうる。
+				access.isolated = false;
+				break;
 			}
-			Parser parser(sentence);
-			events = std::move(parser.Result());
 		}
+	}
 
-		[[nodiscard]] auto Result() noexcept {
-			return std::move(events);
+	bool Manager::Schedule(Event* event) noexcept {
+		const auto& Access = event->access;
+		if (!Access.isolated)
+			return false;
+
+		// DynamicCommand::GetParamと同じく、イベント内の変数と全体の変数の両方を読みうる。
+		auto& var_manager = Program::Instance().var_manager;
+		const auto& Event_Name = *event->trigger_link.name;
+		resolved_reads.clear();
+		resolved_writes.clear();
+		bool reads_any = Access.reads_any;
+		for (const auto& Name : Access.reads) {
+			for (const Value* Var : { &var_manager.Get<false>(Event_Name + L'.' + Name), &var_manager.Get<false>(Name) }) {
+				if (!IsPlainValue(*Var))
+					return false;
+				resolved_reads.push_back(Var);
+			}
+		}
+		for (const auto& Name : Access.formats) {
+			for (const Value* Var : { &var_manager.Get<false>(Event_Name + L'.' + Name), &var_manager.Get<false>(Name) }) {
+				if (Var->Is<std::wstring>() && Var->Get<std::wstring>().find(L'{') != std::wstring::npos)
+					reads_any = true;
+			}
+		}
+		for (const auto& Name : Access.writes) {
+			// 代入先が無い場合は変数を作り直す確認を行う為、主スレッドで実行する。
+			const Value* Var = &var_manager.Get<false>(Name);
+			if (Var->Is<std::nullptr_t>() || !IsPlainValue(*Var))
+				return false;
+			resolved_writes.push_back(Var);
 		}
-	private:
-		std::unordered_map<std::wstring, Event> events;
-	};
 
-	// 
-	void Manager::ConditionManager::SetTarget(std::any& tv) {
-		target_value = tv;
+		// 組の中のイベントが書き込む変数を読み書きせず、組の中のイベントが読む変数に書き込まない場合のみ、並行して実行できる。
+		if ((reads_any && !batch_writes.empty()) || (batch_reads_any && !resolved_writes.empty()))
+			return false;
+		for (const auto *const Var : resolved_writes) {
+			if (batch_reads.contains(Var) || batch_writes.contains(Var))
+				return false;
+		}
+		for (const auto *const Var : resolved_reads) {
+			if (batch_writes.contains(Var))
+				return false;
+		}
+
+		batch_reads.insert(resolved_reads.begin(), resolved_reads.end());
+		batch_writes.insert(resolved_writes.begin(), resolved_writes.end());
+		batch_reads_any = batch_reads_any || reads_any;
+		batch.push_back(event);
+		return true;
+	}
+
+	void Manager::RunIsolated(IsolatedRun* run) noexcept {
+		auto *const event = run->event;
+		auto& context = run->context;
+		run->of_state = 1;
+		context.of_state = &run->of_state;
+		context.condition_manager.clear();
+		context.condition_current = context.condition_manager.end();
+		const uint32 Parameter_Count = static_cast<uint32>(event->param_names.size());
+		context.argument_stack.assign(Parameter_Count, Value{});
+		context.frames.push_back(Frame{ .event_name = event->trigger_link.name, .event = event, .argument_count = Parameter_Count });
+
+		worker_context = &context;
+		error::UserErrorHandler::Stage(&run->errors);
+		CommandExecuter cmd_executer(event);
+		error::UserErrorHandler::Stage(nullptr);
+		worker_context = nullptr;
+
+		context.frames.clear();
+		context.argument_stack.clear();
 	}
 
-	// ]
-	bool Manager::ConditionManager::Evalute(const std::wstring& Mode, const std::any& Right_Value) noexcept {
-		can_execute = true;
-		auto& target_type = target_value.type();
-		// ^݂̂rB
-		if (target_type == Right_Value.type()) {
-			if (Mode == L"==") {
-				if (target_type == typeid(int)) {
-					can_execute = (std::any_cast<int>(target_value) == std::any_cast<int>(Right_Value));
-				} else if (target_type == typeid(Dec)) {
-					can_execute = (std::any_cast<Dec>(target_value) == std::any_cast<Dec>(Right_Value));
-				} else if (target_type == typeid(std::wstring)) {
-					can_execute = (std::any_cast<std::wstring>(target_value) == std::any_cast<std::wstring>(Right_Value));
-				}
-			} else if (Mode == L"!") {
-				if (target_type == typeid(int)) {
-					can_execute = (std::any_cast<int>(target_value) != std::any_cast<int>(Right_Value));
-				} else if (target_type == typeid(Dec)) {
-					can_execute = (std::any_cast<Dec>(target_value) != std::any_cast<Dec>(Right_Value));
-				} else if (target_type == typeid(std::wstring)) {
-					can_execute = (std::any_cast<std::wstring>(target_value) != std::any_cast<std::wstring>(Right_Value));
-				}
-			} else if (Mode == L"<=") {
-				if (target_type == typeid(int)) {
-					can_execute = (std::any_cast<int>(target_value) <= std::any_cast<int>(Right_Value));
-				} else if (target_type == typeid(Dec)) {
-					can_execute = (std::any_cast<Dec>(target_value) <= std::any_cast<Dec>(Right_Value));
-				}
-			} else if (Mode == L">=") {
-				if (target_type == typeid(int)) {
-					can_execute = (std::any_cast<int>(target_value) >= std::any_cast<int>(Right_Value));
-				} else if (target_type == typeid(Dec)) {
-					can_execute = (std::any_cast<Dec>(target_value) >= std::any_cast<Dec>(Right_Value));
-				}
-			} else if (Mode == L"<") {
-				if (target_type == typeid(int)) {
-					can_execute = (std::any_cast<int>(target_value) < std::any_cast<int>(Right_Value));
-				} else if (target_type == typeid(Dec)) {
-					can_execute = (std::any_cast<Dec>(target_value) < std::any_cast<Dec>(Right_Value));
-				}
-			} else if (Mode == L">") {
-				if (target_type == typeid(int)) {
-					can_execute = (std::any_cast<int>(target_value) > std::any_cast<int>(Right_Value));
-				} else if (target_type == typeid(Dec)) {
-					can_execute = (std::any_cast<Dec>(target_value) > std::any_cast<Dec>(Right_Value));
+	void Manager::FlushBatch() noexcept {
+		const size_t Count = batch.size();
+		if (Count == 1) {
+			Call(HandleOf(batch.front()));
+			parallel_stats.serial_events++;
+		} else if (Count >= 2) {
+			if (isolated_runs.size() < Count)
+				isolated_runs.resize(Count);
+			for (size_t i = 0; i < Count; i++)
+				isolated_runs[i].event = batch[i];
+
+			// 確かめる場合は、逐次実行し直せるよう書き込む変数の値を控えておく。
+			std::vector<std::pair<Value*, Value>> saved{};
+			if (parallel.verify) {
+				for (const auto *const Var : batch_writes)
+					saved.emplace_back(const_cast<Value*>(Var), *Var);
+			}
+
+			std::atomic<size_t> next = 0;
+			const std::function<void()> Work = [this, &next, Count]() {
+				for (size_t i = next++; i < Count; i = next++)
+					RunIsolated(&isolated_runs[i]);
+			};
+			WorkerPool::Instance().Run(Work);
+			parallel_stats.batches++;
+			parallel_stats.parallel_events += Count;
+
+			auto& var_manager = Program::Instance().var_manager;
+			// 最後に実行されたイベントの分岐の状態が、変数of_stateに残る。
+			const IsolatedRun* last{};
+			for (size_t i = 0; i < Count; i++) {
+				if (!isolated_runs[i].event->commands.empty())
+					last = &isolated_runs[i];
+			}
+
+			if (!parallel.verify) {
+				// 逐次実行した場合と同じ順に、命令を持つイベント毎に変数of_stateを作り直し、エラーを送る。
+				for (size_t i = 0; i < Count; i++) {
+					auto& run = isolated_runs[i];
+					if (!run.event->commands.empty())
+						var_manager.MakeNew(L"of_state") = run.of_state;
+					error_handler.Commit(&run.errors);
+				}
+			} else {
+				// 並行実行の結果を控えて実行前の値へ戻し、逐次実行した結果と比べる。逐次実行の結果を残す。
+				std::vector<Value> results{};
+				for (auto& [var, before] : saved) {
+					results.push_back(*var);
+					*var = before;
+				}
+				for (size_t i = 0; i < Count; i++) {
+					isolated_runs[i].errors = {};
+					Call(HandleOf(batch[i]));
+				}
+
+				bool same = (last == nullptr || IsSameValue(var_manager.Get<false>(L"of_state"), last->of_state));
+				for (size_t i = 0; i < saved.size(); i++)
+					same = same && IsSameValue(*saved[i].first, results[i]);
+				parallel_stats.verified_batches++;
+				if (!same) {
+					parallel_stats.mismatches++;
+					std::wstring names{};
+					for (const auto *const E : batch)
+						names += *E->trigger_link.name + L'\n';
+					error_handler.SendLocalError(parallel_mismatch_error, names);
 				}
 			}
 		}
-		return can_execute;
+		batch.clear();
+		batch_reads.clear();
+		batch_writes.clear();
+		batch_reads_any = false;
 	}
 
-	void Manager::ConditionManager::FreeCase() {
-		target_value.reset();
+	void Manager::ExecuteAutoInParallel() noexcept {
+		WorkerPool::Instance().Resize(parallel.threads - 1);
+		for (auto event : auto_events) {
+			if (event->program.empty())
+				CommandExecuter::Compile(event);
+			if (!event->access.analyzed)
+				Analyze(event);
+			if (Schedule(event))
+				continue;
+
+			// 組に加えられない場合は、それまでの組を実行してから改めて組を作る。
+			FlushBatch();
+			if (Schedule(event))
+				continue;
+			Call(HandleOf(event));
+			parallel_stats.serial_events++;
+		}
+		FlushBatch();
 	}
 
-	Manager::Manager() {
-		error_class = error_handler.MakeErrorClass(L"CxgG[");
-		call_error = error_handler.MakeError(error_class, L"w肳ꂽCxg܂B", MB_OK | MB_ICONERROR, 2);
+	int32 Manager::RangeGrid::CellOf(const Dec Position) const noexcept {
+		constexpr Dec Limit = static_cast<Dec>(1 << 30);
+		return static_cast<int32>(std::clamp(std::floor(Position / cell_size), -Limit, Limit));
 	}
 
-	std::unordered_map<std::wstring, Event> Manager::GenerateEvent(const std::wstring& Path) noexcept {
-		EventGenerator::Instance().Generate(Path);
-		return EventGenerator::Instance().Result();
+	uint64 Manager::RangeGrid::Key(const int32 X, const int32 Y) noexcept {
+		return (static_cast<uint64>(static_cast<uint32>(X)) << 32) | static_cast<uint32>(Y);
 	}
 
-	void Manager::LoadEvent(const std::wstring path) noexcept {
-		events = std::move(GenerateEvent(path));
-		OnLoad();
+	void Manager::RangeGrid::SetCellSize(const Dec Size) noexcept {
+		cell_size = (Size > 0.0 ? Size : 64.0);
 	}
 
-	void Manager::RequestEvent(const std::wstring& Path) noexcept {
-		requesting_path = Path;
-	}
+	void Manager::RangeGrid::Insert(Event* event) {
+		// 一つのイベントが登録されるセルの数の上限
+		constexpr int64 Max_Cells = 256;
+		const auto& Min = event->origin[0], &Max = event->origin[1];
+		// 端を含まない為、大きさの無い範囲は何とも重ならない。
+		if (Min.size() < 2 || Max.size() < 2 || !(Min[0] < Max[0] && Min[1] < Max[1]))
+			return;
+
+		auto& link = event->range_link;
+		link.indexed = true;
+		link.cells[0][0] = CellOf(Min[0]);
+		link.cells[0][1] = CellOf(Min[1]);
+		link.cells[1][0] = CellOf(Max[0]);
+		link.cells[1][1] = CellOf(Max[1]);
+		const int64 Cell_Count = (static_cast<int64>(link.cells[1][0]) - link.cells[0][0] + 1) * (static_cast<int64>(link.cells[1][1]) - link.cells[0][1] + 1);
+		link.oversized = (Cell_Count > Max_Cells);
+		if (link.oversized) {
+			oversized.push_back(event);
+			return;
+		}
 
-	void Manager::ImportEvent(const std::wstring& Path) noexcept {
-		auto additional = std::move(GenerateEvent(Path));
-		for (auto& e : additional) {
-			events[e.first] = std::move(e.second);
+		for (int32 x = link.cells[0][0]; x <= link.cells[1][0]; x++) {
+			for (int32 y = link.cells[0][1]; y <= link.cells[1][1]; y++)
+				cells[Key(x, y)].push_back(event);
 		}
-		OnLoad();
 	}
 
-	void Manager::OnLoad() noexcept {
-		for (auto& e : events) {
-			if (e.second.trigger_type == TriggerType::Load) {
-				e.second.trigger_type = TriggerType::None;
-				Call(e.first);
+	void Manager::RangeGrid::Erase(Event* event) noexcept {
+		auto remove = [event](std::vector<Event*>* list) {
+			if (auto it = std::find(list->begin(), list->end(), event); it != list->end()) {
+				*it = list->back();
+				list->pop_back();
+			}
+		};
+
+		auto& link = event->range_link;
+		if (!link.indexed)
+			return;
+		link.indexed = false;
+		if (link.oversized) {
+			remove(&oversized);
+			return;
+		}
+
+		for (int32 x = link.cells[0][0]; x <= link.cells[1][0]; x++) {
+			for (int32 y = link.cells[0][1]; y <= link.cells[1][1]; y++) {
+				auto cell = cells.find(Key(x, y));
+				if (cell == cells.end())
+					continue;
+				remove(&cell->second);
+				if (cell->second.empty())
+					cells.erase(cell);
 			}
 		}
 	}
 
-	void Manager::Update() noexcept {
-		std::queue<std::wstring> dead;
-		for (auto& e : events) {
-			auto& event = e.second;
-			if (event.trigger_type == TriggerType::Auto) {
-				Call(e.first);
-				if (event.commands.empty()) {
-					dead.push(e.first);
+	void Manager::RangeGrid::Clear() noexcept {
+		cells.clear();
+		oversized.clear();
+	}
+
+	void Manager::RangeGrid::BeginQuery() noexcept {
+		query_stamp++;
+	}
+
+	void Manager::RangeGrid::Query(const WorldVector& Min, const WorldVector& Max, std::vector<Event*>* results) {
+		auto test = [&](Event* event) {
+			auto& link = event->range_link;
+			if (link.query_stamp == query_stamp)
+				return;
+			link.query_stamp = query_stamp;
+
+			const auto& Event_Min = event->origin[0], &Event_Max = event->origin[1];
+			if (Event_Min[0] < Max[0] && Min[0] < Event_Max[0] && Event_Min[1] < Max[1] && Min[1] < Event_Max[1])
+				results->push_back(event);
+		};
+
+		for (auto event : oversized)
+			test(event);
+
+		const int32 Left = CellOf(Min[0]), Top = CellOf(Min[1]), Right = CellOf(Max[0]), Bottom = CellOf(Max[1]);
+		const int64 Cell_Count = (static_cast<int64>(Right) - Left + 1) * (static_cast<int64>(Bottom) - Top + 1);
+		if (Cell_Count > static_cast<int64>(cells.size())) {
+			// 検索範囲が広い場合は、登録されているセルを全て調べる方が速い。
+			for (auto& cell : cells) {
+				for (auto event : cell.second)
+					test(event);
+			}
+			return;
+		}
+
+		for (int32 x = Left; x <= Right; x++) {
+			for (int32 y = Top; y <= Bottom; y++) {
+				if (auto cell = cells.find(Key(x, y)); cell != cells.end()) {
+					for (auto event : cell->second)
+						test(event);
 				}
 			}
 		}
+	}
 
-		error_handler.ShowLocalError(4);
+	namespace {
+		// 中断の時刻に用いる、単調に増える時刻(ミリ秒)
+		int64 SteadyMilliseconds() noexcept {
+			return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		}
 
-		while (!dead.empty()) {
-			events.erase(dead.front());
-			dead.pop();
+		// 予算の計測に用いる、単調に増える時刻(マイクロ秒)
+		int64 SteadyMicroseconds() noexcept {
+			return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
 		}
+	}
 
-		if (!requesting_path.empty()) {
-			LoadEvent(requesting_path);
-			requesting_path.clear();
+	int64 Manager::ElapsedMicroseconds() const noexcept {
+		return used_microseconds + (main_context.frames.empty() ? 0 : SteadyMicroseconds() - slice_begin);
+	}
+
+	void Manager::BeginSlice() noexcept {
+		if (budget.microseconds > 0)
+			slice_begin = SteadyMicroseconds();
+	}
+
+	void Manager::EndSlice() noexcept {
+		if (budget.microseconds > 0)
+			used_microseconds += SteadyMicroseconds() - slice_begin;
+	}
+
+	void Manager::Preempt() noexcept {
+		if (!exhausted) {
+			exhausted = true;
+			budget_stats.overrun_frames++;
 		}
+		if (main_context.frames.empty() || is_suspending)
+			return;
+
+		Suspend(WakeKind::Frame, 1);
+		budget_stats.preempted_calls++;
 	}
 
-	void Manager::ExecuteEvent(const WorldVector origin) noexcept {
-		for (auto& e : events) {
-			auto& event = e.second;
-			if (event.origin[0][0] < origin[0] && origin[0] < event.origin[1][0] &&
-				event.origin[0][1] < origin[1] && origin[1] < event.origin[1][1])
-			{
-				Call(e.first);
+	bool Manager::Call(const std::wstring& EName) noexcept {
+		return Call(FindHandle(EName));
+	}
+
+	bool Manager::Call(const EventHandle Handle, const Value* Arguments, const size_t Argument_Count) noexcept {
+		// 引数が引数領域の中を指していても良いよう、一つずつ写してから積む。
+		for (size_t i = 0; i < Argument_Count; i++)
+			PushArgument(Value(Arguments[i]));
+		return CallPushed(Handle, static_cast<uint32>(Argument_Count));
+	}
+
+	bool Manager::CallPushed(const EventHandle Handle, const uint32 Pushed_Count) noexcept {
+		auto& frames = main_context.frames;
+		auto& argument_stack = main_context.argument_stack;
+		const uint32 Argument_Base = static_cast<uint32>(argument_stack.size() - Pushed_Count);
+		const auto *const Slot = Resolve(Handle);
+		if (Slot == nullptr) {
+			argument_stack.resize(Argument_Base);
+			return false;
+		}
+		const std::wstring& Event_Name = *Slot->name;
+		auto *const event = Slot->event;
+
+		// 積まれた引数の数を、イベントの引数の数に合わせる。(余りは捨て、足りない分はnullとする)
+		const uint32 Parameter_Count = static_cast<uint32>(event->param_names.size());
+		argument_stack.resize(static_cast<size_t>(Argument_Base) + Parameter_Count);
+
+		// スクリプトから参照できるよう、呼出中のイベント名を変数にも末尾へ書き足して反映する。
+		// 呼出情報が正であり、変数が書き換えられていた場合は呼出情報から作り直す。
+		auto& var_manager = Program::Instance().var_manager;
+		const size_t Name_Length = Event_Name.size();
+		size_t names_length = 0;
+		if (auto& names = var_manager.Get<false>(variable::Executing_Event_Name); names.Is<std::wstring>()) {
+			auto& text = names.Get<std::wstring>();
+			names_length = text.size();
+			text += Event_Name;
+			text += L'\n';
+		}
+
+		const bool Is_Outermost = frames.empty();
+		if (Is_Outermost)
+			BeginSlice();
+		const bool Profiling = profiler.IsEnabled();
+		if (Profiling) [[unlikely]] {
+			if (event->profile == nullptr)
+				event->profile = profiler.EventEntry(Event_Name);
+			profiler.Begin(event->profile);
+		}
+		frames.push_back(Frame{ .event_name = &Event_Name, .event = event, .argument_base = Argument_Base, .argument_count = Parameter_Count });
+		CommandExecuter cmd_executer(event);
+		frames.pop_back();
+		argument_stack.resize(Argument_Base);
+		if (Profiling) [[unlikely]]
+			profiler.End();
+		if (Is_Outermost) {
+			EndSlice();
+			// 最も外側の呼出まで巻き戻したら、再開を待つ継続として登録する。
+			if (is_suspending) {
+				is_suspending = false;
+				Enqueue(std::move(suspending));
+				suspending = {};
+			}
+		}
+
+		if (auto& names = var_manager.Get<false>(variable::Executing_Event_Name); names.Is<std::wstring>()) {
+			auto& text = names.Get<std::wstring>();
+			if (text.size() == names_length + Name_Length + 1)
+				text.resize(names_length);
+			else
+				text = JoinFrameNames();
+		}
+		return true;
+	}
+
+	std::wstring Manager::JoinFrameNames() const {
+		std::wstring names{};
+		for (const auto& F : main_context.frames) {
+			names += *F.event_name;
+			names += L'\n';
+		}
+		return names;
+	}
+
+	void Manager::Suspend(const WakeKind Kind, const int64 Amount) noexcept {
+		if (main_context.frames.empty() || Amount <= 0)
+			return;
+
+		suspending = {};
+		suspending.priority = current_priority;
+		suspending.kind = Kind;
+		suspending.wake_at = (Kind == WakeKind::Time ? SteadyMilliseconds() : frame_count) + Amount;
+		is_suspending = true;
+	}
+
+	void Manager::SuspendUntil(const std::wstring& Var_Name, const Comparison Mode, const Value& Right_Value) noexcept {
+		if (main_context.frames.empty())
+			return;
+
+		suspending = {};
+		suspending.priority = current_priority;
+		suspending.kind = WakeKind::Condition;
+		suspending.variable = Var_Name;
+		suspending.comparison = Mode;
+		suspending.value = Right_Value;
+		is_suspending = true;
+	}
+
+	bool Manager::IsResumable(const SuspendedFrame& Saved) const noexcept {
+		auto it = events.find(Saved.event_name);
+		return (it != events.end() && &it->second == Saved.event && it->second.generation == Saved.generation);
+	}
+
+	void Manager::Enqueue(Continuation&& continuation) {
+		if (continuation.frames.empty())
+			return;
+
+		for (auto& saved : continuation.frames)
+			saved.event->suspended++;
+
+		const uint64 Id = next_continuation++;
+		switch (continuation.kind) {
+			case WakeKind::Frame:
+				frame_waits.emplace_back(continuation.wake_at, Id);
+				std::push_heap(frame_waits.begin(), frame_waits.end(), std::greater<>{});
+				break;
+			case WakeKind::Time:
+				time_waits.emplace_back(continuation.wake_at, Id);
+				std::push_heap(time_waits.begin(), time_waits.end(), std::greater<>{});
 				break;
+			case WakeKind::Condition:
+				condition_waits.push_back(Id);
+				break;
+		}
+		continuations.emplace(Id, std::move(continuation));
+	}
+
+	void Manager::Discard(Continuation* continuation) noexcept {
+		for (auto& saved : continuation->frames) {
+			if (IsResumable(saved) && saved.event->suspended > 0)
+				saved.event->suspended--;
+		}
+	}
+
+	void Manager::ResumeSuspended() noexcept {
+		if (continuations.empty())
+			return;
+
+		waking.clear();
+		auto pop_until = [this](std::vector<std::pair<int64, uint64>>* waits, const int64 Now) {
+			while (!waits->empty() && waits->front().first <= Now) {
+				std::pop_heap(waits->begin(), waits->end(), std::greater<>{});
+				waking.push_back(waits->back().second);
+				waits->pop_back();
+			}
+		};
+		pop_until(&frame_waits, frame_count);
+		pop_until(&time_waits, SteadyMilliseconds());
+
+		// 変数の変更は通知されない為、条件は毎フレーム評価する。
+		// 変数はイベント内の変数から探し、無ければ全体の変数から探す。
+		if (!condition_waits.empty()) {
+			auto& var_manager = Program::Instance().var_manager;
+			std::erase_if(condition_waits, [&](const uint64 Id) {
+				const auto& Waiting = continuations.at(Id);
+				const Value& Target = var_manager.Get<false>(Waiting.frames.front().event_name + L'.' + Waiting.variable);
+				if (Target.GetType() != Waiting.value.GetType() || !EvaluteCondition(Waiting.comparison, Target, Waiting.value))
+					return false;
+				waking.push_back(Id);
+				return true;
+			});
+		}
+
+		// 優先度の高い継続から再開する。
+		// 再開したイベントが再び中断しても、同じフレームの内には再開しない。
+		std::stable_partition(waking.begin(), waking.end(), [this](const uint64 Id) {
+			auto it = continuations.find(Id);
+			return (it != continuations.end() && it->second.priority == Priority::High);
+		});
+		for (const auto Id : waking) {
+			auto it = continuations.find(Id);
+			if (it == continuations.end())
+				continue;
+
+			// 予算を使い切った後は、再開を次のフレームへ延ばす。
+			if (exhausted) {
+				frame_waits.emplace_back(frame_count + 1, Id);
+				std::push_heap(frame_waits.begin(), frame_waits.end(), std::greater<>{});
+				budget_stats.deferred_events++;
+				continue;
 			}
+			auto node = continuations.extract(it);
+			Resume(std::move(node.mapped()));
 		}
 	}
 
-	bool Manager::Call(const std::wstring& EName) noexcept {
-		auto candidate = events.find(EName);
-		if (candidate != events.end()) {
-			auto event_name = std::any_cast<std::wstring>(Program::Instance().var_manager.Get<false>(variable::Executing_Event_Name));	
-			Program::Instance().var_manager.Get<false>(variable::Executing_Event_Name) = (event_name += std::wstring(EName) + L"\n");
-			CommandExecuter cmd_executer(&candidate->second.commands);
-			event_name.erase(event_name.find(EName + L"\n"));
-			Program::Instance().var_manager.Get<false>(variable::Executing_Event_Name) = event_name;
-			return true;
+	void Manager::Resume(Continuation&& continuation) noexcept {
+		auto& saved_frames = continuation.frames;
+		Discard(&continuation);
+		// 中断中にイベントが差し替えられた場合は、呼出元も含めて再開しない。
+		for (const auto& Saved : saved_frames) {
+			if (!IsResumable(Saved))
+				return;
 		}
-		return false;
+
+		// 呼出元から順に呼出情報を積み直し、最も内側の呼出から実行する。
+		auto& frames = main_context.frames;
+		auto& argument_stack = main_context.argument_stack;
+		const size_t Argument_Base = argument_stack.size();
+		for (auto it = saved_frames.rbegin(); it != saved_frames.rend(); it++) {
+			frames.push_back(Frame{
+				.event_name = &events.find(it->event_name)->first,
+				.event = it->event,
+				.pc = it->pc,
+				.argument_base = static_cast<uint32>(argument_stack.size()),
+				.argument_count = static_cast<uint32>(it->arguments.size())
+			});
+			argument_stack.insert(argument_stack.end(), it->arguments.begin(), it->arguments.end());
+		}
+
+		const auto Previous_Priority = current_priority;
+		current_priority = continuation.priority;
+		BeginSlice();
+
+		auto& var_manager = Program::Instance().var_manager;
+		auto update_names = [this, &var_manager]() {
+			if (auto& names = var_manager.Get<false>(variable::Executing_Event_Name); names.Is<std::wstring>())
+				names.Get<std::wstring>() = JoinFrameNames();
+		};
+		for (size_t i = 0; i < saved_frames.size(); i++) {
+			update_names();
+			// 再開は呼出回数に数えない。
+			auto *const event = saved_frames[i].event;
+			const bool Profiling = profiler.IsEnabled();
+			if (Profiling) [[unlikely]] {
+				if (event->profile == nullptr)
+					event->profile = profiler.EventEntry(saved_frames[i].event_name);
+				profiler.Begin(event->profile, false);
+			}
+			CommandExecuter cmd_executer(event, &saved_frames[i]);
+			argument_stack.resize(frames.back().argument_base);
+			frames.pop_back();
+			if (Profiling) [[unlikely]]
+				profiler.End();
+			if (is_suspending) {
+				// 再び中断した場合は、まだ再開していない呼出元を新しい継続へ引き継ぐ。
+				for (size_t j = i + 1; j < saved_frames.size(); j++) {
+					frames.pop_back();
+					suspending.frames.push_back(std::move(saved_frames[j]));
+				}
+				argument_stack.resize(Argument_Base);
+				is_suspending = false;
+				Enqueue(std::move(suspending));
+				suspending = {};
+				break;
+			}
+		}
+		update_names();
+		EndSlice();
+		current_priority = Previous_Priority;
+	}
+
+	const std::wstring& Manager::ExecutingEventName() const noexcept {
+		static const std::wstring Empty{};
+		const auto& Frames = Context().frames;
+		return (Frames.empty() ? Empty : *Frames.back().event_name);
 	}
 
-	void Manager::NewCaseTarget(std::any tv) {
-		condition_manager.push_back(ConditionManager(tv));
-		condition_current = condition_manager.end() - 1;
+	Value& Manager::OfState() noexcept {
+		auto& context = Context();
+		return (context.of_state != nullptr ? *context.of_state : Program::Instance().var_manager.Get<false>(L"of_state"));
 	}
 
-	bool Manager::Evalute(const std::wstring& Mode, const std::any& Right_Value) {
-		if (!condition_manager.empty() && condition_current != condition_manager.end())
-			return condition_current->Evalute(Mode, Right_Value);
+	void Manager::NewCaseTarget(Value tv) {
+		auto& context = Context();
+		context.condition_manager.push_back(ConditionManager(tv));
+		context.condition_current = context.condition_manager.end() - 1;
+	}
+
+	bool Manager::Evalute(const Predicate Condition, const Value& Right_Value, const size_t Hash) {
+		auto& context = Context();
+		if (!context.condition_manager.empty() && context.condition_current != context.condition_manager.end())
+			return context.condition_current->Evalute(Condition, Right_Value, Hash);
 		else
 			return false;
 	}
 
 	void Manager::FreeCase() {
-		condition_current->FreeCase();
-		condition_manager.pop_back();
-		if (!condition_manager.empty())
-			condition_current = condition_manager.end() - 1;
+		auto& context = Context();
+		context.condition_current->FreeCase();
+		context.condition_manager.pop_back();
+		if (!context.condition_manager.empty())
+			context.condition_current = context.condition_manager.end() - 1;
 	}
 
 	bool Manager::CanOfExecute() const noexcept {
-		if (!condition_manager.empty() && condition_current != condition_manager.end()) {
-			return (condition_current->CanExecute());
+		const auto& Current = Context();
+		if (!Current.condition_manager.empty() && Current.condition_current != Current.condition_manager.end()) {
+			return (Current.condition_current->CanExecute());
 		} else
 			return true;
 	}
 
 	void Manager::MakeEmptyEvent(const std::wstring& Event_Name) {
-		events[Event_Name] = Event();
+		SetEvent(Event_Name, Event());
+	}
+
+	void Manager::Link(const std::wstring& Event_Name, Event* event) noexcept {
+		Unlink(event);
+		auto& list = trigger_lists[static_cast<size_t>(event->trigger_type)];
+		event->trigger_link = {
+			.name = &Event_Name,
+			.prev = list.back,
+			.type = event->trigger_type,
+			.linked = true
+		};
+		(list.back != nullptr ? list.back->trigger_link.next : list.front) = event;
+		list.back = event;
+	}
+
+	void Manager::Unlink(Event* event) noexcept {
+		auto& link = event->trigger_link;
+		if (!link.linked)
+			return;
+
+		auto& list = trigger_lists[static_cast<size_t>(link.type)];
+		(link.prev != nullptr ? link.prev->trigger_link.next : list.front) = link.next;
+		(link.next != nullptr ? link.next->trigger_link.prev : list.back) = link.prev;
+		link.prev = link.next = nullptr;
+		link.linked = false;
+	}
+
+	void Manager::RelinkAll() noexcept {
+		for (auto& list : trigger_lists)
+			list = {};
+		range_grid.Clear();
+		// 以前のイベントは全て破棄されている為、全ての識別子を無効にする。
+		free_handle_slots.clear();
+		for (uint32 i = 0; i < handle_slots.size(); i++) {
+			auto& slot = handle_slots[i];
+			if (slot.event != nullptr)
+				slot.generation++;
+			slot.event = nullptr;
+			slot.name = nullptr;
+			free_handle_slots.push_back(i);
+		}
+		event_generation++;
+
+		for (auto& e : events) {
+			e.second.trigger_link.linked = false;
+			e.second.range_link = {};
+			e.second.handle_index = ~uint32{ 0 };
+			e.second.generation = ++last_event_generation;
+			Link(e.first, &e.second);
+			range_grid.Insert(&e.second);
+			AssignHandle(e.first, &e.second);
+		}
+	}
+
+	void Manager::SetEvent(const std::wstring& Event_Name, Event&& event) noexcept {
+		auto [it, inserted] = events.try_emplace(Event_Name);
+		Unlink(&it->second);
+		range_grid.Erase(&it->second);
+		// 置き換えても同じイベント名を指し続けるよう、識別子は引き継ぐ。
+		const uint32 Handle_Index = it->second.handle_index;
+		it->second = std::move(event);
+		it->second.trigger_link.linked = false;
+		it->second.range_link = {};
+		it->second.handle_index = Handle_Index;
+		it->second.generation = ++last_event_generation;
+		Link(it->first, &it->second);
+		range_grid.Insert(&it->second);
+		if (inserted)
+			AssignHandle(it->first, &it->second);
+		event_generation++;
+	}
+
+	void Manager::EraseEvent(const std::wstring& Event_Name) noexcept {
+		auto it = events.find(Event_Name);
+		if (it == events.end())
+			return;
+		Unlink(&it->second);
+		range_grid.Erase(&it->second);
+		ReleaseHandle(&it->second);
+		events.erase(it);
+		event_generation++;
+	}
+
+	void Manager::AssignHandle(const std::wstring& Event_Name, Event* event) {
+		uint32 index{};
+		if (!free_handle_slots.empty()) {
+			index = free_handle_slots.back();
+			free_handle_slots.pop_back();
+		} else {
+			index = static_cast<uint32>(handle_slots.size());
+			handle_slots.emplace_back();
+		}
+		auto& slot = handle_slots[index];
+		slot.event = event;
+		slot.name = &Event_Name;
+		event->handle_index = index;
+	}
+
+	void Manager::ReleaseHandle(Event* event) noexcept {
+		if (event->handle_index >= handle_slots.size())
+			return;
+
+		auto& slot = handle_slots[event->handle_index];
+		slot.generation++;
+		slot.event = nullptr;
+		slot.name = nullptr;
+		free_handle_slots.push_back(event->handle_index);
+		event->handle_index = ~uint32{ 0 };
+	}
+
+	const Manager::HandleSlot* Manager::Resolve(const EventHandle Handle) const noexcept {
+		if (Handle.index >= handle_slots.size())
+			return nullptr;
+		const auto& Slot = handle_slots[Handle.index];
+		return (Slot.event != nullptr && Slot.generation == Handle.generation ? &Slot : nullptr);
+	}
+
+	EventHandle Manager::HandleOf(const Event* event) const noexcept {
+		if (event->handle_index >= handle_slots.size())
+			return {};
+		return { .index = event->handle_index, .generation = handle_slots[event->handle_index].generation };
+	}
+
+	EventHandle Manager::FindHandle(const std::wstring& Event_Name) const noexcept {
+		auto it = events.find(Event_Name);
+		return (it != events.end() ? HandleOf(&it->second) : EventHandle{});
+	}
+
+	Event* Manager::GetEvent(const EventHandle Handle) noexcept {
+		const auto *const Slot = Resolve(Handle);
+		return (Slot != nullptr ? Slot->event : nullptr);
+	}
+
+	void Manager::ChangeTriggerType(Event* event, const TriggerType Type) noexcept {
+		event->trigger_type = Type;
+		if (event->trigger_link.linked)
+			Link(*event->trigger_link.name, event);
+	}
+
+	void Manager::ChangeRange(Event* event, const WorldVector& Min, const WorldVector& Max) noexcept {
+		range_grid.Erase(event);
+		event->origin[0] = Min;
+		event->origin[1] = Max;
+		range_grid.Insert(event);
 	}
 
 	Event* Manager::GetEvent(const std::wstring& Event_Name) noexcept {
@@ -4427,7 +8329,7 @@ namespace karapo::event {
 
 	void EventEditor::AddCommand(const std::wstring& Command_Sentence, const int Index) {
 		auto commands = std::move(EventGenerator::Parser(
-			L"[_~[]\n<n>\n()\n" + Command_Sentence
+			L"[ダミー]\n<n>\n()\n" + Command_Sentence
 		).Result().begin()->second.commands);
 
 		for (auto& cmd : commands) {
@@ -4440,6 +8342,9 @@ namespace karapo::event {
 					targeting->commands.insert(std::next(targeting->commands.begin(), Index), std::move(cmd));
 			}
 		}
+		// 命令列は次回の実行時に変換し直す。
+		targeting->program.clear();
+		Program::Instance().event_manager.Renew(targeting);
 	}
 
 	void EventEditor::SetTarget(const std::wstring& Event_Name) {
@@ -4447,16 +8352,16 @@ namespace karapo::event {
 	}
 
 	void EventEditor::ChangeRange(const WorldVector& Min, const WorldVector& Max) {
-		targeting->origin[0] = Min;
-		targeting->origin[1] = Max;
+		Program::Instance().event_manager.ChangeRange(targeting, Min, Max);
 	}
 
 	void EventEditor::ChangeTriggerType(const std::wstring& TSentence) {
-		targeting->trigger_type = EventGenerator::Parser(
-			std::wstring(L"[_~[]\n") +
+		const auto Trigger_Type = EventGenerator::Parser(
+			std::wstring(L"[ダミー]\n") +
 			L'<' + TSentence + L'>' +
 			std::wstring(L"\n()\n{}")
 		).Result().begin()->second.trigger_type;
+		Program::Instance().event_manager.ChangeTriggerType(targeting, Trigger_Type);
 	}
 
 	void command::Alias::Execute() {
@@ -4466,7 +8371,7 @@ namespace karapo::event {
 	void command::Bind::Execute() {
 		static uint64_t count = 0;
 		EventGenerator::Parser parser;
-		const auto Event_Name = L"__L[Cxg_" + std::to_wstring(count++);
+		const auto Event_Name = L"__キーイベント_" + std::to_wstring(count++);
 		auto editor = Program::Instance().MakeEventEditor();
 		editor->MakeNewEvent(Event_Name);
 		editor->ChangeTriggerType(L"n");
@@ -1,95 +1,540 @@
 /**
-* Event.hpp - [UIɃQ[𐧌䂷邽߂̒`QB
+* Event.hpp - ユーザが逐次的にゲームを制御するための定義群。
 */
 #pragma once
 
 namespace karapo::event {
 	namespace innertype {
-		constexpr const wchar_t *const Number = L"number";			// l^(܂͕_)
-		constexpr const wchar_t *const String = L"string";			// ^(܂͕)
-		constexpr const wchar_t *const Undecided = L"";	// ^
-		constexpr const wchar_t *const None = L"";					// ^(ϐ̋L)
-		constexpr const wchar_t *const Block = L"scope";			// XR[v^({ ܂ })
+		constexpr const wchar_t *const Number = L"number";			// 数値型(整数または浮動小数点数)
+		constexpr const wchar_t *const String = L"string";			// 文字列型(文字または文字列)
+		constexpr const wchar_t *const Undecided = L"";	// 未決定型
+		constexpr const wchar_t *const None = L"";					// 型無し(変数や特定の記号)
+		constexpr const wchar_t *const Block = L"scope";			// スコープ型({ または })
 	}
 
-	// Cxg^Cv
+	// イベント発生タイプ
 	enum class TriggerType {
-		Invalid,				// s
-		None,					// Ȃ(callp)
-		Load,					// [hs
-		Auto,					// s
-		Trigger,				// GĂԂɎs
-		Button					// L[
+		Invalid,				// 不正
+		None,					// 何もしない(call用)
+		Load,					// ロード後実行
+		Auto,					// 自動実行
+		Trigger,				// 触れている間に実行
+		Button					// 決定キー
+	};
+	constexpr size_t Trigger_Type_Count = static_cast<size_t>(TriggerType::Button) + 1;
+
+	// 条件式の比較方法
+	enum class Comparison : uint8 {
+		Equal,			// ==
+		NotEqual,		// !
+		LessEqual,		// <=
+		GreaterEqual,	// >=
+		Less,			// <
+		Greater,		// >
+		Unknown			// 不明(常に真)
+	};
+
+	// 比較方法と値の型毎に特殊化した条件式
+	// 条件対象・そのハッシュ値・比較する値・そのハッシュ値を受け取る。ハッシュ値は文字列の場合のみ用いる。
+	using Predicate = bool(*)(const Value&, const size_t, const Value&, const size_t) noexcept;
+
+	// 中断したイベントを再開する時機の種類
+	enum class WakeKind : uint8 {
+		Frame,		// 指定したフレーム数の後
+		Time,		// 指定した時間(ミリ秒)の後
+		Condition	// 変数が条件を満たした後
 	};
 
 	struct CommandTree final {
 		std::unique_ptr<Command> command{};
-		std::wstring word{};	// R}h
+		std::wstring word{};	// コマンド名
 		CommandTree* parent{};
+		std::vector<std::wstring> params{};	// コマンドの引数(名前:型)
+	};
+
+	// イベント・コマンド毎の実行時間の計測
+	// 有効にしている間のみ計測し、無効の間は命令毎に有効か否かを確かめるだけで済ませる。
+	class Profiler final {
+	public:
+		// 計測対象(イベント、またはコマンドの種類)毎の統計
+		struct Entry final {
+			std::wstring name{};
+			bool is_command = false;
+			uint64 calls = 0;
+			int64 inclusive_ns = 0;		// 内側の呼出を含む時間(再帰呼出は最も外側のみを数える)
+			int64 exclusive_ns = 0;		// 内側で呼び出したイベントを除く時間
+			uint32 active = 0;			// 計測中の数
+		};
+	private:
+		// 呼出の経路(先頭は根)
+		struct StackNode final {
+			Entry* entry{};
+			uint32 parent = 0;
+			std::unordered_map<Entry*, uint32> children{};
+			int64 self_ns = 0;			// 内側の全ての計測範囲を除く時間
+		};
+		// 計測中の範囲
+		struct Scope final {
+			Entry* entry{};
+			uint32 node = 0;
+			int64 begin = 0;
+			int64 nested_events_ns = 0;	// 内側で呼び出したイベントの時間
+			int64 nested_ns = 0;		// 内側の全ての計測範囲の時間
+		};
+
+		// 統計を0へ戻しても要素は消さない為、Entryへのポインタは常に有効。
+		std::unordered_map<std::wstring, Entry> events{}, commands{};
+		std::vector<StackNode> nodes{ StackNode{} };
+		std::vector<Scope> scopes{};
+		bool enabled = false;
+	public:
+		bool IsEnabled() const noexcept {
+			return enabled;
+		}
+		// 計測を開始・停止する。
+		void Enable(const bool) noexcept;
+		// 統計を全て0へ戻す。
+		void Reset() noexcept;
+
+		// イベント・コマンドの統計を返す。無ければ作る。
+		Entry* EventEntry(const std::wstring&);
+		Entry* CommandEntry(const std::wstring&);
+
+		// 計測範囲を開始する。Countがfalseの場合は呼出回数に数えない。(中断からの再開等)
+		void Begin(Entry*, const bool Count = true);
+		// 最も内側の計測範囲を終了する。
+		void End() noexcept;
+		// コマンドを実行し、その時間を計測する。
+		void Measure(Entry*, Command*);
+
+		// 統計を"<Base_Path>.csv"へ、呼出の経路毎の時間を折り畳んだスタック形式で"<Base_Path>.folded"へ書き出す。
+		// コマンドは別名を英語名へ揃えて出力する。
+		bool Dump(const std::wstring& Base_Path) const;
+	};
+
+	// 命令
+	// CommandTreeを実行順に並べ、分岐先を解決したもの。
+	struct Instruction final {
+		enum class Op : uint8 {
+			Execute,	// コマンドを実行し、targetへ進む。
+			Branch,		// コマンドを実行し、条件を満たしていればtargetへ、満たしていなければ次の命令へ進む。
+			Switch,		// caseの値でtarget番目の分岐表を引き、該当する分岐へ進む。表の型と異なる値の場合は次の命令へ進む。
+			Halt		// 実行終了
+		};
+
+		Op op = Op::Halt;
+		Command* command{};
+		uint32 target{};
+		Profiler::Entry* profile{};		// コマンドの種類の統計
+	};
+
+	// 分岐表
+	// caseに続くofが全て同じ型の定数との一致判定である場合に、caseの値から分岐先を直接引く。
+	struct BranchTable final {
+		Value::Type type = Value::Type::Null;				// 定数の型(整数または文字列)
+		std::unordered_map<int, uint32> int_targets{};
+		std::unordered_map<std::wstring, uint32> string_targets{};
+		uint32 default_target{};	// どの定数とも一致しない場合の分岐先
+		bool has_else = false;		// default_targetがelseの分岐先か否か。
+		// ofより前に置かれたelse(省略されたelseを補ったもの)の分岐先
+		// 直前のof_stateが偽の場合に選ばれる。
+		uint32 leading_else_target{};
+		bool has_leading_else = false;
 	};
 
-	// Cxg
+	// イベント
 	struct Event {
 		using Commands = std::list<CommandTree>;
 		
-		Commands commands;						// R}h
-		TriggerType trigger_type;				// Cxg^Cv
-		WorldVector origin[2];					// Cxg
-		std::vector<std::wstring> param_names{};	// 
+		Commands commands;						// コマンド
+		std::vector<Instruction> program{};		// commandsを変換した命令列(空の場合は未変換)
+		std::vector<BranchTable> branch_tables{};	// programが参照する分岐表
+		TriggerType trigger_type = TriggerType::Invalid;	// イベント発生タイプ
+		WorldVector origin[2];					// イベント
+		std::vector<std::wstring> param_names{};	// 引数名
+
+		// 発生タイプ毎のイベント一覧での繋がり(Managerが設定する)
+		struct TriggerLink final {
+			const std::wstring* name{};		// イベント名(イベント一覧のキー)
+			Event *prev{}, *next{};
+			TriggerType type = TriggerType::Invalid;	// 繋がれている一覧の発生タイプ
+			bool linked = false;
+		} trigger_link{};
+
+		// 範囲の索引への登録状態(Managerが設定する)
+		struct RangeLink final {
+			int32 cells[2][2]{};		// 登録されているセルの範囲(左上と右下)
+			uint64 query_stamp = 0;		// 最後に検索結果へ加えられた検索の番号
+			bool indexed = false;
+			bool oversized = false;		// セルではなく、大きな範囲の一覧に登録されているか否か。
+		} range_link{};
+
+		// 再開を待っている呼出の数(0でなければ、自動実行等では実行しない)
+		uint32 suspended = 0;
+		// 実行時間の統計(最初に計測した時に設定する)
+		Profiler::Entry* profile{};
+		// 割り当てられた識別子の位置(Managerが設定する)
+		uint32 handle_index = ~uint32{ 0 };
+		// 登録された時の世代(Managerが登録・置換の度に新しい値を設定する。中断した呼出の再開判定に用いる)
+		uint64 generation = 0;
+		// 定義しているファイル(監視中のみManagerが設定する。監視中のファイル一覧のキーを指す)
+		const std::wstring* source_file{};
+
+		// 変数の読み書き(Managerが命令列への変換後に求め、自動実行イベントの並行実行に用いる)
+		struct AccessSet final {
+			std::vector<std::wstring> reads{}, writes{};	// 読み書きする変数名(書かれた通りの名前)
+			std::vector<std::wstring> formats{};	// 値が文字列であれば、書式として展開する変数名
+			bool analyzed = false;
+			bool isolated = false;		// 変数の読み書き以外の副作用を持たず、作業スレッドで実行できるか否か。
+			bool reads_any = false;		// 実行時まで分からない変数を読むか否か。
+		} access{};
+	};
+
+	// 呼出中のイベントの情報
+	struct Frame final {
+		const std::wstring* event_name{};	// イベント名(イベント一覧のキー)
+		Event* event{};
+		uint32 pc = 0;		// 実行中の命令の位置。内側のイベントを呼び出している間は戻り先を表す。
+		// 引数(Managerの引数領域のargument_base番目から、param_namesの順に並ぶ)
+		uint32 argument_base = 0, argument_count = 0;
 	};
 
-	// CxgǗNX
-	// [h̃CxgeǗÁ͉AR}hssB
+	// イベント管理クラス
+	// ワールド毎のイベント内容管理、文章解析、コマンド実行等を行う。
 	class Manager final : private Singleton {
-		// CxgǂݍޕKv邩ۂB
+		// イベントを読み込む必要があるか否か。
 		std::wstring requesting_path{};
 	
 		class ConditionManager final {
-			std::any target_value;
+			Value target_value;
+			size_t target_hash = 0;		// 条件対象が文字列の場合のハッシュ値
 			bool can_execute = true;
 		public:
 			ConditionManager() = default;
-			ConditionManager(std::any& tv) { SetTarget(tv); }
-			void SetTarget(std::any& tv);
-			// ]
-			bool Evalute(const std::wstring&, const std::any&) noexcept;
+			ConditionManager(Value& tv) { SetTarget(tv); }
+			void SetTarget(Value& tv);
+			// 条件式を評価する
+			bool Evalute(const Predicate, const Value&, const size_t) noexcept;
 			void FreeCase();
 			bool CanExecute() const noexcept { return can_execute; }
+			const Value& Target() const noexcept { return target_value; }
+			// 分岐表により評価した結果を設定する。
+			void SetResult(const bool Result) noexcept { can_execute = Result; }
 		};
 		
-		std::deque<ConditionManager> condition_manager;
-		decltype(condition_manager)::iterator condition_current;
+		// イベントを実行する為の状態
+		// 自動実行イベントを並行して実行する間は、作業スレッド毎に別の状態を用いる。
+		struct ExecutionContext final {
+			// 呼出中のイベント(末尾が最も内側で実行中のイベント)
+			// 要素への参照が呼出の間も有効であるよう、std::dequeを用いる。
+			std::deque<Frame> frames{};
+			// 呼出中のイベントの引数
+			// 呼出毎に末尾へ積み、戻る時に取り除く為、呼出を繰り返しても大きさは変わらない。
+			std::vector<Value> argument_stack{};
+			std::deque<ConditionManager> condition_manager{};
+			decltype(condition_manager)::iterator condition_current{};
+			// 分岐の状態(nullptrの場合は変数of_stateを用いる)
+			Value* of_state{};
+		};
+		ExecutionContext main_context{};
+		// 作業スレッドで実行中の状態(それ以外のスレッドではnullptr)
+		inline static thread_local ExecutionContext* worker_context = nullptr;
+
+		ExecutionContext& Context() noexcept {
+			return (worker_context != nullptr ? *worker_context : main_context);
+		}
+
+		const ExecutionContext& Context() const noexcept {
+			return (worker_context != nullptr ? *worker_context : main_context);
+		}
 
 		std::unordered_map<std::wstring, Event> events;
-		// Cxg𐶐B
+
+		// 発生タイプ毎のイベント一覧
+		// 各イベントのtrigger_linkで繋ぎ、毎フレームの自動実行等で全てのイベントを辿らずに済ませる。
+		struct TriggerList final {
+			Event *front{}, *back{};
+		};
+		TriggerList trigger_lists[Trigger_Type_Count]{};
+		// 自動実行するイベント(Updateの作業領域)
+		std::vector<Event*> auto_events{};
+
+		// イベント範囲の索引
+		// 空間を一定の大きさのセルに分け、セル毎に範囲が重なるイベントを持つ。
+		class RangeGrid final {
+			std::unordered_map<uint64, std::vector<Event*>> cells{};
+			std::vector<Event*> oversized{};	// 多くのセルに跨る為、セルに登録しないイベント
+			Dec cell_size = 64.0;
+			uint64 query_stamp = 0;
+
+			// 座標を含むセルの位置を返す。
+			int32 CellOf(const Dec) const noexcept;
+			// セルの位置から、cellsのキーを返す。
+			static uint64 Key(const int32, const int32) noexcept;
+		public:
+			void SetCellSize(const Dec) noexcept;
+			// イベントを範囲に基づいて登録する。範囲を持たないイベントは登録しない。
+			void Insert(Event*);
+			void Erase(Event*) noexcept;
+			void Clear() noexcept;
+			// 新しい検索を始める。同じ検索の間は、同じイベントを結果へ重複して加えない。
+			void BeginQuery() noexcept;
+			// 範囲(端を含まない)が重なるイベントをresultsへ加える。
+			void Query(const WorldVector& Min, const WorldVector& Max, std::vector<Event*>* results);
+		};
+		RangeGrid range_grid{};
+		// 触れられているイベント(FireTriggersの作業領域)
+		std::vector<Event*> touched_events{};
+		// Entityに触れられている、発生タイプがTriggerのイベントを実行する。
+		void FireTriggers() noexcept;
+
+		// 識別子が指す先
+		// イベント毎に1つ割り当て、イベントが削除されると世代を進めて再利用する。
+		struct HandleSlot final {
+			Event* event{};
+			const std::wstring* name{};		// イベント名(イベント一覧のキー)
+			uint32 generation = 0;
+		};
+		std::vector<HandleSlot> handle_slots{};
+		std::vector<uint32> free_handle_slots{};
+		// イベント一覧の構成が変わった回数
+		uint64 event_generation = 0;
+		// 最後にイベントへ割り当てた世代(イベントのアドレスや命令列が再利用されても区別できるよう、減らさない)
+		uint64 last_event_generation = 0;
+
+		// イベントに識別子を割り当てる。
+		void AssignHandle(const std::wstring& Event_Name, Event*);
+		// イベントの識別子を解放し、以前の識別子を無効にする。
+		void ReleaseHandle(Event*) noexcept;
+		// 識別子が指す先を返す。無効な識別子の場合はnullptrを返す。
+		const HandleSlot* Resolve(const EventHandle) const noexcept;
+		// イベントの現在の識別子を返す。
+		EventHandle HandleOf(const Event*) const noexcept;
+
+		// イベントを発生タイプの一覧の末尾へ繋ぐ。既に繋がれている場合は繋ぎ直す。
+		void Link(const std::wstring& Event_Name, Event*) noexcept;
+		// イベントを発生タイプの一覧から外す。
+		void Unlink(Event*) noexcept;
+		// 全てのイベントを発生タイプの一覧へ繋ぎ直し、識別子を割り当て直す。
+		void RelinkAll() noexcept;
+		// イベントを追加、または置き換える。
+		void SetEvent(const std::wstring&, Event&&) noexcept;
+		// イベントを削除する。
+		void EraseEvent(const std::wstring&) noexcept;
+
+		// イベントを生成する。
 		std::unordered_map<std::wstring, Event> GenerateEvent(const std::wstring&) noexcept;
+		// 複数のファイルから並行してイベントを生成する。
+		std::unordered_map<std::wstring, Event> GenerateEvent(const std::vector<std::wstring>&) noexcept;
 		void OnLoad() noexcept;
+		// 指定したイベントの内、発生タイプがLoadのもののみを実行する。
+		void OnLoad(const std::vector<std::wstring>&) noexcept;
 
-		error::ErrorContent *call_error{};
+		error::ErrorContent *call_error{}, *parallel_mismatch_error{};
+
+		// 呼出中のイベント名を改行区切りで連結した文字列を返す。
+		std::wstring JoinFrameNames() const;
+
+		// 実行の優先度
+		// 予算を超えて持ち越した呼出は、優先度の高いものから再開する。
+		enum class Priority : uint8 {
+			High,		// 読込時・ボタン・座標からの実行等
+			Low			// 自動実行・触れている間の実行
+		};
+		// 実行中の最も外側の呼出の優先度
+		Priority current_priority = Priority::High;
+
+		// 中断したイベントの呼出情報
+		struct SuspendedFrame final {
+			std::wstring event_name{};
+			Event* event{};
+			uint64 generation = 0;			// 中断時のイベントの世代(イベントが差し替えられていれば再開しない)
+			uint32 pc = 0;					// 再開する命令の位置
+			int of_state = 1;
+			std::vector<ConditionManager> conditions{};	// このイベント内で始まり、終わっていないcase
+			std::vector<Value> arguments{};
+		};
+		// 中断した呼出の全体と、再開の条件
+		struct Continuation final {
+			std::vector<SuspendedFrame> frames{};	// 先頭が最も内側の呼出
+			WakeKind kind = WakeKind::Frame;
+			int64 wake_at = 0;				// 再開するフレーム番号、または時刻(ミリ秒)
+			std::wstring variable{};		// waituntilで監視する変数名
+			Comparison comparison = Comparison::Unknown;
+			Value value{};
+			Priority priority = Priority::High;
+		};
+		// 中断の要求を受け、呼出を巻き戻している途中の継続
+		Continuation suspending{};
+		bool is_suspending = false;
+
+		std::unordered_map<uint64, Continuation> continuations{};
+		uint64 next_continuation = 0;
+		// 再開するフレーム番号・時刻と継続の番号の組(最小ヒープ)
+		std::vector<std::pair<int64, uint64>> frame_waits{}, time_waits{};
+		// 条件を満たすまで待つ継続(毎フレーム評価する)
+		std::vector<uint64> condition_waits{};
+		// 再開する継続(Updateの作業領域)
+		std::vector<uint64> waking{};
+		int64 frame_count = 0;
+
+		// 巻き戻し終えた継続を、再開の条件に応じた待ち行列へ加える。
+		void Enqueue(Continuation&&);
+		// 継続が参照するイベントの中断の数を戻す。
+		void Discard(Continuation*) noexcept;
+		// 中断した時のイベントが、差し替えられずに残っているか否か。
+		bool IsResumable(const SuspendedFrame&) const noexcept;
+		// 再開の時機が来た継続を再開する。
+		void ResumeSuspended() noexcept;
+		// 継続を最も内側の呼出から順に実行する。
+		void Resume(Continuation&&) noexcept;
+
+		// 現在のフレームで使った予算
+		uint64 used_instructions = 0;
+		int64 used_microseconds = 0;	// 終了した呼出に掛かった時間
+		int64 slice_begin = 0;			// 実行中の最も外側の呼出を始めた時刻(マイクロ秒)
+		bool exhausted = false;			// 現在のフレームの予算を使い切ったか否か。
+		// 予算を使い切った為に実行しなかった自動実行イベントの位置(次のフレームはここから実行する)
+		size_t auto_cursor = 0;
+
+		// 現在のフレームでスクリプトの実行に掛かった時間(マイクロ秒)を返す。
+		int64 ElapsedMicroseconds() const noexcept;
+		// 最も外側の呼出の開始・終了時に、掛かった時間を記録する。
+		void BeginSlice() noexcept;
+		void EndSlice() noexcept;
+		// 予算を使い切ったことを記録し、実行中のイベントを次のフレームへ持ち越す。
+		void Preempt() noexcept;
+		// 命令を1つ実行した分の予算を使う。予算を超えた場合は実行中のイベントを中断させる。
+		// 時間は16命令毎に確認する。
+		void Consume() noexcept {
+			if (!IsBudgeted())
+				return;
+			used_instructions++;
+			if (exhausted || (budget.instructions > 0 && used_instructions > budget.instructions) ||
+				(budget.microseconds > 0 && used_instructions % 16 == 0 && ElapsedMicroseconds() > budget.microseconds))
+				Preempt();
+		}
+
+		// 作業スレッドで実行した自動実行イベントの状態と結果
+		struct IsolatedRun final {
+			Event* event{};
+			ExecutionContext context{};
+			Value of_state = 1;
+			error::UserErrorHandler::StagedErrors errors{};
+		};
+		std::vector<IsolatedRun> isolated_runs{};
+		// 並行して実行する自動実行イベント(Updateの作業領域)
+		std::vector<Event*> batch{};
+		// batchが読み書きする変数
+		std::unordered_set<const Value*> batch_reads{}, batch_writes{};
+		bool batch_reads_any = false;
+		// Scheduleの作業領域
+		std::vector<const Value*> resolved_reads{}, resolved_writes{};
+
+		// イベントが読み書きする変数を調べる。
+		static void Analyze(Event*);
+		// 読み書きする変数を現在の変数の構成で解決し、batchと並行して実行できるか否かを返す。
+		// 実行できる場合は、解決した変数をbatch_reads・batch_writesへ加える。
+		bool Schedule(Event*) noexcept;
+		// batchのイベントを作業スレッドで実行し、結果を逐次実行と同じ順に反映する。
+		void FlushBatch() noexcept;
+		// 作業スレッドでイベントを実行する。
+		void RunIsolated(IsolatedRun*) noexcept;
+		// 自動実行イベントを、並行して実行できるものは作業スレッドで実行する。
+		void ExecuteAutoInParallel() noexcept;
+
+		// 変更を監視しているイベントファイル
+		struct WatchedFile final {
+			int64 last_write_time{};
+			std::unordered_map<std::wstring, uint64> hashes{};	// イベント名と、その原文のハッシュ値
+		};
+		std::unordered_map<std::wstring, WatchedFile> watched_files{};
+		// ファイルを確認する間隔(ミリ秒)。0の場合は監視しない。(config.iniの[event] watch)
+		int watch_interval = 0;
+		int64 last_watched = 0;
+
+		// 直前のGenerateEventで読み込んだファイルを監視対象に加え、解析した原文のイベント毎のハッシュ値を記録する。
+		void Watch(const std::vector<std::wstring>&) noexcept;
+		// 監視中のファイルが更新されていれば、内容が変わったイベントのみを生成し直して差し替える。
+		void ReloadChangedEvents() noexcept;
 
 		Manager();
 		~Manager() = default;
 	public:
 		class CommandExecuter;
-		// Cxgǂݍ݁AVݒ肵B
+		// 実行中のイベントを中断する。呼出元のイベントも含めて、コマンドの実行後に中断される。
+		// Amountが0以下の場合は中断しない。
+		void Suspend(const WakeKind, const int64 Amount) noexcept;
+		// 実行中のイベントを、変数が条件を満たすまで中断する。
+		void SuspendUntil(const std::wstring& Var_Name, const Comparison, const Value&) noexcept;
+
+		// 命令列へ変換せず、CommandTreeを直接辿ってコマンドを実行するクラス。(比較用)
+		class LegacyCommandExecuter;
+		// イベントを読み込み、新しく設定し直す。
 		void LoadEvent(const std::wstring Path) noexcept;
-		// Cxg̒xǂݍ݁B
+		// イベントの遅延読み込み。
 		void RequestEvent(const std::wstring&) noexcept;
-		// Cxgǂݍ݁AǉŐݒ肷B
+		// イベントを読み込み、追加で設定する。
 		void ImportEvent(const std::wstring&) noexcept;
-		// WCxgsB
+		// 複数のファイルからイベントをまとめて読み込み、追加で設定する。
+		// 同名のイベントは後に指定されたファイルのものが優先され、OnLoadは最後に一度だけ実行される。
+		void ImportEvent(const std::vector<std::wstring>&) noexcept;
+		// 座標からイベントを実行する。
 		void ExecuteEvent(const WorldVector) noexcept;
-		// CxgCxgsB
+		// イベント名からイベントを実行する。
 		bool Call(const std::wstring&) noexcept;
+		// 識別子からイベントを実行する。
+		// 引数はイベントのparam_namesの順に渡し、渡されなかった引数はnullとなる。
+		bool Call(const EventHandle, const Value* Arguments = nullptr, const size_t Argument_Count = 0) noexcept;
+		// 次のCallPushedへ渡す引数を、引数領域の末尾へ積む。
+		// 引数領域は呼出を繰り返しても縮まない為、数値の引数であれば領域を確保し直さない。
+		void PushArgument(Value&& argument) {
+			main_context.argument_stack.push_back(std::move(argument));
+		}
+		// 識別子からイベントを実行する。
+		// 直前にPushArgumentで積んだPushed_Count個の値を、そのまま引数として用いる。
+		// 積んだ値は、実行できたか否かに関わらず取り除かれる。
+		bool CallPushed(const EventHandle, const uint32 Pushed_Count) noexcept;
+		// 最も内側で実行中のイベントのIndex番目の引数を返す。引数が無い場合はnullptrを返す。
+		const Value* Argument(const uint32 Index) const noexcept {
+			const auto& Current = Context();
+			if (Current.frames.empty() || Index >= Current.frames.back().argument_count)
+				return nullptr;
+			return &Current.argument_stack[Current.frames.back().argument_base + Index];
+		}
+		// イベント名から識別子を返す。該当するイベントが無い場合は無効な識別子を返す。
+		EventHandle FindHandle(const std::wstring&) const noexcept;
+		// イベント一覧の構成が変わった(読込・追加・置換・削除)回数を返す。
+		// 値が変わっていなければ、以前に得た識別子は同じイベントを指す。
+		uint64 Generation() const noexcept {
+			return event_generation;
+		}
+		// 最も内側で実行中のイベント名を返す。実行中でなければ空文字列を返す。
+		const std::wstring& ExecutingEventName() const noexcept;
+		// 呼出中のイベントを返す。(末尾が最も内側)
+		const std::deque<Frame>& Frames() const noexcept {
+			return Context().frames;
+		}
+		// 分岐の状態を返す。作業スレッド以外では変数of_stateを返す。
+		Value& OfState() noexcept;
 		//
 		void Update() noexcept;
 
 		Event* GetEvent(const std::wstring&) noexcept;
+		Event* GetEvent(const EventHandle) noexcept;
 
 		void MakeEmptyEvent(const std::wstring&);
+		// イベントの発生タイプを変更する。
+		void ChangeTriggerType(Event*, const TriggerType) noexcept;
+		// イベント発生の範囲を変更する。
+		void ChangeRange(Event*, const WorldVector&, const WorldVector&) noexcept;
+		// イベントの内容を書き換えた事を記録し、書き換え前に中断した呼出を再開しないようにする。
+		void Renew(Event* event) noexcept {
+			event->generation = ++last_event_generation;
+		}
 
-		void NewCaseTarget(std::any);
-		bool Evalute(const std::wstring&, const std::any&);
+		void NewCaseTarget(Value);
+		bool Evalute(const Predicate, const Value&, const size_t Hash);
 		void FreeCase();
 		bool CanOfExecute() const noexcept;
 
@@ -100,26 +545,116 @@ namespace karapo::event {
 
 		error::UserErrorHandler error_handler{};
 		error::ErrorClass *error_class{};
+
+		// イベント生成時の最適化の統計(各処理の累計)
+		struct OptimizationStats final {
+			uint64 optimized_events = 0;		// 最適化したイベント
+			uint64 folded_calculations = 0;		// 定数同士の演算を代入へ置き換えた数
+			uint64 removed_arms = 0;			// 静的に結果が決まり、削除した分岐
+			uint64 expanded_cases = 0;			// 常に同じ分岐へ進む為、分岐の中身へ置き換えたcase
+			uint64 removed_unreachable = 0;		// 到達しない為、削除したコマンド
+			uint64 removed_stores = 0;			// 読まれる前に上書きされる為、削除した代入
+			uint64 removed_loads = 0;			// 後の読込に上書きされる為、削除した読込
+		};
+		// イベント生成時に最適化を行うか否か。(config.iniの[event] optimize、既定は1)
+		bool optimization_enabled = true;
+		OptimizationStats optimization_stats{};
+
+		// スクリプトの実行に1フレームで使える予算(0は無制限)
+		// 予算を超えたイベントは実行中の位置で中断し、次のフレームへ持ち越す。
+		struct ExecutionBudget final {
+			uint64 instructions = 0;	// 命令数(config.iniの[event] budget_instructions)
+			int64 microseconds = 0;		// 時間(config.iniの[event] budget_us)
+		};
+		ExecutionBudget budget{};
+
+		// 予算が設定されているか否か。
+		// 設定されている場合、全てのコマンドの実行後にイベントが中断しうる。
+		bool IsBudgeted() const noexcept {
+			return budget.instructions > 0 || budget.microseconds > 0;
+		}
+
+		// 予算の統計
+		struct BudgetStats final {
+			uint64 overrun_frames = 0;		// 予算を使い切ったフレーム
+			uint64 preempted_calls = 0;		// 予算を超えた為、中断して次のフレームへ持ち越した呼出
+			uint64 deferred_events = 0;		// 予算が無い為、実行・再開を次のフレームへ延ばしたイベント
+			uint64 last_instructions = 0;	// 直前のフレームで実行した命令数(予算が無制限の場合は数えない)
+			int64 last_microseconds = 0;	// 直前のフレームで実行に掛かった時間(時間の予算を設定した場合のみ計る)
+		};
+		BudgetStats budget_stats{};
+
+		// 実行時間の計測(config.iniの[event] profileが1の場合は起動時から計測する)
+		Profiler profiler{};
+
+		// 自動実行イベントの並行実行
+		// 変数の読み書き以外の副作用を持たず、読み書きする変数が重ならない自動実行イベントを、作業スレッドで同時に実行する。
+		// 予算を設定している場合と、計測中は並行して実行しない。
+		struct ParallelConfig final {
+			uint32 threads = 0;		// 実行に用いるスレッドの数(主スレッドを含む。1以下は並行実行しない。config.iniの[event] parallel)
+			bool verify = false;	// 並行実行の後に逐次実行し直し、結果が同じであるかを確かめる。(config.iniの[event] parallel_verify)
+		};
+		ParallelConfig parallel{};
+
+		// 並行実行の統計
+		struct ParallelStats final {
+			uint64 batches = 0;				// 並行して実行した組
+			uint64 parallel_events = 0;		// 並行して実行したイベント
+			uint64 serial_events = 0;		// 並行実行が有効な間に、主スレッドで実行した自動実行イベント
+			uint64 verified_batches = 0;	// 逐次実行と結果を比べた組
+			uint64 mismatches = 0;			// 逐次実行と結果が異なった組
+		};
+		ParallelStats parallel_stats{};
+	};
+
+	// イベントのコマンド実行クラス
+	// CommandTreeを命令列へ変換し、命令を順に実行する。
+	class Manager::CommandExecuter final {
+		// caseコマンドの直後に並ぶ分岐コマンドか否か。
+		static bool IsBranch(const CommandTree&) noexcept;
+	public:
+		// 命令列と分岐表へ変換する。
+		static void Compile(Event*);
+
+		// resumingが指定された場合は、中断した位置から実行を再開する。
+		CommandExecuter(Event*, SuspendedFrame* resuming = nullptr);
 	};
 
-	// CxgҏWNX
+	class Manager::LegacyCommandExecuter final {
+	public:
+		LegacyCommandExecuter(const std::list<CommandTree>*);
+	};
+
+	// イベント編集クラス
 	class EventEditor final {
 		Event* targeting = nullptr;
 	public:
-		// ݁AҏW̃CxgۂB
+		// 現在、編集中のイベントを持つか否か。
 		bool IsEditing() const noexcept;
-		// ݁AY閼ÕCxgҏWۂB
+		// 現在、該当する名前のイベントを編集中か否か。
 		bool IsEditing(const std::wstring&) const noexcept;
 
-		// ṼCxg쐬AҏWΏۂɂB
+		// 新しい空のイベントを作成、編集対象にする。
 		void MakeNewEvent(const std::wstring&);
-		// w肵ÕCxgҏWΏۂƂĐݒ肷B
+		// 指定した名前のイベントを編集対象として設定する。
 		void SetTarget(const std::wstring&);
-		// Cxg̎ނݒ肷B
+		// イベント発生の種類を設定する。
 		void ChangeTriggerType(const std::wstring&);
-		// Cxg͈̔͂ݒ肷B
+		// イベント発生の範囲を設定する。
 		void ChangeRange(const WorldVector&, const WorldVector&);
-		// R}hǉB
+		// コマンドを追加する。
 		void AddCommand(const std::wstring&, const int);
 	};
+
+	// 解析の段階名と、その段階の処理を受け取る関数
+	using PhaseMeasurer = std::function<void(const char*, const std::function<void()>&)>;
+	// ファイルからイベントを生成し、解析の各段階をMeasureへ渡して行わせる。(計測用)
+	// 段階は"decode"、"lexical"、"type"、"syntax"、"semantic"、"optimize"、"compile"の順に渡される。
+	// 生成したイベント数を返す。
+	size_t ParseInPhases(const std::wstring& Path, const PhaseMeasurer& Measure) noexcept;
+
+#if defined(KARAPO_BENCHMARK)
+	// 原文を従来の解析器と新しい解析器で解析し、生成したイベントの内、一致しないものの数を返す。(計測用)
+	size_t CompareWithLegacyParser(std::wstring sentence) noexcept;
+#endif
 }
\ No newline at end of file
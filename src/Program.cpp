@@ -2,25 +2,26 @@
 
 #include <fstream>
 #include <filesystem>
+#include <algorithm>
 
 namespace karapo {
 	void Program::OnInit() {
 		engine.OnInit(this);
-		canvas.CreateAbsoluteLayer(L"ftHgC[");
-		canvas.SelectLayer(L"ftHgC[");
+		canvas.CreateAbsoluteLayer(L"デフォルトレイヤー");
+		canvas.SelectLayer(L"デフォルトレイヤー");
 		entity_manager.Register(std::make_shared<entity::Mouse>());
 	}
 
 	int Program::Main() {
 		try {
-			// DLLtH_DLLSēǂݍށB
+			// DLLフォルダ内のDLLを全て読み込む。
 			for (const auto& dll_dir : std::filesystem::directory_iterator(L"DLL")) {
 				auto& path = dll_dir.path();
 				if (In(path.c_str(), L".dll"))
 					dll_manager.Load(path);
 			}
 		} catch (std::filesystem::filesystem_error& error) {
-			MessageBoxA(nullptr, error.what(), "G[", MB_OK | MB_ICONERROR);
+			MessageBoxA(nullptr, error.what(), "エラー", MB_OK | MB_ICONERROR);
 		}
 
 		dll_manager.LoadedInit();
@@ -69,31 +70,42 @@ namespace karapo {
 	namespace variable {
 		Manager::Manager() {
 			vars[L"null"] = nullptr;
-			vars[Managing_Var_Name] = std::wstring(L"");		// Ǘ̕ϐ̖O
-			vars[Managing_Entity_Name] = std::wstring(L"");		// ǗEntity̖O
+			vars[Managing_Var_Name] = Value::Elements{};		// 管理中の変数の名前
+			vars[Managing_Entity_Name] = Value::Elements{};		// 管理中のEntityの名前
+			vars[Managing_Entity_Kind_Name] = Value::Elements{};	// 管理中のEntityの種類(Managing_Entity_Nameと同じ添字に並ぶ)
 			vars[Executing_Event_Name] = std::wstring(L"");
 
-			vars[L"__Cxg"] = std::wstring(L"");
+			vars[L"__生成中イベント"] = std::wstring(L"");
 
-			vars[L"__ϐ"] = 1 << 0;					// 
-			vars[L"__Cxg"] = 1 << 1;				// 
-			vars[L"__L"] = 1 << 2;					// 
+			vars[L"__変数存在"] = 1 << 0;					// 
+			vars[L"__イベント存在"] = 1 << 1;				// 
+			vars[L"__キャラ存在"] = 1 << 2;					// 
 		}
 
-		std::any& Manager::MakeNew(const std::wstring& Name) {
-			auto var = std::any_cast<std::wstring>(vars[Managing_Var_Name]);
-			var += Name + L"\n";
-			vars[Managing_Var_Name] = var;
-			return vars[Name];
+		Value& Manager::MakeNew(const std::wstring& Name) {
+			auto [it, inserted] = vars.try_emplace(Name);
+			if (inserted) {
+				// 新しく作られた変数のみを、管理中の変数として末尾に加える。
+				if (auto& managing = vars[Managing_Var_Name]; managing.Is<Value::Elements>())
+					managing.Get<Value::Elements>().push_back(Name);
+				generation++;
+			}
+			return it->second;
 		}
 
 		void Manager::Delete(const std::wstring& Name) noexcept {
-			const auto Pos = std::any_cast<std::wstring>(vars[Managing_Var_Name]).find(Name);
-			if (Pos != std::wstring::npos) {
-				auto var = std::any_cast<std::wstring>(vars[Managing_Var_Name]);
-				var.erase(Pos, Name.size());
-				vars[Managing_Var_Name] = var;
+			auto& managing = vars[Managing_Var_Name];
+			if (!managing.Is<Value::Elements>())
+				return;
+
+			auto& names = managing.Get<Value::Elements>();
+			const auto It = std::find_if(names.begin(), names.end(), [&Name](const Value& V) {
+				return V.Is<std::wstring>() && V.Get<std::wstring>() == Name;
+			});
+			if (It != names.end()) {
+				names.erase(It);
 				vars.erase(Name);
+				generation++;
 			}
 		}
 	}
@@ -101,11 +113,19 @@ namespace karapo {
 	namespace dll {
 		void Manager::Attach(const std::wstring& Path) {
 			dlls[Path].mod = LoadLibraryW(Path.c_str());
+			generation++;
 		}
 
 		void Manager::Load(const std::wstring& Path) {
 			Attach(Path);
 			auto& dll = dlls.at(Path);
+			// 異なる版のProgramInterfaceでビルドされたDLLは、構成員の位置や型が合わない為に読み込まない。
+			const auto Get_Version = reinterpret_cast<DLL::VersionGetter>(GetProcAddress(dll.mod, "KarapoInterfaceVersion"));
+			if (Get_Version == nullptr || Get_Version() != Program_Interface_Version) {
+				MessageBoxW(nullptr, (L"対応していない版のDLLの為、読み込みません。\n" + Path).c_str(), L"エラー", MB_OK | MB_ICONERROR);
+				Detach(Path);
+				return;
+			}
 			dll.Init = reinterpret_cast<DLL::Initializer>(GetProcAddress(dll.mod, "KarapoDLLInit"));
 			dll.Update = reinterpret_cast<DLL::LoopableMain>(GetProcAddress(dll.mod, "KarapoUpdate"));
 			dll.RegisterExternalCommand = reinterpret_cast<DLL::EventRegister>(GetProcAddress(dll.mod, "RegisterCommand"));
@@ -141,6 +161,7 @@ namespace karapo {
 		void Manager::Detach(const std::wstring& Path) {
 			FreeLibrary(dlls[Path].mod);
 			dlls.erase(Path);
+			generation++;
 		}
 
 		HMODULE Manager::Get(const std::wstring& Name) noexcept {
@@ -153,10 +174,13 @@ namespace karapo {
 	}
 }
 
+// 計測用の実行ファイル(KarapoBenchmark)では、Benchmark.cppの入口を用いる。
+#if !defined(KARAPO_BENCHMARK)
 int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) {
 	if (!karapo::Program::Instance().engine.Failed()) {
 		karapo::Program::Instance().OnInit();
 		return karapo::Program::Instance().Main();
 	} else
 		return 1;
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
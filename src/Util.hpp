@@ -171,4 +171,26 @@ namespace karapo {
 
 	size_t StrLen(const char *ch) noexcept,
 		StrLen(const wchar_t* ch)noexcept;
+
+	constexpr uint64 Hash_Offset = 14695981039346656037ull;
+	constexpr uint64 Hash_Prime = 1099511628211ull;
+
+	// FNV-1aによりバイト列のハッシュ値を求める。
+	inline uint64 Hash(const void* Data, const size_t Length, uint64 hash = Hash_Offset) noexcept {
+		auto bytes = static_cast<const uint8*>(Data);
+		for (size_t i = 0; i < Length; i++) {
+			hash ^= bytes[i];
+			hash *= Hash_Prime;
+		}
+		return hash;
+	}
+
+	// FNV-1aにより文字列のハッシュ値を求める。
+	constexpr uint64 Hash(const std::wstring_view Text, uint64 hash = Hash_Offset) noexcept {
+		for (const auto C : Text) {
+			hash ^= static_cast<uint64>(C);
+			hash *= Hash_Prime;
+		}
+		return hash;
+	}
 }
\ No newline at end of file
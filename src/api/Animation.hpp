@@ -1,7 +1,7 @@
 #pragma once
 
 namespace karapo {
-	// XvCg
+	// スプライト
 	using Sprite = std::deque<resource::Image>;
 
 	namespace animation {
@@ -13,29 +13,29 @@ namespace karapo {
 			BaseAnimation();
 			BaseAnimation(std::initializer_list<resource::Image>&);
 
-			// t[𖖒[ɒǉB
+			// フレームを末端に追加する。
 			void PushBack(resource::Image) noexcept;
-			// t[[ɒǉB
+			// フレームを先端に追加する。
 			void PushFront(resource::Image) noexcept;
-			// t[Cӂ̈ʒuɒǉB
+			// フレームを任意の位置に追加する。
 			void PushTo(resource::Image, signed) noexcept;
-			// t[Cӂ̈ʒuɒǉB
+			// フレームを任意の位置に追加する。
 			void PushTo(resource::Image, unsigned) noexcept;
 
 
-			// t[ԂB
+			// フレーム数を返す。
 			size_t Size() const noexcept;
 		};
 
-		// CfbNXɂAj[V
+		// インデックスによるアニメーション
 		class Animation : public virtual BaseAnimation {
 		public:
 			using BaseAnimation::BaseAnimation;
-			// t[Q
+			// フレーム参照
 			// 
 			resource::Image& operator[](signed) noexcept;
 
-			// t[Q(œK)
+			// フレーム参照(負数無し最適化版)
 			resource::Image& operator[](unsigned) noexcept;
 
 			Sprite::iterator Begin(), End();
@@ -60,21 +60,21 @@ namespace karapo {
 
 			void InitFrame(Sprite::iterator b, Sprite::iterator e);
 
-			// ݂̃t[QƂ
+			// 現在のフレームを参照する
 			resource::Image& operator*() noexcept;
 
-			// ݂̃t[N̃t[ɂ
+			// 現在のフレームをN個分次のフレームにする
 			resource::Image& operator<<(const int N) noexcept;
-			// ݂̃t[NÕt[ɂ
+			// 現在のフレームをN個分前のフレームにする
 			resource::Image& operator>>(const int N) noexcept;
 
-			// ݂̃t[̃t[ɂ
+			// 現在のフレームを次のフレームにする
 			resource::Image& operator++(int) noexcept;
-			// ݂̃t[Õt[ɂ
+			// 現在のフレームを前のフレームにする
 			resource::Image& operator--(int) noexcept;
-			// ݂̃t[Õt[ɂ
+			// 現在のフレームを前のフレームにする
 			resource::Image& operator++() noexcept;
-			// ݂̃t[̃t[ɂ
+			// 現在のフレームを次のフレームにする
 			resource::Image& operator--() noexcept;
 		};
 	}
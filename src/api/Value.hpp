@@ -0,0 +1,268 @@
+/**
+* Value.hpp - スクリプト上で扱う値の定義。
+*/
+#pragma once
+#include "karapo.hpp"
+#include "Animation.hpp"
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <typeinfo>
+
+namespace karapo {
+	// スクリプト上の値
+	// 型を表す値と、その型の値のみを持つ固定長の型。
+	// 型の判定は列挙値の比較のみで行い、RTTIを用いない。
+	class Value final {
+	public:
+		enum class Type : std::uint8_t {
+			Null,			// 値無し
+			Int,			// 整数
+			Dec,			// 浮動小数点数
+			String,			// 文字列(短い文字列はstd::wstringの内部に収まり、長い文字列のみヒープに置かれる)
+			Animation,		// アニメーション
+			Frame,			// フレーム参照
+			FrameHandle,	// 他の値が持つフレーム参照への参照
+			Array			// 配列(要素を連続した領域に置く)
+		};
+
+		// 配列の要素列
+		using Elements = std::vector<Value>;
+
+		// C++の型に対応する型を返す。
+		template<typename T>
+		static constexpr Type TypeOf() noexcept {
+			if constexpr (std::is_same_v<T, std::nullptr_t>)
+				return Type::Null;
+			else if constexpr (std::is_same_v<T, int>)
+				return Type::Int;
+			else if constexpr (std::is_same_v<T, Dec>)
+				return Type::Dec;
+			else if constexpr (std::is_same_v<T, std::wstring>)
+				return Type::String;
+			else if constexpr (std::is_same_v<T, animation::Animation>)
+				return Type::Animation;
+			else if constexpr (std::is_same_v<T, animation::FrameRef>)
+				return Type::Frame;
+			else if constexpr (std::is_same_v<T, std::reference_wrapper<animation::FrameRef>>)
+				return Type::FrameHandle;
+			else if constexpr (std::is_same_v<T, Elements>)
+				return Type::Array;
+			else
+				static_assert(!sizeof(T), "Valueで扱えない型です。");
+		}
+	private:
+		Type type = Type::Null;
+		union {
+			int i;
+			Dec d;
+			std::wstring s;
+			animation::Animation *animation;
+			animation::FrameRef *frame;
+			Elements *elements;
+		};
+
+		void Destroy() noexcept {
+			switch (type) {
+				case Type::String:
+					s.~basic_string();
+					break;
+				case Type::Animation:
+					delete animation;
+					break;
+				case Type::Frame:
+					delete frame;
+					break;
+				case Type::Array:
+					delete elements;
+					break;
+			}
+			type = Type::Null;
+		}
+
+		void CopyFrom(const Value& Other) {
+			switch (Other.type) {
+				case Type::Int:
+					i = Other.i;
+					break;
+				case Type::Dec:
+					d = Other.d;
+					break;
+				case Type::String:
+					new(&s) std::wstring(Other.s);
+					break;
+				case Type::Animation:
+					animation = new animation::Animation(*Other.animation);
+					break;
+				case Type::Frame:
+					frame = new animation::FrameRef(*Other.frame);
+					break;
+				case Type::FrameHandle:
+					frame = Other.frame;
+					break;
+				case Type::Array:
+					elements = new Elements(*Other.elements);
+					break;
+			}
+			type = Other.type;
+		}
+
+		void MoveFrom(Value&& other) noexcept {
+			switch (other.type) {
+				case Type::Int:
+					i = other.i;
+					break;
+				case Type::Dec:
+					d = other.d;
+					break;
+				case Type::String:
+					new(&s) std::wstring(std::move(other.s));
+					other.s.~basic_string();
+					break;
+				case Type::Animation:
+					animation = other.animation;
+					break;
+				case Type::Frame:
+				case Type::FrameHandle:
+					frame = other.frame;
+					break;
+				case Type::Array:
+					elements = other.elements;
+					break;
+			}
+			type = other.type;
+			other.type = Type::Null;
+		}
+
+		template<typename T>
+		void Check() const {
+			if (type != TypeOf<T>()) [[unlikely]]
+				throw std::bad_cast();
+		}
+	public:
+		Value() noexcept : i(0) {}
+		Value(std::nullptr_t) noexcept : Value() {}
+		Value(const int I) noexcept : type(Type::Int), i(I) {}
+		Value(const Dec D) noexcept : type(Type::Dec), d(D) {}
+		Value(const std::wstring& S) : type(Type::String), s(S) {}
+		Value(std::wstring&& moved) noexcept : type(Type::String), s(std::move(moved)) {}
+		Value(const wchar_t* S) : type(Type::String), s(S) {}
+		Value(const animation::Animation& A) : type(Type::Animation), animation(new animation::Animation(A)) {}
+		Value(const animation::FrameRef& F) : type(Type::Frame), frame(new animation::FrameRef(F)) {}
+		Value(const std::reference_wrapper<animation::FrameRef> F) noexcept : type(Type::FrameHandle), frame(&F.get()) {}
+		Value(const Elements& E) : type(Type::Array), elements(new Elements(E)) {}
+		Value(Elements&& moved) : type(Type::Array), elements(new Elements(std::move(moved))) {}
+
+		Value(const Value& Other) : i(0) {
+			CopyFrom(Other);
+		}
+
+		Value(Value&& other) noexcept : i(0) {
+			MoveFrom(std::move(other));
+		}
+
+		~Value() noexcept {
+			Destroy();
+		}
+
+		Value& operator=(const Value& Other) {
+			if (this != &Other) {
+				Value copied(Other);
+				Destroy();
+				MoveFrom(std::move(copied));
+			}
+			return *this;
+		}
+
+		Value& operator=(Value&& other) noexcept {
+			if (this != &other) {
+				Destroy();
+				MoveFrom(std::move(other));
+			}
+			return *this;
+		}
+
+		// 型を返す。
+		Type GetType() const noexcept {
+			return type;
+		}
+
+		// 値が型Tであるか否か。
+		template<typename T>
+		bool Is() const noexcept {
+			return type == TypeOf<T>();
+		}
+
+		// 型Tとして値を参照する。
+		// 型が異なる場合はstd::bad_castを投げる。
+		// FrameHandleの場合は参照先のフレーム参照を返す。
+		template<typename T>
+		auto& Get() & {
+			Check<T>();
+			if constexpr (std::is_same_v<T, int>)
+				return i;
+			else if constexpr (std::is_same_v<T, Dec>)
+				return d;
+			else if constexpr (std::is_same_v<T, std::wstring>)
+				return s;
+			else if constexpr (std::is_same_v<T, animation::Animation>)
+				return *animation;
+			else if constexpr (std::is_same_v<T, Elements>)
+				return *elements;
+			else
+				return *frame;
+		}
+
+		template<typename T>
+		const auto& Get() const& {
+			return const_cast<Value*>(this)->Get<T>();
+		}
+
+		// 一時的な値からは、値を取り出して返す。
+		template<typename T>
+		auto Get() && {
+			Check<T>();
+			if constexpr (std::is_same_v<T, std::wstring>)
+				return std::move(s);
+			else
+				return Get<T>();
+		}
+
+		// 整数または浮動小数点数を浮動小数点数として返す。
+		// どちらでもない場合はstd::bad_castを投げる。
+		Dec ToDec() const {
+			switch (type) {
+				case Type::Int:
+					return i;
+				case Type::Dec:
+					return d;
+				default:
+					throw std::bad_cast();
+			}
+		}
+
+		// 型名を返す。
+		const wchar_t* TypeName() const noexcept {
+			switch (type) {
+				case Type::Null:
+					return L"null";
+				case Type::Int:
+					return L"int";
+				case Type::Dec:
+					return L"dec";
+				case Type::String:
+					return L"string";
+				case Type::Animation:
+					return L"animation";
+				case Type::Frame:
+					return L"frame";
+				case Type::FrameHandle:
+					return L"frame&";
+				case Type::Array:
+					return L"array";
+			}
+			return L"";
+		}
+	};
+}
@@ -4,13 +4,14 @@
 
 #include "kio.hpp"
 
-#include <any>
 #include <memory>
+#include <deque>
 #include <valarray>
 #include <string>
 #include <functional>
+#include <cstdint>
 
-// ^ƂV^`邽߂̃}N
+// 整数型を元とした新しい型を定義するためのマクロ
 #define KARAPO_NEWTYPE(newone,base_interger_type) enum class newone : base_interger_type{}
 
 namespace karapo {
@@ -25,13 +26,15 @@ namespace karapo {
 	};
 
 	struct ProgramInterface;
+	// スクリプト上の値(Value.hpp)
+	class Value;
 
 	namespace raw {
 		using TargetRender = int;
 		using Resource = int;
 	}
 
-	// _
+	// 浮動小数点数
 	using Dec = double;
 	using Rect = RECT;
 	using Point = POINT;
@@ -77,11 +80,11 @@ namespace karapo {
 
 	enum class TargetRender : raw::TargetRender { Invalid = -1 };
 
-	// xNg
+	// ベクトル
 	template<typename T>
 	using Vector = std::valarray<T>;
-	using WorldVector = Vector<Dec>;	// ^xNg
-	using ScreenVector = Vector<int>;	// ^xNg
+	using WorldVector = Vector<Dec>;	// 実数型ベクトル
+	using ScreenVector = Vector<int>;	// 整数型ベクトル
 	using BinaryVector = Vector<bool>;
 
 	template<typename T>
@@ -98,85 +101,93 @@ namespace karapo {
 		KARAPO_NEWTYPE(Key, int);
 	}
 
-	// Q[̃LN^[IuWFNǧƂȂNXB
+	// ゲームのキャラクターやオブジェクトの元となるクラス。
 	class Entity {
 	public:
 		virtual ~Entity() = 0;
 
-		// Entitys֐
+		// Entity実行関数
 		virtual int Main() = 0;
-		// g̈ʒu
+		// 自身の位置
 		virtual WorldVector Origin() const noexcept = 0, Length() const noexcept = 0;
-		// g̖O
+		// 自身の名前
 		virtual const wchar_t* Name() const noexcept = 0;
-		// ޖ
+		// 種類名
 		virtual const wchar_t* KindName() const noexcept = 0;
 
-		// g폜łԂɂ邩ԂB
+		// 自身が削除できる状態にあるかを返す。
 		virtual bool CanDelete() const noexcept = 0;
-		// g폜łԂɂB
+		// 自身を削除できる状態にする。
 		virtual void Delete() = 0;
-		// `ʂB
+		// 描写する。
 		virtual void Draw(WorldVector) = 0;
-		// w肵Wփe|[gB
+		// 指定した座標へテレポートする。
 		virtual void Teleport(WorldVector) = 0;
 	};
 
 	namespace error {
-		// G[̃O[v
+		// エラーのグループ
 		struct ErrorClass;
-		// G[̓e
+		// エラーの内容
 		struct ErrorContent;
-		// [ŨG[NXB
+		// ユーザのエラーを扱うクラス。
 		class UserErrorHandler;
 	}
 
 	namespace variable {
-		static constexpr const wchar_t* const Managing_Var_Name = L"__Ǘϐ";
-		static constexpr const wchar_t* const Managing_Entity_Name = L"__ǗL";
-		static constexpr const wchar_t* const Executing_Event_Name = L"__sCxg";
+		static constexpr const wchar_t* const Managing_Var_Name = L"__管理中変数";
+		static constexpr const wchar_t* const Managing_Entity_Name = L"__管理中キャラ";
+		static constexpr const wchar_t* const Managing_Entity_Kind_Name = L"__管理中キャラ種類";
+		static constexpr const wchar_t* const Executing_Event_Name = L"__実行中イベント";
 	}
 
 	namespace event {
-		// CxgpR}h
+		// イベント用コマンド
 		class Command {
 		public:
 			virtual ~Command() = 0;
 
-			// R}hsB
+			// コマンドを実行する。
 			virtual void Execute() = 0;
 		};
 
 		using CommandPtr = std::unique_ptr<Command>;
 
-		// R}h̏
+		// コマンドの情報
 		struct KeywordInfo final {
 			enum class ParamResult {
-				Lack,		// s
-				Medium,		// \
-				Maximum,	// \(ȏAKvȂ)
-				Excess		// ]
+				Lack,		// 引数不足
+				Medium,		// 引数十分
+				Maximum,	// 引数十分(これ以上、引数必要なし)
+				Excess		// 引数余分
 			};
-			// R}hԂB
+			// 生成したコマンドを返す。
 			std::function<CommandPtr()> Result = []() -> CommandPtr { return nullptr; };
 
-			// ̐\ł邩ۂԂB
+			// 引数の数が十分であるか否かを返す。
 			std::function<ParamResult()> checkParamState = []() -> ParamResult { return ParamResult::Lack; };
 
-			// R}h͒Ɏs邩ۂǂB
+			// コマンドが解析中に実行されるか否かどうか。
 			bool is_static = false;
 
-			// R}hCxgsɎs邩ۂǂB
+			// コマンドがイベント実行中に実行されるか否かどうか。
 			bool is_dynamic = false;
 		};
 
 		class EventEditor;
 
+		// イベントを指す識別子
+		// イベントが削除される、またはイベントが読み込み直されると無効になる。
+		struct EventHandle final {
+			std::uint32_t index = UINT32_MAX;
+			std::uint32_t generation = 0;
+		};
+
 		using GenerateFunc = std::function<KeywordInfo(const std::vector<std::wstring>&)>;
 
-		// ʒl
+		// 特別値
 		enum class SpecialValue {
-			Undecided		// ̒l
+			Undecided		// 未決定の値
 		};
 	}
 
@@ -185,6 +196,13 @@ namespace karapo {
 		Loop = 3
 	};
 
+	// ProgramInterfaceの版
+	// 既存の構成員の型や並びを変えた場合に増やす。構成員を末尾に加えるだけであれば変えない。
+	// 1: 最初の版(版の確認が無かったDLLを含む)
+	// 2: MakeVar, GetVarの型をstd::any&からValue&へ変更した。
+	// DLLは"KarapoInterfaceVersion"を公開し、ビルド時のこの値を返す。値が異なる、または公開していないDLLは読み込まない。
+	constexpr std::uint32_t Program_Interface_Version = 2;
+
 	struct ProgramInterface {
 		std::function<HWND()> GetHandler;
 		std::function<std::pair<int, int>()> GetWindowLength;
@@ -198,7 +216,7 @@ namespace karapo {
 		std::function<resource::Resource(const std::wstring&)> LoadImage;
 		std::function<resource::Resource(const std::wstring&)> LoadSound;
 
-		// - Canvasn -
+		// - Canvas系 -
 
 		std::function<bool(const std::wstring&)> CreateAbsoluteLayer,
 												 CreateRelativeLayer;
@@ -208,13 +226,13 @@ namespace karapo {
 		std::function<void(const std::wstring&)> DeleteLayerByName;
 		std::function<std::wstring(const int)> GetLayerInfo;
 		
-		// - Errorn -
+		// - Error系 -
 
 		error::ErrorClass* (*MakeErrorClass)(const wchar_t* Error_Title) = nullptr;
 		error::ErrorContent* (*MakeError)(error::ErrorClass*, const wchar_t* Error_Message, const int MB_Type, const unsigned Level) = nullptr;
 		void (*SendGlobalError)(error::ErrorContent*, const std::wstring&, void(*)(const int)) = nullptr;
 
-		// - Entityn -
+		// - Entity系 -
 
 		std::function<void(std::shared_ptr<Entity>)> RegisterEntity;
 		std::function<void(std::shared_ptr<Entity>, const std::wstring&)> RegisterEntityByLayerName;
@@ -222,12 +240,12 @@ namespace karapo {
 		std::function<std::shared_ptr<Entity>(const std::wstring&)> GetEntityByName;
 		std::function<std::shared_ptr<Entity>(std::function<bool(std::shared_ptr<Entity>)>)> GetEntityByFunc;
 
-		// - Eventn -
+		// - Event系 -
 
 		std::function<void(const std::wstring&)> LoadEvent;
 		std::function<void(const std::wstring&)> ExecuteEventByName;
 		std::function<void(const WorldVector)> ExecuteEventByOrigin;
-		std::function<std::any&(const std::wstring&)> MakeVar, GetVar;
+		std::function<Value&(const std::wstring&)> MakeVar, GetVar;
 
 		std::function<event::EventEditor*()> GetEventEditor;
 		std::function<void(event::EventEditor*, const std::wstring&)>
@@ -240,7 +258,7 @@ namespace karapo {
 		std::function<std::pair<std::wstring, std::wstring>(const std::wstring&)> GetParamInfo;
 		std::function<bool(const std::wstring&)> IsStringType, IsNumberType, IsNoType, IsUndecidedType;
 
-		// - L[n -
+		// - キー系 -
 		std::function<std::pair<int, int>()> GetMousePos;
 		std::function<bool(const value::Key)> IsPressingKey, IsPressedKey, IsPressedMouse, IsPressingMouse;
 
@@ -329,5 +347,23 @@ namespace karapo {
 				Right_Click,
 				Wheel_Click;
 		} keys;
+
+		// 以降は後から追加した構成員。
+		// DLLへ値渡しされる為、既存の構成員の位置を変えないよう、追加する場合は末尾に置く。
+
+		// - Event系 -
+
+		// イベント名から識別子を得る。該当するイベントが無い場合は無効な識別子を返す。
+		std::function<event::EventHandle(const std::wstring&)> GetEventHandle;
+		// 識別子からイベントを実行する。毎フレーム同じイベントを実行する場合は、名前から実行するより速い。
+		// 識別子が無効な場合はfalseを返す。
+		std::function<bool(const event::EventHandle)> ExecuteEventByHandle;
+		// イベントの実行時間の計測を開始・停止する。
+		std::function<void(const bool)> EnableProfiler;
+		// 計測結果を"<引数>.csv"と"<引数>.folded"へ書き出す。
+		std::function<bool(const std::wstring&)> DumpProfile;
 	};
-}
\ No newline at end of file
+}
+
+// MakeVar, GetVarで扱う値の定義
+#include "Value.hpp"
\ No newline at end of file
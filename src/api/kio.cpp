@@ -1,142 +1,76 @@
-#include <locale>
 #include <fstream>
 #include <cstdint>
 #include <cwchar>
 #include <cuchar>
+#include <utility>
 
 namespace {
-	union CharBytes {
-		char32_t c32;
-		char16_t c16[2];
-		wchar_t w;
-		char8_t c8[4];
-		char c[4];
-	};
+	// 読み込んだ生の文字列の終端に付ける0の長さ(UTF-32の1文字分)。
+	constexpr size_t Terminator_Length = 4;
 
-	class TextFileReader final {
-		CharCode char_code = CharCode::Unknown;
+	// 不正なバイト列の代わりに出力する文字
+	constexpr char32_t Replacement_Character = U'\xFFFD';
 
-		static size_t GetFileSize(std::ifstream& ifs) noexcept {
-			ifs.seekg(0, std::ios_base::end);
-			const size_t File_Size = ifs.tellg();
-			ifs.seekg(0, std::ios_base::beg);
-			return File_Size;
-		}
+	// 先頭のBOMから文字コードを判定する。BOMが無い場合はCP932とする。
+	CharCode DetectCharCode(const unsigned char* Bytes, const size_t Length) noexcept {
+		if (Length >= 3 && Bytes[0] == 0xEF && Bytes[1] == 0xBB && Bytes[2] == 0xBF)
+			return CharCode::UTF8;
+		else if (Length >= 4 && Bytes[0] == 0xFF && Bytes[1] == 0xFE && Bytes[2] == 0x00 && Bytes[3] == 0x00)
+			return CharCode::UTF32LE;
+		else if (Length >= 4 && Bytes[0] == 0x00 && Bytes[1] == 0x00 && Bytes[2] == 0xFE && Bytes[3] == 0xFF)
+			return CharCode::UTF32BE;
+		else if (Length >= 2 && Bytes[0] == 0xFF && Bytes[1] == 0xFE)
+			return CharCode::UTF16LE;
+		else if (Length >= 2 && Bytes[0] == 0xFE && Bytes[1] == 0xFF)
+			return CharCode::UTF16BE;
+		else
+			return CharCode::CP932;
+	}
 
-		static size_t GetFileSize(std::wifstream& ifs) noexcept {
-			ifs.seekg(0, std::ios_base::end);
-			const size_t File_Size = ifs.tellg();
-			ifs.seekg(0, std::ios_base::beg);
-			return File_Size;
+	// BOMの長さ(バイト数)
+	size_t BomLength(const CharCode Code) noexcept {
+		switch (Code) {
+			case CharCode::UTF8:
+				return 3;
+			case CharCode::UTF16LE:
+			case CharCode::UTF16BE:
+				return 2;
+			case CharCode::UTF32LE:
+			case CharCode::UTF32BE:
+				return 4;
+			default:
+				return 0;
 		}
+	}
 
-		template<typename T, size_t byte_length>
-		union Bom {
-			T value;
-			uint8_t byte[byte_length];
-		};
-
-		static CharCode GetCodeType(CharBytes chbyte) noexcept {
-			const Bom<uint32_t, 3> UTF8_Bom = { .byte = { 0xEF, 0xBB, 0xBF } };
-			const Bom<uint16_t, 2> UTF16le_Bom = { .byte = { 0xFF, 0xFE } };
-			const Bom<uint16_t, 2> UTF16be_Bom = { .byte = { 0xFE, 0xFF } };
-			const Bom<uint32_t, 4> UTF32le_Bom = { .byte = { 0xFE, 0xFF, 0x00, 0x00 } };
-			const Bom<uint32_t, 4> UTF32be_Bom = { .byte = { 0x00, 0x00, 0xFF, 0xFE } };
-
-			Bom<uint32_t, 3> u8_checker{ .value=0 };
-			Bom<uint16_t, 2> u16_checker{ .value = 0 };
-			Bom<uint32_t, 4> u32_checker{ .value = 0 };
-
-			for (int i = 0; i < 3; i++) {
-				u8_checker.byte[i] = chbyte.c8[i];
-			}
-
-			for (int i = 0; i < 2; i++) {
-				u16_checker.byte[i] = chbyte.c8[i];
-			}
-
-			for (int i = 0; i < 4; i++) {
-				u32_checker.byte[i] = chbyte.c8[i];
-			}
-
-			if (u8_checker.value == UTF8_Bom.value) {
-				return CharCode::UTF8;
-			} else if (u32_checker.value == UTF32le_Bom.value) {
-				return CharCode::UTF32LE;
-			} else if (u32_checker.value == UTF32be_Bom.value) {
-				return CharCode::UTF32BE;
-			} else if (u16_checker.value == UTF16le_Bom.value) {
-				return CharCode::UTF16LE;
-			} else if (u16_checker.value == UTF16be_Bom.value) {
-				return CharCode::UTF16BE;
-			} else {
-				return CharCode::CP932;
-			}
-		}
+	class TextFileReader final {
+		CharCode char_code = CharCode::Unknown;
+		char *plain_text = nullptr;		// 適切な型に変換していない状態の生の文字列。(終端に0を持つ)
 
-		void CheckBOM() {
-			CharBytes chbyte;
-			chbyte.c32 = reinterpret_cast<char32_t*>(plain_text)[0];
-			char_code = GetCodeType(chbyte);
-			switch (char_code) {
-				case CharCode::CP932:
-					pos = &plain_text[0];
-					break;
-				case CharCode::UTF8:
-					pos = &plain_text[3];
-					break;
-				case CharCode::UTF16LE:
-				case CharCode::UTF16BE:
-					pos = &plain_text[2];
-					break;
-				case CharCode::UTF32LE:
-				case CharCode::UTF32BE:
-					pos = &plain_text[4];
-					break;
-			}
+		void Allocate(const size_t Length) {
+			plain_text = new char[Length + Terminator_Length]{};
 		}
-
-		char *pos = nullptr;			// 
-		char *plain_text = nullptr;		// K؂Ȍ^ɕϊĂȂԂ̐̕B
-		size_t plain_length = 0;		// 
-
-		bool is_nobom_utf8 = false;	// BOMt@CUTF-8ƂēǂݍނۂB
 	public:
 		TextFileReader(const char* File_Name) noexcept {
-			std::ifstream ifs(File_Name, std::ios_base::in | std::ios_base::binary);
+			std::ifstream ifs(File_Name, std::ios_base::in | std::ios_base::binary | std::ios_base::ate);
 			if (!ifs.fail()) {
-				plain_length = GetFileSize(ifs) + 1;
-				plain_text = new char[plain_length] { '\0' };
-				for (int i = 0;; i++) {
-					char ch = '\0';
-					if (ifs.eof()) {
-						plain_text[i] = ch;
-						break;
-					} else {
-						ifs.read(&ch, sizeof(char));
-						plain_text[i] = ch;
-					}
-				}
-				CheckBOM();
-			}
+				const size_t File_Size = static_cast<size_t>(ifs.tellg());
+				ifs.seekg(0, std::ios_base::beg);
+				Allocate(File_Size);
+				ifs.read(plain_text, File_Size);
+				char_code = DetectCharCode(reinterpret_cast<const unsigned char*>(plain_text), File_Size);
+			} else
+				Allocate(0);
 		}
 
 		TextFileReader(const wchar_t* File_Name) {
-			std::wifstream ifs(File_Name, std::ios_base::in | std::ios_base::binary);
-			if (!ifs.fail()) {
-				plain_length = GetFileSize(ifs) + 1;
-				plain_text = new char[plain_length] { '\0' };
-				for (int i = 0;; i++) {
-					wchar_t ch = '\0';
-					if (ifs.eof()) {
-						plain_text[i] = ch;
-						break;
-					} else {
-						ifs.read(&ch, sizeof(char));
-						plain_text[i] = ch;
-					}
-				}
-				CheckBOM();
+			size_t length = 0;
+			const void* mapped = MapFile(File_Name, &length);
+			Allocate(length);
+			if (mapped != nullptr) {
+				memcpy(plain_text, mapped, length);
+				UnmapFile(mapped);
+				char_code = DetectCharCode(reinterpret_cast<const unsigned char*>(plain_text), length);
 			}
 		}
 
@@ -144,11 +78,9 @@ namespace {
 			return char_code;
 		}
 
-		char* GetCopied() {
-			size_t convert_length = plain_length + 1;
-			char *target_text = new char[convert_length] { 0 };
-			memmove(target_text, plain_text, plain_length);
-			return std::move(target_text);
+		// 読み込んだ文字列の所有権を渡す。
+		char* Release() noexcept {
+			return std::exchange(plain_text, nullptr);
 		}
 
 		~TextFileReader() {
@@ -159,68 +91,200 @@ namespace {
 
 void ReadTextFile(const char* File_Name, char** allocatable_text, CharCode* const copied_code) {
 	TextFileReader txt_reader(File_Name);
-	*allocatable_text = txt_reader.GetCopied();
+	*allocatable_text = txt_reader.Release();
 	*copied_code = txt_reader.GetCharCode();
 }
 
 void ReadWTextFile(const wchar_t* File_Name, char** allocatable_text, CharCode* const copied_code) {
 	TextFileReader txt_reader(File_Name);
-	*allocatable_text = txt_reader.GetCopied();
+	*allocatable_text = txt_reader.Release();
 	*copied_code = txt_reader.GetCharCode();
 }
 
+const char* MapWTextFile(const wchar_t* File_Name, size_t* const mapped_length, CharCode* const mapped_code) {
+	const void* mapped = MapFile(File_Name, mapped_length);
+	*mapped_code = (mapped != nullptr ? DetectCharCode(static_cast<const unsigned char*>(mapped), *mapped_length) : CharCode::Unknown);
+	return static_cast<const char*>(mapped);
+}
+
 namespace {
-	size_t ToWide(wchar_t* replaced_text, const char* Source_Text, const size_t Source_Length, const char* Locale) {
-		setlocale(LC_CTYPE, Locale);
-		return mbstowcs(replaced_text, Source_Text, Source_Length);
+	// 1文字を書き込み、書き込んだ後の位置を返す。
+	// wchar_tが16ビットの場合、基本多言語面外の文字はサロゲートペアとして書き込む。
+	inline wchar_t* PutChar(wchar_t* out, char32_t c) noexcept {
+		if constexpr (sizeof(wchar_t) == 2) {
+			if (c >= 0x10000) {
+				c -= 0x10000;
+				*out++ = static_cast<wchar_t>(0xD800 + (c >> 10));
+				*out++ = static_cast<wchar_t>(0xDC00 + (c & 0x3FF));
+				return out;
+			}
+		}
+		*out++ = static_cast<wchar_t>(c);
+		return out;
+	}
+
+	inline uint64_t Load64(const void* Bytes) noexcept {
+		uint64_t value;
+		memcpy(&value, Bytes, sizeof(value));
+		return value;
+	}
+
+	// 境界に揃っていない可能性のある位置から1文字を読む。
+	template<const bool Swap>
+	inline char16_t Load16(const unsigned char* Bytes) noexcept {
+		char16_t c;
+		memcpy(&c, Bytes, sizeof(c));
+		if constexpr (Swap)
+			return static_cast<char16_t>((c >> 8) | (c << 8));
+		else
+			return c;
+	}
+
+	template<const bool Swap>
+	inline char32_t Load32(const unsigned char* Bytes) noexcept {
+		char32_t C;
+		memcpy(&C, Bytes, sizeof(C));
+		if constexpr (Swap)
+			return (C >> 24) | ((C >> 8) & 0xFF00) | ((C << 8) & 0xFF0000) | (C << 24);
+		else
+			return C;
+	}
+
+	template<const bool Swap>
+	size_t DecodeUTF16(wchar_t* replaced_text, const unsigned char* Source_Bytes, const size_t Source_Length) noexcept {
+		wchar_t *out = replaced_text;
+		size_t i = 0;
+		while (i < Source_Length) {
+			// ASCIIが続く間は4文字ずつ変換する。
+			while (Source_Length - i >= 4) {
+				uint64_t units = Load64(&Source_Bytes[i * 2]);
+				if constexpr (Swap)
+					units = ((units & 0x00FF00FF00FF00FF) << 8) | ((units >> 8) & 0x00FF00FF00FF00FF);
+				if ((units & 0xFF80FF80FF80FF80) != 0)
+					break;
+				for (int j = 0; j < 4; j++)
+					out[j] = static_cast<wchar_t>((units >> (j * 16)) & 0xFFFF);
+				out += 4;
+				i += 4;
+			}
+			if (i >= Source_Length)
+				break;
+
+			const char16_t C = Load16<Swap>(&Source_Bytes[i++ * 2]);
+			if constexpr (sizeof(wchar_t) == 2) {
+				// サロゲートペアはそのまま書き込む。
+				*out++ = static_cast<wchar_t>(C);
+			} else {
+				if (C >= 0xD800 && C < 0xDC00 && i < Source_Length) {
+					const char16_t Low = Load16<Swap>(&Source_Bytes[i * 2]);
+					if (Low >= 0xDC00 && Low < 0xE000) {
+						out = PutChar(out, 0x10000 + ((C - 0xD800) << 10) + (Low - 0xDC00));
+						i++;
+						continue;
+					}
+				}
+				out = PutChar(out, (C >= 0xD800 && C < 0xE000) ? Replacement_Character : C);
+			}
+		}
+		*out = L'\0';
+		return static_cast<size_t>(out - replaced_text);
+	}
+
+	template<const bool Swap>
+	size_t DecodeUTF32(wchar_t* replaced_text, const unsigned char* Source_Bytes, const size_t Source_Length) noexcept {
+		wchar_t *out = replaced_text;
+		for (size_t i = 0; i < Source_Length; i++) {
+			const char32_t C = Load32<Swap>(&Source_Bytes[i * 4]);
+			out = PutChar(out, (C > 0x10FFFF || (C >= 0xD800 && C < 0xE000)) ? Replacement_Character : C);
+		}
+		*out = L'\0';
+		return static_cast<size_t>(out - replaced_text);
 	}
 }
 
 size_t CP932ToWide(wchar_t* replaced_text, const char* Source_Text, const size_t Source_Length) {
-	return ToWide(replaced_text, Source_Text, Source_Length, "ja_JP");
+	const int Length = (Source_Length > 0 ? MultiByteToWideChar(932, 0, Source_Text, static_cast<int>(Source_Length), replaced_text, static_cast<int>(Source_Length)) : 0);
+	replaced_text[Length] = L'\0';
+	return static_cast<size_t>(Length);
 }
 
 size_t UTF8ToWide(wchar_t* replaced_text, const char8_t* Source_Text, const size_t Source_Length) {
-	return ToWide(replaced_text, reinterpret_cast<const char*>(Source_Text), Source_Length, "ja_JP.UTF-8");
-}
-
-size_t UTF16ToWide(wchar_t* replaced_text, const char16_t* Source_Text, const size_t Source_Length) {
-	setlocale(LC_CTYPE, "ja_JP.UTF-8");
-	char* convert_text = new char[Source_Length * 4]{ '\0' };
-	for (int i = 1;; i++) {
-		if (Source_Text[i] == u'\0') {
-			strcat_s(convert_text, Source_Length * 4, "\0");
+	const auto *src = reinterpret_cast<const unsigned char*>(Source_Text);
+	const auto *const End = src + Source_Length;
+	wchar_t *out = replaced_text;
+	while (src < End) {
+		// ASCIIが続く間は8バイトずつ変換する。
+		while (End - src >= 8 && (Load64(src) & 0x8080808080808080) == 0) {
+			for (int i = 0; i < 8; i++)
+				out[i] = static_cast<wchar_t>(src[i]);
+			out += 8;
+			src += 8;
+		}
+		if (src >= End)
 			break;
+
+		const unsigned char Lead = *src;
+		int length;
+		char32_t c;
+		// 2バイト目に許される範囲(RFC 3629)。
+		// 冗長な表現(C0, C1, E0 80-9F, F0 80-8F)、サロゲート(ED A0-BF)、U+10FFFFを超える値(F4 90-, F5-)を除く。
+		unsigned char second_min = 0x80, second_max = 0xBF;
+		if (Lead < 0x80) {
+			*out++ = static_cast<wchar_t>(Lead);
+			src++;
+			continue;
+		} else if (Lead >= 0xC2 && Lead <= 0xDF) {
+			length = 2;
+			c = Lead & 0x1F;
+		} else if (Lead >= 0xE0 && Lead <= 0xEF) {
+			length = 3;
+			c = Lead & 0x0F;
+			if (Lead == 0xE0)
+				second_min = 0xA0;
+			else if (Lead == 0xED)
+				second_max = 0x9F;
+		} else if (Lead >= 0xF0 && Lead <= 0xF4) {
+			length = 4;
+			c = Lead & 0x07;
+			if (Lead == 0xF0)
+				second_min = 0x90;
+			else if (Lead == 0xF4)
+				second_max = 0x8F;
+		} else {
+			src++;
+			goto invalid_sequence;
+		}
+
+		// 不正な列は、そこまでに読んだ正しい部分(先頭バイトを含む)をまとめて1文字で置き換える。
+		src++;
+		for (int i = 1; i < length; i++) {
+			if (src >= End)
+				goto invalid_sequence;
+			const unsigned char Min = (i == 1 ? second_min : 0x80), Max = (i == 1 ? second_max : 0xBF);
+			if (*src < Min || *src > Max)
+				goto invalid_sequence;
+			c = (c << 6) | (*src++ & 0x3F);
 		}
-		char ch[4]{ '\0' };
-		c16rtomb(ch, Source_Text[i], nullptr);
-		strcat_s(convert_text, Source_Length * 4, ch);
+		out = PutChar(out, c);
+		continue;
+	invalid_sequence:
+		out = PutChar(out, Replacement_Character);
 	}
-	auto len = ToWide(replaced_text, convert_text, Source_Length, "ja_JP.UTF-8");
-	delete[] convert_text;
-	return len;
+	*out = L'\0';
+	return static_cast<size_t>(out - replaced_text);
+}
+
+size_t UTF16ToWide(wchar_t* replaced_text, const char16_t* Source_Text, const size_t Source_Length) {
+	return DecodeUTF16<false>(replaced_text, reinterpret_cast<const unsigned char*>(Source_Text), Source_Length);
 }
 
 size_t UTF32ToWide(wchar_t* replaced_text, const char32_t* Source_Text, const size_t Source_Length) {
-	setlocale(LC_CTYPE, "ja_JP.UTF-8");
-	char* convert_text = new char[Source_Length * 4]{ '\0' };
-	for (int i = 0;; i++) {
-		if (Source_Text[i] == u'\0') {
-			strcat_s(convert_text, Source_Length * 4, "\0");
-			break;
-		}
-		char ch[4]{ '\0' };
-		c32rtomb(ch, Source_Text[i], nullptr);
-		strcat_s(convert_text, Source_Length * 4, ch);
-	}
-	auto len = ToWide(replaced_text, convert_text, Source_Length, "ja_JP.UTF-8");
-	delete[] convert_text;
-	return len;
+	return DecodeUTF32<false>(replaced_text, reinterpret_cast<const unsigned char*>(Source_Text), Source_Length);
 }
 
 size_t WideToCP932(char* replaced_text, const wchar_t* Source_Text, const size_t Source_Length) {
-	setlocale(LC_CTYPE, "ja_JP");
-	return wcstombs(replaced_text, Source_Text, Source_Length);
+	const int Length = WideCharToMultiByte(932, 0, Source_Text, -1, replaced_text, static_cast<int>(Source_Length), nullptr, nullptr);
+	return (Length > 0 ? static_cast<size_t>(Length - 1) : 0);
 }
 
 void Reverse16Endian(char16_t* target_text) {
@@ -239,4 +303,97 @@ void Reverse32Endian(char32_t* target_text) {
 		std::swap(t16[0], t16[1]);
 		tt++;
 	}
+}
+
+CharCode DecodeText(const void* Data, const size_t Length, std::wstring* decoded) {
+	decoded->clear();
+	if (Data == nullptr)
+		return CharCode::Unknown;
+
+	const auto *bytes = static_cast<const unsigned char*>(Data);
+	const CharCode Code = DetectCharCode(bytes, Length);
+	const size_t Bom_Length = BomLength(Code);
+	bytes += Bom_Length;
+	const size_t Body_Length = Length - Bom_Length;
+
+	size_t decoded_length = 0;
+	switch (Code) {
+		case CharCode::CP932:
+			decoded->resize(Body_Length + 1);
+			decoded_length = CP932ToWide(decoded->data(), reinterpret_cast<const char*>(bytes), Body_Length);
+			break;
+		case CharCode::UTF8:
+			decoded->resize(Body_Length + 1);
+			decoded_length = UTF8ToWide(decoded->data(), reinterpret_cast<const char8_t*>(bytes), Body_Length);
+			break;
+		case CharCode::UTF16LE:
+		case CharCode::UTF16BE:
+		{
+			// 奇数長の場合、末尾の1バイトは無視する。
+			const size_t Units = Body_Length / sizeof(char16_t);
+			decoded->resize(Units + 1);
+			decoded_length = (Code == CharCode::UTF16LE ?
+				DecodeUTF16<false>(decoded->data(), bytes, Units) :
+				DecodeUTF16<true>(decoded->data(), bytes, Units));
+			break;
+		}
+		case CharCode::UTF32LE:
+		case CharCode::UTF32BE:
+		{
+			const size_t Units = Body_Length / sizeof(char32_t);
+			decoded->resize(Units * 2 + 1);
+			decoded_length = (Code == CharCode::UTF32LE ?
+				DecodeUTF32<false>(decoded->data(), bytes, Units) :
+				DecodeUTF32<true>(decoded->data(), bytes, Units));
+			break;
+		}
+	}
+	decoded->resize(decoded_length);
+	return Code;
+}
+
+CharCode DecodeTextFile(const wchar_t* File_Name, std::wstring* decoded) {
+	size_t length = 0;
+	const void* mapped = MapFile(File_Name, &length);
+	const CharCode Code = DecodeText(mapped, length, decoded);
+	UnmapFile(mapped);
+	return Code;
+}
+
+const void* MapFile(const wchar_t* File_Name, size_t* const mapped_length) {
+	*mapped_length = 0;
+	HANDLE file = CreateFileW(File_Name, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return nullptr;
+
+	LARGE_INTEGER size{};
+	if (!GetFileSizeEx(file, &size) || size.QuadPart <= 0) {
+		CloseHandle(file);
+		return nullptr;
+	}
+
+	HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(file);
+	if (mapping == nullptr)
+		return nullptr;
+
+	// ビューが残っている間は割り当てが維持されるので、ハンドルはここで閉じる。
+	const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mapping);
+	if (view != nullptr)
+		*mapped_length = static_cast<size_t>(size.QuadPart);
+	return view;
+}
+
+void UnmapFile(const void* Mapped) {
+	if (Mapped != nullptr)
+		UnmapViewOfFile(Mapped);
+}
+
+bool WriteBinaryFile(const wchar_t* File_Name, const void* Data, const size_t Length) {
+	std::ofstream ofs(File_Name, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+	if (ofs.fail())
+		return false;
+	ofs.write(static_cast<const char*>(Data), Length);
+	return !ofs.fail();
 }
\ No newline at end of file
@@ -1,19 +1,43 @@
 #pragma once
+#include <string>
+
 enum class CharCode {
-	Unknown,	// ΉO̕R[h
+	Unknown,	// 対応外の文字コード
 	CP932,
-	UTF8,		// BOMUTF-8
+	UTF8,		// BOMつきUTF-8
 	UTF16LE,
 	UTF16BE,
 	UTF32LE,
 	UTF32BE
 };
 
+// ファイルの内容を読み込む。読み込んだ文字列の終端には0が付く。
 void ReadTextFile(const char* File_Name, char** allocatable_text, CharCode* const copied_code);
 void ReadWTextFile(const wchar_t* File_Name, char** allocatable_text, CharCode* const copied_code);
+// ファイルを複製せずにメモリへ割り当て、その内容を返す。失敗した場合はnullptrを返す。
+// ReadWTextFileと異なり終端に0は付かない為、mapped_lengthの長さのみを読み、使用後はUnmapFileで解放する。
+const char* MapWTextFile(const wchar_t* File_Name, size_t* const mapped_length, CharCode* const mapped_code);
+
+// Source_Length個の文字単位を変換し、終端に0を付けて書き込む。
+// 戻り値は終端を除いた、書き込んだ文字数。
+// replaced_textには、UTF32ToWideは(Source_Length * 2 + 1)個、それ以外は(Source_Length + 1)個の領域が必要。
+// 不正なバイト列はU+FFFDに置き換える。
 size_t CP932ToWide(wchar_t* replaced_text, const char* Source_Text, const size_t Source_Length);
 size_t UTF8ToWide(wchar_t* replaced_text, const char8_t* Source_Text, const size_t Source_Length);
 size_t UTF16ToWide(wchar_t* replaced_text, const char16_t* Source_Text, const size_t Source_Length);
 size_t UTF32ToWide(wchar_t* replaced_text, const char32_t* Source_Text, const size_t Source_Length);
+// Source_Lengthは書き込み先の大きさ(バイト数)。戻り値は終端を除いた、書き込んだバイト数。
 size_t WideToCP932(char* replaced_text, const wchar_t* Source_Text, const size_t Source_Length);
-void Reverse16Endian(char16_t*), Reverse32Endian(char32_t*);
\ No newline at end of file
+void Reverse16Endian(char16_t*), Reverse32Endian(char32_t*);
+
+// ファイルを読み取り専用でメモリに割り当てる。失敗した場合はnullptrを返す。
+const void* MapFile(const wchar_t* File_Name, size_t* const mapped_length);
+// MapFileで割り当てたメモリを解放する。
+void UnmapFile(const void* Mapped);
+// バイト列をそのままファイルに書き込む。
+bool WriteBinaryFile(const wchar_t* File_Name, const void* Data, const size_t Length);
+// BOMから文字コードを判定し、BOMを除いた内容をdecodedへ変換する。
+// BOMが無い場合はCP932として扱う。
+CharCode DecodeText(const void* Data, const size_t Length, std::wstring* decoded);
+// ファイルをメモリに割り当て、DecodeTextで変換する。
+CharCode DecodeTextFile(const wchar_t* File_Name, std::wstring* decoded);
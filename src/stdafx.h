@@ -24,6 +24,7 @@
 
 #include "api/karapo.hpp"
 #include "api/Animation.hpp"
+#include "api/Value.hpp"
 #include "Util.hpp"
 #include "Error.hpp"
 #include "Entity.hpp"